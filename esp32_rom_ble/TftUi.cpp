@@ -2,9 +2,14 @@
 #include <TFT_eSPI.h>
 #include "TftUi.h"
 #include "UiConfig.h"
+#include "TextLayout.h"
 
 namespace {
 TFT_eSPI tft;
+
+// Question text wrapped once per question, by the chord of the round screen
+TextCircle screenCircle;
+TextLayout questionLayout;
 }
 
 TftUi::TftUi()
@@ -32,6 +37,8 @@ void TftUi::begin() {
 
   // Initial full screen draw
   tft.fillScreen(TFT_BLACK);
+  textCircleInit(screenCircle, tft.width() / 2, 120, 106);
+  textLayoutInit(questionLayout, &screenCircle, 2, 1, TEXT_ALIGN_CENTER, 0, tft.width(), 62, 152);
   draw(true);
 }
 
@@ -207,19 +214,19 @@ void TftUi::drawQuestionScreen(bool force) {
   // Draw Timer Arc (Outer ring) - high resolution and optimized
   drawTimerArc(centerX, 120, 115, 4, percentageRemaining);
 
-  // Draw Question
-  tft.setTextFont(2);
-  tft.setTextColor(TFT_WHITE, TFT_BLACK);
-  if (_currentQuestion.length() > 18) {
-    String line1 = _currentQuestion.substring(0, 18);
-    String line2 = _currentQuestion.substring(18);
-    tft.drawString(line1, centerX, 100);
-    tft.drawString(line2, centerX, 120);
-  } else {
-    tft.drawString(_currentQuestion, centerX, 110);
+  // Draw Question (line breaks are recomputed only when the question changes)
+  if (textLayoutSet(tft, questionLayout, _currentQuestion.c_str())) {
+    // Clear inside the text circle only, so the timer ring stays intact
+    for (int y = questionLayout.top; y < questionLayout.bottom; y++) {
+      int w = textChordWidth(screenCircle, y, y);
+      tft.drawFastHLine(centerX - w / 2, y, w, TFT_BLACK);
+    }
   }
+  textLayoutDraw(tft, questionLayout, TFT_WHITE, TFT_BLACK);
 
   // Draw Buttons
+  tft.setTextFont(2);
+  tft.setTextDatum(MC_DATUM);
   const int btnY = 180;
   tft.fillRoundRect(35, btnY - 20, 80, 40, 8, TFT_GREEN);
   tft.setTextColor(TFT_BLACK);
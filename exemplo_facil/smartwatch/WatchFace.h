@@ -3,32 +3,341 @@
 
 #include <TFT_eSPI.h>
 #include <math.h>
+#include "face_cache.h"
+#include "glyph_atlas.h"
 
 #ifndef PI
 #define PI 3.14159265358979323846
 #endif
 
 // Conversor rápido RGB888 -> RGB565
-static inline uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
+static constexpr uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
   return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
 }
 
-// ---------- Desenho de arcos “grossos” (com cantos arredondados) ----------
+// ---------- Arcos grossos: rasterizador por scanlines (inteiros) ----------
+// A forma é o anel [r - t/2, r + t/2] entre os ângulos a0 e a1 (graus, 0° à
+// direita, crescendo no sentido horário da tela), com pontas arredondadas
+// opcionais. Cada linha vira poucos drawFastHLine: raízes inteiras dão a
+// extensão do anel e os raios de início/fim viram limites em x por semiplanos
+// (produto vetorial), com seno/cosseno tirados de tabela (1/16 de grau).
+// O início é inclusivo e o fim exclusivo: [a,b) e [b,c) se encaixam sem
+// sobrepor pixels, o que permite desenhar só o delta de um progresso.
+
+#define ARC_CAP_START 0x01   // ponta arredondada em a0
+#define ARC_CAP_END   0x02   // ponta arredondada em a1
+#define ARC_CAPS      (ARC_CAP_START | ARC_CAP_END)
+#define ARC_AA        0x04   // suaviza as bordas interna/externa contra aaBg
+
+// Pixels enviados ao display pelos arcos (métrica acumulada)
+uint32_t arcPixelsWritten = 0;
+
+// sen(0..90°) em Q14
+static const int16_t ARC_SIN_Q14[91] = {
+  0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+  2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+  5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+  8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+  10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+  12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+  14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+  15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+  16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+  16384
+};
+
+#define ARC_DEG16_FULL 5760  // 360° em 1/16 de grau
+
+// Seno em Q14 de um ângulo em 1/16 de grau (interpolação linear na tabela)
+static int32_t arcSinQ14(int32_t a16) {
+  a16 %= ARC_DEG16_FULL;
+  if (a16 < 0) a16 += ARC_DEG16_FULL;
+  int32_t sign = 1;
+  if (a16 >= 2880) { a16 -= 2880; sign = -1; }
+  if (a16 > 1440) a16 = 2880 - a16;
+  int32_t i = a16 >> 4, f = a16 & 15;
+  int32_t v = ARC_SIN_Q14[i];
+  if (f) v += ((ARC_SIN_Q14[i + 1] - v) * f) >> 4;
+  return sign * v;
+}
+
+static inline int32_t arcCosQ14(int32_t a16) {
+  return arcSinQ14(a16 + 1440);
+}
+
+// Maior x >= 0 com x² <= v; -1 se v < 0
+static int32_t arcIsqrt(int32_t v) {
+  if (v < 0) return -1;
+  uint32_t op = (uint32_t)v, res = 0, one = 1UL << 30;
+  while (one > op) one >>= 2;
+  while (one) {
+    if (op >= res + one) {
+      op -= res + one;
+      res = (res >> 1) + one;
+    } else {
+      res >>= 1;
+    }
+    one >>= 2;
+  }
+  return (int32_t)res;
+}
+
+static inline int32_t arcFloorDiv(int32_t a, int32_t b) {   // b > 0
+  int32_t q = a / b;
+  if ((a % b) != 0 && a < 0) q--;
+  return q;
+}
+
+// Restringe [lo, hi] aos x com A*x >= B (ou > B se strict)
+static void arcHalfPlane(int32_t A, int32_t B, bool strict, int32_t &lo, int32_t &hi) {
+  if (A > 0) {
+    int32_t q = arcFloorDiv(B, A);
+    int32_t v = (strict || q * A != B) ? q + 1 : q;
+    if (v > lo) lo = v;
+  } else if (A < 0) {
+    int32_t q = arcFloorDiv(-B, -A);
+    int32_t v = (strict && q * -A == -B) ? q - 1 : q;
+    if (v < hi) hi = v;
+  } else if (strict ? !(0 > B) : !(0 >= B)) {
+    lo = 1; hi = 0;
+  }
+}
+
+// Trecho de até 90° (convexo): direções Q14 do raio inicial e final
+struct ArcPiece {
+  int32_t sx, sy, ex, ey;
+};
+
+// Ponta arredondada: centro (relativo ao arco) e direção do raio que a corta
+struct ArcCap {
+  int32_t x, y, ux, uy;
+  bool start;
+};
+
+// Desenha a interseção de [x0, x1] com [lo, hi] na linha y (x relativo a cx)
+static inline void arcSpan(TFT_eSPI &tft, int cx, int y, int32_t x0, int32_t x1,
+                           int32_t lo, int32_t hi, uint16_t color) {
+  if (x0 < lo) x0 = lo;
+  if (x1 > hi) x1 = hi;
+  if (x1 < x0) return;
+  tft.drawFastHLine(cx + x0, y, x1 - x0 + 1, color);
+  arcPixelsWritten += x1 - x0 + 1;
+}
+
+// Pixels da borda suavizada (cobertura pela distância ao raio da borda)
+static void arcSpanAA(TFT_eSPI &tft, int cx, int y, int32_t dy, int32_t x0, int32_t x1,
+                      int32_t lo, int32_t hi, int32_t edgeR, bool outer,
+                      uint16_t color, uint16_t aaBg) {
+  if (x0 < lo) x0 = lo;
+  if (x1 > hi) x1 = hi;
+  int32_t e2 = outer ? (2 * edgeR + 1) : (2 * edgeR - 1);
+  int32_t den = 4 * e2;
+  for (int32_t x = x0; x <= x1; x++) {
+    int32_t d4 = 4 * (x * x + dy * dy);
+    int32_t num = outer ? e2 * e2 - d4 : d4 - e2 * e2;
+    int32_t alpha = num * 255 / den;
+    if (alpha <= 0) continue;
+    if (alpha > 255) alpha = 255;
+    tft.drawPixel(cx + x, y, tft.alphaBlend((uint8_t)alpha, color, aaBg));
+    arcPixelsWritten++;
+  }
+}
+
+// Faixa {x : lo < |x| <= hi} de uma linha do anel (lo = -1: sem furo)
+#define ARC_RING_SPANS(lo, hi, EMIT)                          \
+  do {                                                        \
+    if ((hi) >= 0) {                                          \
+      if ((lo) < 0) { EMIT(-(hi), (hi)); }                    \
+      else if ((lo) < (hi)) { EMIT(-(hi), -(lo) - 1); EMIT((lo) + 1, (hi)); } \
+    }                                                         \
+  } while (0)
+
 static void drawThickArc(TFT_eSPI &tft, int cx, int cy, int r,
                          int thickness, float a0_deg, float a1_deg,
-                         uint16_t color, int step_deg = 1) {
+                         uint16_t color, uint8_t flags = ARC_CAPS, uint16_t aaBg = 0) {
   // Garante ordem
   if (a1_deg < a0_deg) { float t = a0_deg; a0_deg = a1_deg; a1_deg = t; }
 
-  int rad = thickness / 2;
-  for (int a = (int)a0_deg; a <= (int)a1_deg; a += step_deg) {
-    float ar = a * (PI / 180.0f);
-    int x = cx + (int)roundf(cosf(ar) * r);
-    int y = cy + (int)roundf(sinf(ar) * r);
-    tft.fillCircle(x, y, rad, color);
+  int32_t a0 = (int32_t)lroundf(a0_deg * 16.0f);
+  int32_t a1 = (int32_t)lroundf(a1_deg * 16.0f);
+  if (a1 - a0 >= ARC_DEG16_FULL) {
+    a1 = a0 + ARC_DEG16_FULL;   // anel completo: sem pontas
+    flags &= ~ARC_CAPS;
+  }
+
+  int32_t rad = thickness / 2;
+  int32_t ro = r + rad;
+  int32_t ri = r - rad;
+  bool aa = (flags & ARC_AA) != 0;
+
+  // Trechos de até 90° e faixa de linhas afetadas
+  ArcPiece pieces[4];
+  int nPieces = 0;
+  int32_t yMin = ro + 1, yMax = -ro - 1;
+  for (int32_t s = a0; s < a1 && nPieces < 4; s += 1440) {
+    int32_t e = s + 1440 < a1 ? s + 1440 : a1;
+    ArcPiece &pc = pieces[nPieces++];
+    pc.sx = arcCosQ14(s); pc.sy = arcSinQ14(s);
+    pc.ex = arcCosQ14(e); pc.ey = arcSinQ14(e);
+    int32_t ys[4] = { (ro * pc.sy) >> 14, (ri * pc.sy) >> 14, (ro * pc.ey) >> 14, (ri * pc.ey) >> 14 };
+    for (int k = 0; k < 4; k++) {
+      if (ys[k] - 1 < yMin) yMin = ys[k] - 1;
+      if (ys[k] + 1 > yMax) yMax = ys[k] + 1;
+    }
+    // Extremos verticais (90° / 270°) dentro do trecho
+    int32_t t90 = (1440 - s) % ARC_DEG16_FULL; if (t90 < 0) t90 += ARC_DEG16_FULL;
+    int32_t t270 = (4320 - s) % ARC_DEG16_FULL; if (t270 < 0) t270 += ARC_DEG16_FULL;
+    if (t90 <= e - s) yMax = ro;
+    if (t270 <= e - s) yMin = -ro;
+  }
+
+  ArcCap caps[2];
+  int nCaps = 0;
+  if (flags & ARC_CAP_START) {
+    ArcCap &c = caps[nCaps++];
+    c.ux = arcCosQ14(a0); c.uy = arcSinQ14(a0); c.start = true;
+  }
+  if (flags & ARC_CAP_END) {
+    ArcCap &c = caps[nCaps++];
+    c.ux = arcCosQ14(a1); c.uy = arcSinQ14(a1); c.start = false;
+  }
+  for (int k = 0; k < nCaps; k++) {
+    caps[k].x = (r * caps[k].ux + (1 << 13)) >> 14;
+    caps[k].y = (r * caps[k].uy + (1 << 13)) >> 14;
+    if (caps[k].y - rad - 1 < yMin) yMin = caps[k].y - rad - 1;
+    if (caps[k].y + rad + 1 > yMax) yMax = caps[k].y + rad + 1;
+  }
+
+  if (yMin < -cy) yMin = -cy;
+  if (yMax > tft.height() - 1 - cy) yMax = tft.height() - 1 - cy;
+
+  // Limiares de d² (borda em r ± 0,5; com AA a faixa r-0,5..r+0,5 é mesclada)
+  int32_t tOut = ro * (ro + 1);
+  int32_t tOutSolid = aa ? ro * (ro - 1) : tOut;
+  int32_t tIn = ri * (ri - 1);
+  int32_t tInSolid = aa ? ri * (ri + 1) : tIn;
+  int32_t tCap = rad * (rad + 1);
+
+  for (int32_t dy = yMin; dy <= yMax; dy++) {
+    int y = cy + dy;
+    int32_t dy2 = dy * dy;
+    int32_t xoOut = arcIsqrt(tOut - dy2);
+    int32_t xoSolid = arcIsqrt(tOutSolid - dy2);
+    int32_t xiIn = ri > 0 ? arcIsqrt(tIn - dy2) : -1;
+    int32_t xiSolid = ri > 0 ? arcIsqrt(tInSolid - dy2) : -1;
+
+    for (int k = 0; k < nPieces && xoOut >= 0; k++) {
+      const ArcPiece &pc = pieces[k];
+      int32_t lo = -ro - 1, hi = ro + 1;
+      arcHalfPlane(-pc.sy, -pc.sx * dy, false, lo, hi);   // depois do raio inicial
+      arcHalfPlane(pc.ey, pc.ex * dy, true, lo, hi);      // antes do raio final
+      if (hi < lo) continue;
+
+#define ARC_EMIT_SOLID(x0, x1) arcSpan(tft, cx, y, (x0), (x1), lo, hi, color)
+      ARC_RING_SPANS(xiSolid, xoSolid, ARC_EMIT_SOLID);
+#undef ARC_EMIT_SOLID
+      if (aa) {
+#define ARC_EMIT_OUTER(x0, x1) arcSpanAA(tft, cx, y, dy, (x0), (x1), lo, hi, ro, true, color, aaBg)
+#define ARC_EMIT_INNER(x0, x1) arcSpanAA(tft, cx, y, dy, (x0), (x1), lo, hi, ri, false, color, aaBg)
+        ARC_RING_SPANS(xoSolid, xoOut, ARC_EMIT_OUTER);
+        if (ri > 0) ARC_RING_SPANS(xiIn, xiSolid, ARC_EMIT_INNER);
+#undef ARC_EMIT_OUTER
+#undef ARC_EMIT_INNER
+      }
+    }
+
+    // Pontas: meio disco além do raio de início/fim, recortado ao anel
+    // (o centro arredondado não deixa pixel fora da trilha)
+    for (int k = 0; k < nCaps; k++) {
+      const ArcCap &c = caps[k];
+      int32_t cdy = dy - c.y;
+      int32_t h = arcIsqrt(tCap - cdy * cdy);
+      if (h < 0) continue;
+      int32_t lo = c.x - h, hi = c.x + h;
+      if (c.start) arcHalfPlane(c.uy, c.ux * dy, true, lo, hi);
+      else arcHalfPlane(-c.uy, -c.ux * dy, false, lo, hi);
+      if (hi < lo) continue;
+#define ARC_EMIT_CAP(x0, x1) arcSpan(tft, cx, y, (x0), (x1), lo, hi, color)
+      ARC_RING_SPANS(xiIn, xoOut, ARC_EMIT_CAP);
+#undef ARC_EMIT_CAP
+    }
   }
 }
 
+// Progresso que vai de aFixed até a ponta móvel, com trilha até aEnd: desenha
+// só o que mudou entre aFrom e aTo, com o mesmo resultado de drawArcProgress.
+// A trilha é refeita de aFrom/aTo até além do alcance da ponta antiga (que
+// sobra além da nova ao crescer pouco) e o progresso por cima, até a ponta
+// nova. A trilha refeita sem ponta mescla a borda AA como o desenho inteiro.
+// Perto de aEnd a ponta antiga passa da ponta da trilha: essa sobra volta a
+// aaBg (o fundo da tela, também sem AA).
+static void drawArcDelta(TFT_eSPI &tft, int cx, int cy, int r, int thickness,
+                         float aFixed, float aEnd, float aFrom, float aTo,
+                         uint16_t fg, uint16_t track, uint8_t flags = 0, uint16_t aaBg = 0) {
+  if (aTo == aFrom) return;
+  bool up = aEnd >= aFixed;
+  uint8_t movingCap = up ? ARC_CAP_END : ARC_CAP_START;
+  uint8_t aaFlags = flags & ARC_AA;
+
+  // Alcance angular da ponta (meio disco de raio thickness/2, com folga)
+  float reach = (thickness / 2 + 2) / (float)r;
+  float capDeg = (reach < 1.0f ? asinf(reach) : (float)(PI / 2)) * (180.0f / (float)PI);
+
+  float lo = aFrom < aTo ? aFrom : aTo;
+  float hi = aFrom < aTo ? aTo : aFrom;
+  uint8_t trackCaps = 0;
+  if (up) {
+    if (hi + capDeg >= aEnd) {
+      drawThickArc(tft, cx, cy, r, thickness, aEnd, aEnd + capDeg, aaBg, 0);
+      hi = aEnd;
+      trackCaps = ARC_CAP_END;
+    } else {
+      hi += capDeg;
+    }
+    drawThickArc(tft, cx, cy, r, thickness, lo, hi, track, trackCaps | aaFlags, aaBg);
+    drawThickArc(tft, cx, cy, r, thickness, lo, aTo, fg, movingCap | aaFlags, aaBg);
+  } else {
+    if (lo - capDeg <= aEnd) {
+      drawThickArc(tft, cx, cy, r, thickness, aEnd - capDeg, aEnd, aaBg, 0);
+      lo = aEnd;
+      trackCaps = ARC_CAP_START;
+    } else {
+      lo -= capDeg;
+    }
+    drawThickArc(tft, cx, cy, r, thickness, lo, hi, track, trackCaps | aaFlags, aaBg);
+    drawThickArc(tft, cx, cy, r, thickness, aTo, hi, fg, movingCap | aaFlags, aaBg);
+  }
+}
+
+static inline void arcBoundsAdd(int px, int py, int pad, int &x0, int &y0, int &x1, int &y1) {
+  if (px - pad < x0) x0 = px - pad;
+  if (py - pad < y0) y0 = py - pad;
+  if (px + pad > x1) x1 = px + pad;
+  if (py + pad > y1) y1 = py + pad;
+}
+
+// Caixa do trecho [a0, a1] do anel, pontas incluídas (área a restaurar)
+static FaceRect arcBounds(int cx, int cy, int r, int thickness, float a0, float a1) {
+  if (a1 < a0) { float t = a0; a0 = a1; a1 = t; }
+  int half = thickness / 2 + 1;
+  if (a1 - a0 >= 360.0f) {
+    FaceRect full = { (int16_t)(cx - r - half), (int16_t)(cy - r - half),
+                      (int16_t)(2 * (r + half) + 1), (int16_t)(2 * (r + half) + 1) };
+    return full;
+  }
+  int x0 = INT16_MAX, y0 = INT16_MAX, x1 = INT16_MIN, y1 = INT16_MIN;
+  int32_t e0 = lroundf(a0 * 16), e1 = lroundf(a1 * 16);
+  // Extremidades: círculo de raio half no raio médio cobre a ponta
+  arcBoundsAdd(cx + ((r * arcCosQ14(e0)) >> 14), cy + ((r * arcSinQ14(e0)) >> 14), half, x0, y0, x1, y1);
+  arcBoundsAdd(cx + ((r * arcCosQ14(e1)) >> 14), cy + ((r * arcSinQ14(e1)) >> 14), half, x0, y0, x1, y1);
+  // Eixos (0°, 90°, 180°, 270°) dentro do trecho
+  for (int32_t q = (arcFloorDiv(e0, 1440) + 1) * 1440; q < e1; q += 1440) {
+    arcBoundsAdd(cx + ((r * arcCosQ14(q)) >> 14), cy + ((r * arcSinQ14(q)) >> 14), half, x0, y0, x1, y1);
+  }
+  FaceRect b = { (int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0 + 1), (int16_t)(y1 - y0 + 1) };
+  return b;
+}
+
 // ----------------------------- WATCHFACE V3 (barras curvas) -----------------------------
 struct WatchFaceV3Data {
   int hour;
@@ -42,15 +351,22 @@ struct WatchFaceV3Data {
   int battery;            // 0..100
   const char* date;       // "02/07"
   int year;               // 2025
+  bool minuteChanged;     // hora/data mudaram desde o último quadro (clockMinuteSeq)
 };
 
-// Desenha um rótulo na posição polar (ângulo/raio) com deslocamento em X
+// Posição polar (ângulo/raio) com deslocamento em X
+static void labelAtAnglePos(int cx, int cy, float angleDeg, int radius, int dx, int &x, int &y) {
+  float ar = angleDeg * (PI / 180.0f);
+  x = cx + (int)roundf(cosf(ar) * radius) + dx;
+  y = cy + (int)roundf(sinf(ar) * radius);
+}
+
+// Desenha um rótulo na posição polar (fg == bg: texto transparente)
 static void drawLabelAtAngle(TFT_eSPI &tft, int cx, int cy, float angleDeg,
                              int radius, int dx, uint16_t fg, uint16_t bg,
                              const char* text) {
-  float ar = angleDeg * (PI / 180.0f);
-  int x = cx + (int)roundf(cosf(ar) * radius) + dx;
-  int y = cy + (int)roundf(sinf(ar) * radius);
+  int x, y;
+  labelAtAnglePos(cx, cy, angleDeg, radius, dx, x, y);
   tft.setTextFont(2);
   tft.setTextDatum(MC_DATUM);
   tft.setTextColor(fg, bg);
@@ -134,16 +450,21 @@ static void drawCommonElements(TFT_eSPI &tft, const WatchFaceV3Data &d) {
   tft.drawString(dateBuf, CX, CY + 18);
 }
 
-// Fundo + progresso sobreposto (ex.: barra de passos, batimentos)
+// Fundo + progresso (ex.: barra de passos, batimentos). Fundo e progresso
+// ocupam trechos vizinhos; só a ponta do progresso cobre o fundo.
 static void drawArcProgress(TFT_eSPI &tft, int cx, int cy, int r, int thickness,
                             float start_deg, float end_deg, float progress01,
-                            uint16_t bg, uint16_t fg) {
+                            uint16_t bg, uint16_t fg, uint8_t flags = 0, uint16_t aaBg = 0) {
   if (progress01 < 0) progress01 = 0;
   if (progress01 > 1) progress01 = 1;
 
-  drawThickArc(tft, cx, cy, r, thickness, start_deg, end_deg, bg);
-  float span = (end_deg - start_deg) * progress01;
-  drawThickArc(tft, cx, cy, r, thickness, start_deg, start_deg + span, fg);
+  uint8_t aaFlags = flags & ARC_AA;
+  uint8_t farCap = end_deg >= start_deg ? ARC_CAP_END : ARC_CAP_START;
+  float split = start_deg + (end_deg - start_deg) * progress01;
+  if (progress01 < 1) {
+    drawThickArc(tft, cx, cy, r, thickness, split, end_deg, bg, farCap | aaFlags, aaBg);
+  }
+  drawThickArc(tft, cx, cy, r, thickness, start_deg, split, fg, ARC_CAPS | aaFlags, aaBg);
 }
 
 static void drawHeartIcon(TFT_eSPI &tft, int cx, int cy, int r, uint16_t col) {
@@ -169,7 +490,7 @@ static void drawStepsIcon(TFT_eSPI &tft, int cx, int cy, uint16_t col) {
   tft.fillCircle(cx + 7, cy + 12, 3, col);
 }
 
-// ---------- Função principal da face ----------
+// ---------- Face V1 (passos/kcal) ----------
 struct WatchFaceData {
   int    hour;       // 0-23
   int    minute;     // 0-59
@@ -184,81 +505,240 @@ struct WatchFaceData {
   float  heartProgress; // por ex.: heart/200
 };
 
-static void drawWatchFace(TFT_eSPI &tft, const WatchFaceData &d) {
-  // Paleta semelhante à imagem
-  const uint16_t COL_BG      = rgb565(10, 10, 14);
-  const uint16_t COL_RING_BG = rgb565(40, 40, 50);
-  const uint16_t COL_CYAN    = rgb565(0, 210, 190);
-  const uint16_t COL_CYAN_D  = rgb565(0, 140, 130);
-  const uint16_t COL_ORANGE  = rgb565(245, 100, 20);
-  const uint16_t COL_RED     = rgb565(230, 40, 60);
-  const uint16_t COL_WHITE   = rgb565(255, 255, 255);
-  const uint16_t COL_GREY    = rgb565(160, 165, 175);
-  const uint16_t COL_TEXT    = rgb565(220, 230, 235);
-  const uint16_t COL_SUB     = rgb565(150, 160, 170);
+// Paleta da face V1 (semelhante à imagem)
+static constexpr uint16_t V1_BG       = rgb565(10, 10, 14);
+static constexpr uint16_t V1_RING_BG  = rgb565(40, 40, 50);
+static constexpr uint16_t V1_CYAN     = rgb565(0, 210, 190);
+static constexpr uint16_t V1_CYAN_D   = rgb565(0, 140, 130);
+static constexpr uint16_t V1_ORANGE   = rgb565(245, 100, 20);
+static constexpr uint16_t V1_RED      = rgb565(230, 40, 60);
+static constexpr uint16_t V1_WHITE    = rgb565(255, 255, 255);
+static constexpr uint16_t V1_GREY     = rgb565(160, 165, 175);
+static constexpr uint16_t V1_TEXT     = rgb565(220, 230, 235);
+static constexpr uint16_t V1_SUB      = rgb565(150, 160, 170);
+static constexpr uint16_t V1_STEPS_AC = rgb565(0, 80, 80);     // acabamento dos arcos
+static constexpr uint16_t V1_HEART_AC = rgb565(100, 40, 0);
 
-  const int CX = 120, CY = 120; // centro 240x240
-  tft.fillScreen(COL_BG);
+static const int V1_CX = 120, V1_CY = 120;   // centro 240x240
+static const int V1_ARC_R = 96, V1_ARC_T = 16, V1_ACC_T = 6;
+static const int V1_BAT_X = V1_CX - 28, V1_BAT_Y = 14;
+
+// Camada estática (vai para o cache do fundo): trilhas, acabamento, ícones
+// (fillRect, não fillScreen: o cache desenha em faixas com a origem deslocada)
+static void drawWatchFaceStatic(TFT_eSPI &gfx) {
+  gfx.fillRect(0, 0, FACE_CACHE_WIDTH, FACE_CACHE_HEIGHT, V1_BG);
 
   // Borda de referência
-  tft.drawCircle(CX, CY, 118, COL_RING_BG);
+  gfx.drawCircle(V1_CX, V1_CY, 118, V1_RING_BG);
 
-  // Arco de passos (esquerda): ~210° -> 330°
-  drawArcProgress(tft, CX, CY, 96, 16, 210, 330, d.stepsProgress, COL_RING_BG, COL_CYAN);
-  // Toque de “acabamento” (cantos mais vivos)
-  drawArcProgress(tft, CX, CY, 96, 6, 210, 330, 1.0f, rgb565(0,80,80), rgb565(0,80,80));
+  // Trilhas vazias: passos ~210° -> 330°, batimentos ~30° -> 150°
+  drawThickArc(gfx, V1_CX, V1_CY, V1_ARC_R, V1_ARC_T, 210, 330, V1_RING_BG);
+  drawThickArc(gfx, V1_CX, V1_CY, V1_ARC_R, V1_ACC_T, 210, 330, V1_STEPS_AC);
+  drawThickArc(gfx, V1_CX, V1_CY, V1_ARC_R, V1_ARC_T, 30, 150, V1_RING_BG);
+  drawThickArc(gfx, V1_CX, V1_CY, V1_ARC_R, V1_ACC_T, 30, 150, V1_HEART_AC);
 
-  // Arco de batimentos (direita): ~30° -> 150°
-  drawArcProgress(tft, CX, CY, 96, 16, 30, 150, d.heartProgress, COL_RING_BG, COL_ORANGE);
-  drawArcProgress(tft, CX, CY, 96, 6, 30, 150, 1.0f, rgb565(100,40,0), rgb565(100,40,0));
+  drawBatteryIcon(gfx, V1_BAT_X, V1_BAT_Y, 42, 16, 0, V1_WHITE, V1_RING_BG, V1_GREY);
+  drawStepsIcon(gfx, 44, 86, V1_CYAN_D);
+  drawHeartIcon(gfx, 196, 86, 16, V1_RED);
+  drawFlameIcon(gfx, V1_CX - 40, V1_CY + 86, 10, V1_ORANGE, rgb565(255, 180, 80));
+}
 
-  // --------- Hora grande ----------
-  char timeBuf[8];
-  snprintf(timeBuf, sizeof(timeBuf), "%02d:%02d", d.hour, d.minute);
-  tft.setTextDatum(MC_DATUM);
-  tft.setTextColor(COL_TEXT, COL_BG);
-  tft.setTextFont(7); // dígitos bem grandes (7-seg estilizado)
-  tft.drawString(timeBuf, CX, CY - 12);
+// Elementos dinâmicos, na ordem de desenho (os de cima por último). A hora
+// vem primeiro: suas células opacas (x 58..182) alcançam a caixa do coração,
+// e tudo que a cruza precisa ser desenhado depois dela
+enum WatchFaceV1Elem : uint8_t {
+  V1_TIME,
+  V1_ARC_STEPS, V1_ARC_HEART,
+  V1_ICON_STEPS, V1_ICON_HEART, V1_ICON_FLAME,
+  V1_DATE, V1_WDAY, V1_BATTERY,
+  V1_STEPS, V1_HEART, V1_KCAL,
+  V1_ELEM_COUNT
+};
 
-  // --------- Data e dia ----------
-  tft.setTextFont(2);
-  tft.setTextColor(COL_SUB, COL_BG);
-  tft.setTextDatum(MR_DATUM); // direita para “02/07”
-  tft.drawString(d.date, CX - 18, CY + 38);
-  tft.setTextDatum(ML_DATUM); // esquerda para “Tuesday”
-  tft.drawString(d.wday, CX + 18, CY + 38);
-
-  // --------- Bateria no topo ----------
-  int bx = CX - 28, by = 14;
-  drawBatteryIcon(tft, bx, by, 42, 16, d.battery, COL_WHITE, COL_RING_BG, COL_GREY);
-  tft.setTextDatum(ML_DATUM);
-  tft.setTextColor(COL_SUB, COL_BG);
-  char batBuf[8]; snprintf(batBuf, sizeof(batBuf), "%d%%", d.battery);
-  tft.drawString(batBuf, bx + 48, by + 2);
+struct FaceElem {
+  char text[16];
+  int16_t value;      // arcos: progresso 0..1000; bateria: %
+  FaceRect box;       // área ocupada na tela
+};
 
-  // --------- Passos (esquerda) ----------
-  drawStepsIcon(tft, 44, 86, COL_CYAN_D);
-  tft.setTextDatum(ML_DATUM);
-  tft.setTextColor(COL_CYAN, COL_BG);
-  tft.setTextFont(4);
-  char stepBuf[12]; snprintf(stepBuf, sizeof(stepBuf), "%d", d.steps);
-  tft.drawString(stepBuf, 60, 78);
+static FaceElem v1Elems[V1_ELEM_COUNT];   // o que está desenhado agora
+static GlyphLine v1Clock;                 // hora grande: atlas antisserrilhado
 
-  // --------- Batimentos (direita) ----------
-  drawHeartIcon(tft, 196, 86, 16, COL_RED);
-  tft.setTextDatum(MR_DATUM);
-  tft.setTextColor(COL_ORANGE, COL_BG);
-  tft.setTextFont(4);
-  char hrBuf[12]; snprintf(hrBuf, sizeof(hrBuf), "%d", d.heart);
-  tft.drawString(hrBuf, 180, 78);
+// Caixa de um texto conforme o datum (TL..BR = 0..8)
+static FaceRect faceTextBox(TFT_eSPI &tft, const char *text, uint8_t font, uint8_t datum, int x, int y) {
+  FaceRect b;
+  b.w = text[0] ? tft.textWidth(text, font) : 0;
+  b.h = tft.fontHeight(font);
+  uint8_t hx = datum % 3, vy = datum / 3;
+  b.x = x - (hx == 1 ? b.w / 2 : (hx == 2 ? b.w : 0));
+  b.y = y - (vy == 1 ? b.h / 2 : (vy == 2 ? b.h : 0));
+  return b;
+}
 
-  // --------- Kcal (base) ----------
-  drawFlameIcon(tft, CX - 40, CY + 86, 10, COL_ORANGE, rgb565(255, 180, 80));
-  tft.setTextDatum(ML_DATUM);
-  tft.setTextColor(COL_TEXT, COL_BG);
-  tft.setTextFont(2);
-  char kcBuf[16]; snprintf(kcBuf, sizeof(kcBuf), "%dkcal", d.kcal);
-  tft.drawString(kcBuf, CX - 26, CY + 80);
+static inline float v1ArcSplit(uint8_t i, int16_t value) {
+  float a0 = i == V1_ARC_STEPS ? 210.0f : 30.0f;
+  return a0 + 120.0f * value / 1000;
+}
+
+// Caixa da hora grande (centrada em CX, CY - 12)
+static FaceRect v1ClockBox(const char *text) {
+  int16_t w = glyphTextWidth(GLYPH_TIME48, text);
+  FaceRect b = { (int16_t)(V1_CX - w / 2), (int16_t)(V1_CY - 12 - GLYPH_TIME48.height / 2),
+                 w, GLYPH_TIME48.height };
+  return b;
+}
+
+static void v1TextStyle(uint8_t i, uint8_t &font, uint8_t &datum, int &x, int &y, uint16_t &fg) {
+  switch (i) {
+    case V1_DATE:    font = 2; datum = MR_DATUM; x = V1_CX - 18; y = V1_CY + 38; fg = V1_SUB;    break;
+    case V1_WDAY:    font = 2; datum = ML_DATUM; x = V1_CX + 18; y = V1_CY + 38; fg = V1_SUB;    break;
+    case V1_BATTERY: font = 2; datum = ML_DATUM; x = V1_BAT_X + 48; y = V1_BAT_Y + 2; fg = V1_SUB; break;
+    case V1_STEPS:   font = 4; datum = ML_DATUM; x = 60;         y = 78;         fg = V1_CYAN;   break;
+    case V1_HEART:   font = 4; datum = MR_DATUM; x = 180;        y = 78;         fg = V1_ORANGE; break;
+    default:         font = 2; datum = ML_DATUM; x = V1_CX - 26; y = V1_CY + 80; fg = V1_TEXT;   break;
+  }
+}
+
+// Valor atual do elemento e a área que ele ocupa
+static void v1Prepare(TFT_eSPI &tft, uint8_t i, const WatchFaceData &d, FaceElem &e) {
+  e.text[0] = '\0';
+  e.value = 0;
+  switch (i) {
+    case V1_ARC_STEPS:
+    case V1_ARC_HEART: {
+      float p = i == V1_ARC_STEPS ? d.stepsProgress : d.heartProgress;
+      if (p < 0) p = 0;
+      if (p > 1) p = 1;
+      e.value = (int16_t)(p * 1000 + 0.5f);
+      e.box = arcBounds(V1_CX, V1_CY, V1_ARC_R, V1_ARC_T, v1ArcSplit(i, 0), v1ArcSplit(i, e.value));
+      return;
+    }
+    case V1_ICON_STEPS: e.box = { 31, 76, 25, 27 }; return;
+    case V1_ICON_HEART: e.box = { 179, 69, 35, 35 }; return;
+    case V1_ICON_FLAME: e.box = { V1_CX - 51, V1_CY + 75, 23, 23 }; return;
+    case V1_TIME:
+      snprintf(e.text, sizeof(e.text), "%02d:%02d", d.hour, d.minute);
+      e.box = v1ClockBox(e.text);
+      return;
+    case V1_DATE:    snprintf(e.text, sizeof(e.text), "%s", d.date ? d.date : ""); break;
+    case V1_WDAY:    snprintf(e.text, sizeof(e.text), "%s", d.wday ? d.wday : ""); break;
+    case V1_BATTERY: e.value = d.battery; snprintf(e.text, sizeof(e.text), "%d%%", d.battery); break;
+    case V1_STEPS:   snprintf(e.text, sizeof(e.text), "%d", d.steps); break;
+    case V1_HEART:   snprintf(e.text, sizeof(e.text), "%d", d.heart); break;
+    default:         snprintf(e.text, sizeof(e.text), "%dkcal", d.kcal); break;
+  }
+  uint8_t font, datum; int x, y; uint16_t fg;
+  v1TextStyle(i, font, datum, x, y, fg);
+  e.box = faceTextBox(tft, e.text, font, datum, x, y);
+  if (i == V1_BATTERY) {
+    FaceRect icon = { V1_BAT_X, V1_BAT_Y, 42, 16 };
+    e.box = faceRectUnion(e.box, icon);
+  }
+}
+
+// Desenha o elemento sobre o fundo já restaurado (texto transparente)
+static void v1Paint(TFT_eSPI &tft, uint8_t i, const FaceElem &e) {
+  switch (i) {
+    case V1_ARC_STEPS:
+    case V1_ARC_HEART: {
+      float a0 = v1ArcSplit(i, 0), a1 = v1ArcSplit(i, 1000);
+      uint16_t fg = i == V1_ARC_STEPS ? V1_CYAN : V1_ORANGE;
+      drawThickArc(tft, V1_CX, V1_CY, V1_ARC_R, V1_ARC_T, a0, v1ArcSplit(i, e.value), fg, ARC_CAPS);
+      // Toque de “acabamento” (cantos mais vivos)
+      drawThickArc(tft, V1_CX, V1_CY, V1_ARC_R, V1_ACC_T, a0, a1,
+                   i == V1_ARC_STEPS ? V1_STEPS_AC : V1_HEART_AC, ARC_CAPS);
+      return;
+    }
+    case V1_ICON_STEPS: drawStepsIcon(tft, 44, 86, V1_CYAN_D); return;
+    case V1_ICON_HEART: drawHeartIcon(tft, 196, 86, 16, V1_RED); return;
+    case V1_ICON_FLAME: drawFlameIcon(tft, V1_CX - 40, V1_CY + 86, 10, V1_ORANGE, rgb565(255, 180, 80)); return;
+    case V1_TIME:
+      glyphLineDraw(tft, v1Clock, e.box.x, e.box.y, e.text, true);
+      return;
+    case V1_BATTERY:
+      drawBatteryIcon(tft, V1_BAT_X, V1_BAT_Y, 42, 16, e.value, V1_WHITE, V1_RING_BG, V1_GREY);
+      break;
+    default:
+      break;
+  }
+  if (!e.text[0]) return;
+  uint8_t font, datum; int x, y; uint16_t fg;
+  v1TextStyle(i, font, datum, x, y, fg);
+  tft.setTextFont(font);
+  tft.setTextDatum(datum);
+  tft.setTextColor(fg);
+  tft.drawString(e.text, x, y);
+}
+
+// Área a restaurar quando o elemento muda
+static FaceRect v1Damage(uint8_t i, const FaceElem &old, const FaceElem &now) {
+  if (i == V1_ARC_STEPS || i == V1_ARC_HEART) {
+    return arcBounds(V1_CX, V1_CY, V1_ARC_R, V1_ARC_T, v1ArcSplit(i, old.value), v1ArcSplit(i, now.value));
+  }
+  return faceRectUnion(old.box, now.box);
+}
+
+// ---------- Função principal da face ----------
+// full: restaura a tela inteira do cache e desenha tudo. Senão, só os
+// retângulos dos elementos que mudaram voltam ao fundo (do cache) e os
+// elementos que os cruzam são redesenhados, recortados a cada retângulo.
+// A hora, com a mesma largura, só reenvia os dígitos que mudaram (células
+// opacas sobre V1_BG, sem restaurar nada).
+static void drawWatchFace(TFT_eSPI &tft, const WatchFaceData &d, bool full = true) {
+  faceCacheEnsure(tft, 1, drawWatchFaceStatic);
+  if (!v1Clock.font) glyphLineInit(v1Clock, GLYPH_TIME48, V1_TEXT, V1_BG);
+
+  FaceElem now[V1_ELEM_COUNT];
+  for (uint8_t i = 0; i < V1_ELEM_COUNT; i++) v1Prepare(tft, i, d, now[i]);
+
+  if (full) {
+    FaceRect screen = { 0, 0, FACE_CACHE_WIDTH, FACE_CACHE_HEIGHT };
+    faceCacheRestore(tft, screen);
+    for (uint8_t i = 0; i < V1_ELEM_COUNT; i++) v1Paint(tft, i, now[i]);
+    memcpy(v1Elems, now, sizeof(v1Elems));
+    return;
+  }
+
+  // Danos dos elementos que mudaram (retângulos que se cruzam são unidos)
+  FaceRect damage[V1_ELEM_COUNT];
+  uint8_t nd = 0;
+  for (uint8_t i = 0; i < V1_ELEM_COUNT; i++) {
+    if (now[i].value == v1Elems[i].value && strcmp(now[i].text, v1Elems[i].text) == 0) continue;
+    if (i == V1_TIME && now[i].box.x == v1Elems[i].box.x && now[i].box.w == v1Elems[i].box.w) {
+      if (glyphLineDraw(tft, v1Clock, now[i].box.x, now[i].box.y, now[i].text, false)) {
+        // As células são opacas: refaz por cima o que as cruza (a hora é o
+        // primeiro elemento, então são todos os seguintes)
+        FaceRect cb = faceRectClip(now[i].box);
+        displayClipPush(tft, cb.x, cb.y, cb.w, cb.h);
+        for (uint8_t j = i + 1; j < V1_ELEM_COUNT; j++) {
+          if (faceRectIntersects(now[j].box, cb)) v1Paint(tft, j, now[j]);
+        }
+        displayClipPop(tft);
+      }
+      continue;
+    }
+    FaceRect r = v1Damage(i, v1Elems[i], now[i]);
+    bool merged = false;
+    for (uint8_t k = 0; k < nd && !merged; k++) {
+      if (faceRectIntersects(damage[k], r)) {
+        damage[k] = faceRectUnion(damage[k], r);
+        merged = true;
+      }
+    }
+    if (!merged) damage[nd++] = r;
+  }
+  memcpy(v1Elems, now, sizeof(v1Elems));
+
+  for (uint8_t k = 0; k < nd; k++) {
+    FaceRect r = faceRectClip(damage[k]);
+    if (faceRectEmpty(r)) continue;
+    faceCacheRestore(tft, r);
+    displayClipPush(tft, r.x, r.y, r.w, r.h);
+    for (uint8_t i = 0; i < V1_ELEM_COUNT; i++) {
+      if (faceRectIntersects(now[i].box, r)) v1Paint(tft, i, now[i]);
+    }
+    displayClipPop(tft);
+  }
 }
 
 // ----------------------------- NOVO WATCHFACE -----------------------------
@@ -421,20 +901,16 @@ static void drawWatchFaceV3(TFT_eSPI &tft, const WatchFaceV3Data &d) {
   // Barras arredondadas nas LATERAIS
   const int BAR_R = 96, BAR_THICK = 14;
   // esquerda (fundo completo)
-  drawArcProgress(tft, CX, CY, BAR_R, BAR_THICK, 120, 240, 1.0f, COL_RING_BG, COL_RING_BG);
   // progresso crescendo de baixo (240°) para cima (120°)
   {
     float nh = d.heartProgress; if (nh < 0) nh = 0; if (nh > 1) nh = 1;
-    float ca = 240.0f - (240.0f - 120.0f) * nh; // ângulo atual
-    drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, ca, 240.0f, COL_PINK_V);
+    drawArcProgress(tft, CX, CY, BAR_R, BAR_THICK, 240, 120, nh, COL_RING_BG, COL_PINK_V, ARC_AA, COL_BG);
   }
   // direita (fundo completo)
-  drawArcProgress(tft, CX, CY, BAR_R, BAR_THICK, 300, 420, 1.0f, COL_RING_BG, COL_RING_BG);
   // progresso crescendo de baixo (300°) para cima (420°)
   {
     float np = d.pressureProgress; if (np < 0) np = 0; if (np > 1) np = 1;
-    float ca = 300.0f + (420.0f - 300.0f) * np;
-    drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, 300.0f, ca, COL_ORANGE_V);
+    drawArcProgress(tft, CX, CY, BAR_R, BAR_THICK, 300, 420, np, COL_RING_BG, COL_ORANGE_V, ARC_AA, COL_BG);
   }
 
   // Mostrador analógico (centralizado)
@@ -447,46 +923,71 @@ static void drawWatchFaceV3(TFT_eSPI &tft, const WatchFaceV3Data &d) {
   drawCommonElements(tft, d);
 }
 
-// Desenho sem flicker: base estática + atualização parcial com sprites
-static void drawWatchFaceV3Static(TFT_eSPI &tft, const WatchFaceV3Data &d, bool clearScreen = true) {
+// Progresso desenhado por último em drawWatchFaceV3Update (-1 = nada na tela)
+static float v3PrevHeart = -1.0f;
+static float v3PrevPress = -1.0f;
+
+// Rótulos de bpm/pressão na tela: texto e caixa (restaurada do cache ao mudar)
+static char v3LabelText[2][20];
+static FaceRect v3LabelBox[2];
+
+// Mostrador e "---HH:MM---"/data nos sprites: refeitos só quando o minuto
+// vira; nos outros segundos só os ponteiros desenhados (v3Hand*) trocam
+static bool v3DialValid = false;
+static int v3HandHour, v3HandMinute, v3HandSecond;
+
+// Trilhas das barras sobre o fundo
+static void drawWatchFaceV3Tracks(TFT_eSPI &gfx) {
   const uint16_t COL_BG       = rgb565(5, 8, 12);
   const uint16_t COL_RING_BG  = rgb565(35, 40, 55);
-  const uint16_t COL_WHITE    = rgb565(255, 255, 255);
-  const uint16_t COL_SUB      = rgb565(170, 180, 190);
-  const uint16_t COL_PINK_V   = rgb565(255, 30, 60);
-  const uint16_t COL_ORANGE_V = rgb565(255, 140, 20);
   const int CX = 120, CY = 120;
+  const int BAR_R = 96, BAR_THICK = 14;
+  drawThickArc(gfx, CX, CY, BAR_R, BAR_THICK, 120, 240, COL_RING_BG, ARC_CAPS | ARC_AA, COL_BG);
+  drawThickArc(gfx, CX, CY, BAR_R, BAR_THICK, 300, 420, COL_RING_BG, ARC_CAPS | ARC_AA, COL_BG);
+}
+
+// Camada estática da V3 (cache do fundo)
+static void drawWatchFaceV3Background(TFT_eSPI &gfx) {
+  gfx.fillRect(0, 0, FACE_CACHE_WIDTH, FACE_CACHE_HEIGHT, rgb565(5, 8, 12));
+  drawWatchFaceV3Tracks(gfx);
+}
+
+// Desenho sem flicker: base estática + atualização parcial com sprites
+static void drawWatchFaceV3Static(TFT_eSPI &tft, const WatchFaceV3Data &d, bool clearScreen = true) {
   if (clearScreen) {
-    tft.fillScreen(COL_BG);
+    faceCacheEnsure(tft, 3, drawWatchFaceV3Background);
+    FaceRect screen = { 0, 0, FACE_CACHE_WIDTH, FACE_CACHE_HEIGHT };
+    faceCacheRestore(tft, screen);
+  } else {
+    drawWatchFaceV3Tracks(tft);
   }
-  const int BAR_R = 96, BAR_THICK = 14;
-  drawArcProgress(tft, CX, CY, BAR_R, BAR_THICK, 120, 240, 1.0f, COL_RING_BG, COL_RING_BG);
-  drawArcProgress(tft, CX, CY, BAR_R, BAR_THICK, 300, 420, 1.0f, COL_RING_BG, COL_RING_BG);
+  v3PrevHeart = v3PrevPress = -1.0f;   // trilhas limpas: progresso redesenha inteiro
+  v3DialValid = false;
+  v3LabelText[0][0] = v3LabelText[1][0] = '\0';
   
   // Elementos comuns (bateria, rótulos, hora/data)
   drawCommonElements(tft, d);
 }
 
+// Marca i (0..59) do mostrador: longa nas horas, curta nos minutos
+static void drawAnalogTickSprite(TFT_eSprite &sp, int cx, int cy, int r, int i, uint16_t ticks) {
+  int inner = (i % 5 == 0) ? r - 10 : r - 6;
+  float a = (i * 6) * (PI / 180.0f);
+  int x0 = cx + (int)roundf(cosf(a) * inner);
+  int y0 = cy + (int)roundf(sinf(a) * inner);
+  int x1 = cx + (int)roundf(cosf(a) * (r - 2));
+  int y1 = cy + (int)roundf(sinf(a) * (r - 2));
+  sp.drawLine(x0, y0, x1, y1, ticks);
+}
+
 static void drawAnalogDialSprite(TFT_eSprite &sp, int cx, int cy, int r,
                                  uint16_t ring, uint16_t ticks, uint16_t bg) {
   sp.fillCircle(cx, cy, r + 2, bg);
   sp.drawCircle(cx, cy, r, ring);
-  for (int i = 0; i < 12; i++) {
-    float a = (i * 30) * (PI / 180.0f);
-    int x0 = cx + (int)roundf(cosf(a) * (r - 10));
-    int y0 = cy + (int)roundf(sinf(a) * (r - 10));
-    int x1 = cx + (int)roundf(cosf(a) * (r - 2));
-    int y1 = cy + (int)roundf(sinf(a) * (r - 2));
-    sp.drawLine(x0, y0, x1, y1, ticks);
-  }
+  for (int i = 0; i < 60; i += 5) drawAnalogTickSprite(sp, cx, cy, r, i, ticks);
   for (int i = 0; i < 60; i++) {
     if (i % 5 == 0) continue;
-    float a = (i * 6) * (PI / 180.0f);
-    int x0 = cx + (int)roundf(cosf(a) * (r - 6));
-    int y0 = cy + (int)roundf(sinf(a) * (r - 6));
-    int x1 = cx + (int)roundf(cosf(a) * (r - 2));
-    int y1 = cy + (int)roundf(sinf(a) * (r - 2));
-    sp.drawLine(x0, y0, x1, y1, ticks);
+    drawAnalogTickSprite(sp, cx, cy, r, i, ticks);
   }
 }
 
@@ -526,8 +1027,6 @@ static void drawWatchFaceV3Update(TFT_eSPI &tft, const WatchFaceV3Data &d) {
   // Atualização incremental das barras (sem piscar): só o delta
   const int BAR_R = 96;
   const int BAR_THICK = 14;
-  static float prevHeart = -1.0f;
-  static float prevPress = -1.0f;
   float nh = d.heartProgress; if (nh < 0) nh = 0; if (nh > 1) nh = 1;
   float np = d.pressureProgress; if (np < 0) np = 0; if (np > 1) np = 1;
 
@@ -535,40 +1034,46 @@ static void drawWatchFaceV3Update(TFT_eSPI &tft, const WatchFaceV3Data &d) {
   // Esquerda: base 240° subindo até 120°
   float baseL = 240.0f, topL = 120.0f;
   float caL = baseL - (baseL - topL) * nh;
-  if (prevHeart < 0) {
-    drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, caL, baseL, COL_PINK_V);
-  } else if (nh != prevHeart) {
-    float prevCaL = baseL - (baseL - topL) * prevHeart;
-    if (nh > prevHeart) {
-      // cresceu: desenha novo trecho de caL até prevCaL
-      drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, caL, prevCaL, COL_PINK_V);
-    } else {
-      // diminuiu: apaga trecho de prevCaL até caL
-      drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, prevCaL, caL, COL_RING_BG);
-    }
+  if (v3PrevHeart < 0) {
+    drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, caL, baseL, COL_PINK_V, ARC_CAPS | ARC_AA, COL_BG);
+  } else if (nh != v3PrevHeart) {
+    float prevCaL = baseL - (baseL - topL) * v3PrevHeart;
+    drawArcDelta(tft, CX, CY, BAR_R, BAR_THICK, baseL, topL, prevCaL, caL,
+                 COL_PINK_V, COL_RING_BG, ARC_AA, COL_BG);
   }
-  prevHeart = nh;
+  v3PrevHeart = nh;
 
   // Direita: base 300° subindo até 420°
   float baseR = 300.0f, topR = 420.0f;
   float caR = baseR + (topR - baseR) * np;
-  if (prevPress < 0) {
-    drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, baseR, caR, COL_ORANGE_V);
-  } else if (np != prevPress) {
-    float prevCaR = baseR + (topR - baseR) * prevPress;
-    if (np > prevPress) {
-      drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, prevCaR, caR, COL_ORANGE_V);
-    } else {
-      drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, caR, prevCaR, COL_RING_BG);
-    }
+  if (v3PrevPress < 0) {
+    drawThickArc(tft, CX, CY, BAR_R, BAR_THICK, baseR, caR, COL_ORANGE_V, ARC_CAPS | ARC_AA, COL_BG);
+  } else if (np != v3PrevPress) {
+    float prevCaR = baseR + (topR - baseR) * v3PrevPress;
+    drawArcDelta(tft, CX, CY, BAR_R, BAR_THICK, baseR, topR, prevCaR, caR,
+                 COL_ORANGE_V, COL_RING_BG, ARC_AA, COL_BG);
   }
-  prevPress = np;
+  v3PrevPress = np;
   tft.endWrite();
-  // Redesenha rótulos com valores atuais
+  // Rótulos: só os que mudaram; a caixa antiga volta ao fundo do cache
+  // (o texto opaco deixaria sobras ao encolher)
   {
     int labelRadius = BAR_R + BAR_THICK/2 + 12;
-    drawBaseLabels(tft, CX, CY, labelRadius, +30, -30,
-                   d.heart, d.sys, d.dia, COL_PINK_V, COL_ORANGE_V, COL_BG);
+    char labels[2][20];
+    snprintf(labels[0], sizeof(labels[0]), "%dbpm", d.heart);
+    snprintf(labels[1], sizeof(labels[1]), "%d/%d", d.sys, d.dia);
+    const float angles[2] = { 120.0f, 60.0f };
+    const int dxs[2] = { +30, -30 };
+    const uint16_t cols[2] = { COL_PINK_V, COL_ORANGE_V };
+    for (int i = 0; i < 2; i++) {
+      if (strcmp(labels[i], v3LabelText[i]) == 0) continue;
+      int x, y;
+      labelAtAnglePos(CX, CY, angles[i], labelRadius, dxs[i], x, y);
+      if (v3LabelText[i][0]) faceCacheRestore(tft, v3LabelBox[i]);
+      drawLabelAtAngle(tft, CX, CY, angles[i], labelRadius, dxs[i], cols[i], cols[i], labels[i]);
+      v3LabelBox[i] = faceTextBox(tft, labels[i], 2, MC_DATUM, x, y);
+      strcpy(v3LabelText[i], labels[i]);
+    }
   }
   // Sprite do mostrador analógico
   static bool spInit = false;
@@ -585,11 +1090,28 @@ static void drawWatchFaceV3Update(TFT_eSPI &tft, const WatchFaceV3Data &d) {
   }
   // dial centralizado, com transparência fora do círculo
   const uint16_t TRANSP = 0x0001; // cor-chave de transparência (não usada no desenho)
-  spDial.fillSprite(TRANSP);
-  drawAnalogDialSprite(spDial, 80, 80, 74, COL_LIME_V, COL_RING_BG, COL_BG);
+  bool rebuild = !v3DialValid || d.minuteChanged;
+  if (rebuild) {
+    spDial.fillSprite(TRANSP);
+    drawAnalogDialSprite(spDial, 80, 80, 74, COL_LIME_V, COL_RING_BG, COL_BG);
+  } else {
+    // Apaga os ponteiros anteriores; só a ponta do segundo alcança uma marca
+    // (as marcas contam a partir das 3h, os ponteiros a partir das 12h)
+    drawAnalogHandsSprite(spDial, 80, 80, 74, v3HandHour, v3HandMinute, v3HandSecond, COL_BG, COL_BG, COL_BG);
+    drawAnalogTickSprite(spDial, 80, 80, 74, (v3HandSecond + 45) % 60, COL_RING_BG);
+  }
   drawAnalogHandsSprite(spDial, 80, 80, 74, d.hour, d.minute, d.second, COL_TEXT, COL_WHITE, COL_RED);
+  v3HandHour = d.hour;
+  v3HandMinute = d.minute;
+  v3HandSecond = d.second;
+  v3DialValid = true;
   spDial.pushSprite(CX - 80, CY - 80, TRANSP);
-  // Centro do dial: topo HH:MM e base DD:MM:AAAA
+  // Centro do dial: topo HH:MM e base DD:MM:AAAA, pronto desde a virada do
+  // minuto (o dial acima apaga a área, então o sprite é reenviado sempre)
+  if (!rebuild) {
+    spBottom.pushSprite(CX - 100, CY - 30, TRANSP);
+    return;
+  }
   spBottom.fillSprite(TRANSP);
   spBottom.setTextDatum(MC_DATUM);
   spBottom.setTextColor(COL_CYAN_V);
@@ -3,23 +3,102 @@
 
 #include "config.h"
 #include <Arduino.h>
+#include <driver/i2s.h>
+#include <driver/adc.h>
+#include <WebSocketsClient.h>
+#include "audio_codec.h"
+#include "audio_vad.h"
+#include "audio_clip.h"
+
+extern WebSocketsClient webSocket;
 
 // ==========================================
 // MÓDULO DE ÁUDIO - Gravação e Streaming
 // ==========================================
+// Captura via I2S em modo ADC interno: o hardware amostra MIC_PIN a
+// SAMPLE_RATE exato e o DMA enche AUDIO_DMA_BUF_COUNT buffers de
+// AUDIO_CHUNK_SIZE amostras. O loop apenas recolhe buffers cheios,
+// converte para PCM 16 bits e passa pelo codec selecionado (audio_codec.h).
+// Com VAD ativo, blocos sem voz não são enviados: vão para um pré-roll
+// curto e, no lugar deles, segue um marcador "audio_sil|<seq>|<n>".
+// Gravação (AUDIO_RECORD_ENABLED): os mesmos chunks codificados vão para
+// audio_clip.h (PSRAM ou flash) e são enviados depois como "clip|...",
+// um chunk a cada AUDIO_CLIP_UPLOAD_INTERVAL_MS.
 
 // Estados
 bool gravandoAudio = false;
 bool streamingAudio = false;
-unsigned long lastStreamSampleMicros = 0;
-uint8_t streamChunkBuf[AUDIO_CHUNK_SIZE];
-int streamPos = 0;
-uint32_t streamChunkIdx = 0;
+uint8_t streamChunkBuf[AUDIO_CHUNK_SIZE];   // chunk já codificado
+int streamPos = 0;                          // bytes válidos em streamChunkBuf
+uint32_t streamChunkIdx = 0;                // número de sequência do chunk
+static int16_t streamPcm[AUDIO_CHUNK_SIZE];
+
+// Codec do stream (comando WebSocket audio_codec|pcm8/ulaw/adpcm)
+AudioCodec audioCodec = (AudioCodec)AUDIO_DEFAULT_CODEC;
+static AdpcmState adpcmState = {0, 0};
+static int streamSamples = 0;               // amostras representadas no chunk
+
+// VAD e pré-roll
+bool audioVadEnabled = AUDIO_VAD_ENABLED;
+static VadState vadState;
+static bool vadSending = false;
+static uint8_t vadPreroll[VAD_PREROLL_CHUNKS][AUDIO_CHUNK_SIZE];
+static uint16_t vadPrerollLen[VAD_PREROLL_CHUNKS];
+static uint32_t vadPrerollSeq[VAD_PREROLL_CHUNKS];
+static AudioCodec vadPrerollCodec[VAD_PREROLL_CHUNKS];
+static int vadPrerollHead = 0, vadPrerollCount = 0;
+static uint32_t vadSilenceStart = 0, vadSilenceCount = 0;
+uint32_t audioChunksSent = 0;
+uint32_t audioChunksSuppressed = 0;
+
+// Pacote de envio, montado no lugar (cabeçalho + payload)
+#define AUDIO_TEXT_HEADER_MAX 32
+#define AUDIO_BASE64_MAX (((AUDIO_CHUNK_SIZE + 2) / 3) * 4)
+static char audioPacket[AUDIO_TEXT_HEADER_MAX + AUDIO_BASE64_MAX + 1];
+
+// Cabeçalho do frame binário (AUDIO_WS_BINARY): payload codificado em seguida
+#define AUDIO_BIN_MAGIC 0x32445541UL  // "AUD2"
+#define AUDIO_FLAG_CLIP 0x01          // chunk de clipe gravado (não ao vivo)
+struct __attribute__((packed)) AudioChunkHeader {
+  uint32_t magic;
+  uint32_t chunkIdx;   // sequência (detecta perdas/supressões)
+  uint16_t sampleRate;
+  uint8_t codec;       // AudioCodec
+  uint8_t flags;       // AUDIO_FLAG_*
+  uint16_t samples;    // amostras representadas
+  uint16_t length;     // bytes de payload após o cabeçalho
+};
 
-// Buffer de áudio
-uint8_t audioBuffer[BUFFER_SIZE];
+// Captura DMA
+static uint16_t i2sReadBuf[AUDIO_CHUNK_SIZE];
+static size_t i2sReadFill = 0;          // bytes já lidos do chunk atual (leitura parcial)
+static QueueHandle_t i2sEventQueue = nullptr;
+static bool i2sInstalled = false;
+static bool capturaAtiva = false;       // ADC ligado (streaming e/ou gravação)
+static int i2sPendingBufs = 0;          // buffers cheios ainda não lidos
+
+// Métricas de integridade da captura
+uint32_t audioDroppedBufs = 0;
+uint32_t audioMeasuredRate = 0;         // amostras/s medidas na última janela
+static uint32_t audioRateSamples = 0;
+static unsigned long audioRateStart = 0;
+
+// Custo do codec e banda usada
+uint32_t audioEncodeMicros = 0;         // último chunk
+uint32_t audioWireRate = 0;             // bytes/s enviados na última janela
+static uint32_t audioWireBytes = 0;
+
+#if AUDIO_RECORD_ENABLED
+// Gravação de clipe (dados em audio_clip.h, fora da RAM interna)
 unsigned long inicioGravacao = 0;
-int indiceBuffer = 0;
+static unsigned long duracaoGravacaoMs = 0;
+static AudioCodec clipCodec = AUDIO_CODEC_PCM8;
+static bool clipUploading = false;
+static bool clipStartSent = false;          // clip_start saiu nesta conexão
+static unsigned long clipLastUpload = 0;
+static uint32_t clipUploadSeq = 0;
+static uint8_t clipChunkBuf[AUDIO_CHUNK_SIZE];
+#endif
 
 // Funções públicas
 void initAudio();
@@ -28,123 +107,395 @@ void startStreaming();
 void stopStreaming();
 bool isAudioActive();
 void enviarChunkStreaming();
+uint32_t getAudioSampleRate();
+uint32_t getAudioDroppedBuffers();
+bool setAudioCodec(AudioCodec codec);
+void setAudioVad(bool enabled);
+#if AUDIO_RECORD_ENABLED
+bool startRecording(uint32_t seconds);
+void stopRecording();
+#endif
 
-// Função auxiliar para codificação base64
-String encodeBase64(const String& input);
-
-// ===== IMPLEMENTAÇÃO =====
+// Gate de VAD
+static void suprimirChunkVad();
+static void enviarPrerollVad();
+static void enviarPacoteAudio(const char *tag, const uint8_t *data, size_t len, uint32_t seq,
+                              uint16_t samples, AudioCodec codec, uint8_t flags);
 
-String encodeBase64(const String& input) {
-  const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-  String result;
-  int i = 0;
-  int j = 0;
-  unsigned char char_array_3[3];
-  unsigned char char_array_4[4];
-  int in_len = input.length();
-  const char* bytes_to_encode = input.c_str();
-
-  while (in_len--) {
-    char_array_3[i++] = *(bytes_to_encode++);
-    if (i == 3) {
-      char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-      char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-      char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-      char_array_4[3] = char_array_3[2] & 0x3f;
-
-      for (i = 0; i < 4; i++)
-        result += base64_chars[char_array_4[i]];
-      i = 0;
-    }
-  }
+// Codificação base64 sem heap: escreve direto no buffer de saída
+size_t base64Encode(const uint8_t *in, size_t len, char *out);
 
-  if (i) {
-    for (j = i; j < 3; j++)
-      char_array_3[j] = '\0';
+// ===== IMPLEMENTAÇÃO =====
 
-    char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-    char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-    char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-    char_array_4[3] = char_array_3[2] & 0x3f;
+static const char BASE64_TABLE[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-    for (j = 0; j < i + 1; j++)
-      result += base64_chars[char_array_4[j]];
+// Codifica um grupo de 3 bytes em 4 caracteres
+static inline void base64Group(const uint8_t *in, char *out) {
+  uint32_t v = ((uint32_t)in[0] << 16) | ((uint32_t)in[1] << 8) | in[2];
+  out[0] = BASE64_TABLE[(v >> 18) & 0x3F];
+  out[1] = BASE64_TABLE[(v >> 12) & 0x3F];
+  out[2] = BASE64_TABLE[(v >> 6) & 0x3F];
+  out[3] = BASE64_TABLE[v & 0x3F];
+}
 
-    while ((i++ < 3))
-      result += '=';
+// Retorna o número de caracteres escritos (4 * ceil(len / 3)), sem '\0'.
+size_t base64Encode(const uint8_t *in, size_t len, char *out) {
+  char *o = out;
+  // 12 bytes (4 grupos) por iteração
+  while (len >= 12) {
+    base64Group(in, o);
+    base64Group(in + 3, o + 4);
+    base64Group(in + 6, o + 8);
+    base64Group(in + 9, o + 12);
+    in += 12; o += 16; len -= 12;
   }
-
-  return result;
+  while (len >= 3) {
+    base64Group(in, o);
+    in += 3; o += 4; len -= 3;
+  }
+  if (len) {
+    uint8_t tail[3] = { in[0], (uint8_t)(len > 1 ? in[1] : 0), 0 };
+    base64Group(tail, o);
+    if (len == 1) o[2] = '=';
+    o[3] = '=';
+    o += 4;
+  }
+  return o - out;
 }
 
 void initAudio() {
-  pinMode(MIC_PIN, INPUT);
-  Serial.println("Audio inicializado");
+  i2s_config_t cfg = {};
+  cfg.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+  cfg.sample_rate = SAMPLE_RATE;
+  cfg.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  cfg.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+  cfg.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+  cfg.intr_alloc_flags = ESP_INTR_FLAG_LEVEL1;
+  cfg.dma_buf_count = AUDIO_DMA_BUF_COUNT;
+  cfg.dma_buf_len = AUDIO_CHUNK_SIZE;
+  cfg.use_apll = false;
+
+  if (i2s_driver_install(I2S_NUM_0, &cfg, AUDIO_DMA_BUF_COUNT * 2, &i2sEventQueue) != ESP_OK) {
+    Serial.println("Audio: falha ao instalar driver I2S");
+    return;
+  }
+  adc1_config_width(ADC_WIDTH_BIT_12);
+  adc1_config_channel_atten(MIC_ADC_CHANNEL, ADC_ATTEN_DB_11);
+  i2s_set_adc_mode(ADC_UNIT_1, MIC_ADC_CHANNEL);
+  i2sInstalled = true;
+  Serial.println("Audio inicializado (I2S ADC DMA)");
 }
 
 bool isAudioActive() {
   return gravandoAudio || streamingAudio;
 }
 
+uint32_t getAudioSampleRate() {
+  return audioMeasuredRate;
+}
+
+uint32_t getAudioDroppedBuffers() {
+  return audioDroppedBufs;
+}
+
+// Durante a gravação o codec fica fixo: o clipe tem chunks de tamanho único
+bool setAudioCodec(AudioCodec codec) {
+#if AUDIO_RECORD_ENABLED
+  if (gravandoAudio && codec != clipCodec) return false;
+#endif
+  audioCodec = codec;
+  adpcmState.predictor = 0;
+  adpcmState.index = 0;
+  Serial.printf("Audio: codec %s\n", audioCodecName(codec));
+  return true;
+}
+
+void setAudioVad(bool enabled) {
+  audioVadEnabled = enabled;
+  Serial.printf("Audio: VAD %s\n", enabled ? "ligado" : "desligado");
+}
+
+// Liga o ADC/DMA se ainda não estiver ligado (compartilhado por stream e gravação)
+static bool iniciarCaptura() {
+  if (!i2sInstalled) return false;
+  if (capturaAtiva) return true;
+  i2sPendingBufs = 0;
+  i2sReadFill = 0;
+  audioDroppedBufs = 0;
+  audioMeasuredRate = 0;
+  audioRateSamples = 0;
+  audioRateStart = millis();
+  adpcmState.predictor = 0;
+  adpcmState.index = 0;
+  i2s_zero_dma_buffer(I2S_NUM_0);
+  xQueueReset(i2sEventQueue);
+  i2s_adc_enable(I2S_NUM_0);
+  capturaAtiva = true;
+  return true;
+}
+
+static void pararCapturaSeOcioso() {
+  if (capturaAtiva && !streamingAudio && !gravandoAudio) {
+    i2s_adc_disable(I2S_NUM_0);
+    capturaAtiva = false;
+  }
+}
+
 void startStreaming() {
+  if (!iniciarCaptura()) {
+    Serial.println("Audio: I2S indisponivel, streaming ignorado");
+    return;
+  }
   streamingAudio = true;
   streamPos = 0;
   streamChunkIdx = 0;
-  lastStreamSampleMicros = micros();
+  audioWireBytes = 0;
+  audioWireRate = 0;
+  vadReset(vadState);
+  vadSending = false;
+  vadPrerollHead = vadPrerollCount = 0;
+  vadSilenceStart = 0;
+  vadSilenceCount = 0;
+  audioChunksSent = 0;
+  audioChunksSuppressed = 0;
   Serial.println("Streaming iniciado");
 }
 
 void stopStreaming() {
+  bool estava = streamingAudio;
   streamingAudio = false;
-  Serial.println("Streaming parado");
+  pararCapturaSeOcioso();
+  if (!estava) return;
+  Serial.printf("Streaming parado (%uHz medidos, %u buffers perdidos, %u enviados, %u suprimidos)\n",
+                audioMeasuredRate, audioDroppedBufs, audioChunksSent, audioChunksSuppressed);
 }
 
-void updateAudio() {
-  if (!streamingAudio) return;
+#if AUDIO_RECORD_ENABLED
+// Grava `seconds` de áudio no codec atual; ao terminar, envia o clipe
+bool startRecording(uint32_t seconds) {
+  if (gravandoAudio || clipUploading) return false;
+  if (seconds == 0) seconds = RECORD_SECONDS;
+  if (seconds > AUDIO_CLIP_FLASH_SECONDS) seconds = AUDIO_CLIP_FLASH_SECONDS;
+  clipCodec = audioCodec;
+  size_t chunkLen = audioCodecEncodedSize(clipCodec, AUDIO_CHUNK_SIZE);
+  uint32_t chunksPerSec = (SAMPLE_RATE + AUDIO_CHUNK_SIZE - 1) / AUDIO_CHUNK_SIZE;
+  if (!clipBegin(chunkLen, chunksPerSec, seconds)) {
+    Serial.println("Audio: sem PSRAM/flash para gravar clipe");
+    return false;
+  }
+  if (!iniciarCaptura()) {
+    clipRelease();
+    return false;
+  }
+  gravandoAudio = true;
+  inicioGravacao = millis();
+  duracaoGravacaoMs = seconds * 1000UL;
+  Serial.printf("Gravando %us em %s (%s)\n", seconds, clipStorageName(), audioCodecName(clipCodec));
+  return true;
+}
 
-  unsigned long nowMicros = micros();
-  unsigned long tempoDesdeUltimaAmostra;
-  
-  if (nowMicros >= lastStreamSampleMicros) {
-    tempoDesdeUltimaAmostra = nowMicros - lastStreamSampleMicros;
-  } else {
-    tempoDesdeUltimaAmostra = (0xFFFFFFFF - lastStreamSampleMicros) + nowMicros;
+void stopRecording() {
+  if (!gravandoAudio) return;
+  gravandoAudio = false;
+  pararCapturaSeOcioso();
+  clipEndWrite();
+
+  // clip_start e os chunks saem por enviarClipeCadenciado(), com o socket
+  // conectado
+  clipUploading = true;
+  clipStartSent = false;
+  Serial.printf("Gravacao concluida: %u chunks, enviando\n", (unsigned)clipStoredChunks());
+}
+
+// Envio cadenciado: um chunk por intervalo, sem travar o loop. Sem conexão
+// o envio pausa sem avançar a leitura; se ela caiu depois do clip_start, o
+// receptor perdeu o clipe e ele é reenviado desde o início
+static void enviarClipeCadenciado() {
+  if (!webSocket.isConnected()) {
+    if (clipStartSent) {
+      clipStartSent = false;
+      clipRewind();
+      Serial.println("Audio: conexao caiu, clipe sera reenviado");
+    }
+    return;
+  }
+
+  unsigned long now = millis();
+  if (!clipStartSent) {
+    char msg[48];
+    snprintf(msg, sizeof(msg), "clip_start|%u|%d", (unsigned)clipStoredChunks(), (int)clipCodec);
+    webSocket.sendTXT(msg);
+    clipStartSent = true;
+    clipUploadSeq = 0;
+    clipLastUpload = now;
+    return;
+  }
+  if (now - clipLastUpload < AUDIO_CLIP_UPLOAD_INTERVAL_MS) return;
+  clipLastUpload = now;
+
+  if (clipReadNext(clipChunkBuf)) {
+    enviarPacoteAudio("clip", clipChunkBuf, clipChunkLen, clipUploadSeq++,
+                      AUDIO_CHUNK_SIZE, clipCodec, AUDIO_FLAG_CLIP);
+    return;
+  }
+
+  char msg[32];
+  snprintf(msg, sizeof(msg), "clip_end|%u", (unsigned)clipUploadSeq);
+  webSocket.sendTXT(msg);
+  clipUploading = false;
+  clipRelease();
+}
+#endif
+
+// Conta buffers completados pelo DMA; se passarem do número de buffers
+// do anel antes de serem lidos, os mais antigos foram sobrescritos.
+static void contabilizarEventosI2S() {
+  i2s_event_t evt;
+  while (xQueueReceive(i2sEventQueue, &evt, 0) == pdTRUE) {
+    if (evt.type == I2S_EVENT_RX_DONE) i2sPendingBufs++;
   }
-  
-  unsigned long tempoEntreAmostras = 1000000UL / SAMPLE_RATE;
-  
-  if (tempoDesdeUltimaAmostra >= tempoEntreAmostras) {
-    lastStreamSampleMicros = nowMicros;
+  if (i2sPendingBufs > AUDIO_DMA_BUF_COUNT) {
+    audioDroppedBufs += i2sPendingBufs - AUDIO_DMA_BUF_COUNT;
+    i2sPendingBufs = AUDIO_DMA_BUF_COUNT;
+  }
+}
+
+void updateAudio() {
+#if AUDIO_RECORD_ENABLED
+  if (clipUploading) enviarClipeCadenciado();
+  if (gravandoAudio && millis() - inicioGravacao >= duracaoGravacaoMs) stopRecording();
+#endif
+  if (!capturaAtiva) return;
 
-    // Captura amostra de áudio
-    int leitura = analogRead(MIC_PIN);
-    uint8_t amostra = leitura >> 4; // Converte para 8 bits
-    streamChunkBuf[streamPos++] = amostra;
+  contabilizarEventosI2S();
 
-    // Envia chunk quando estiver cheio
-    if (streamPos >= AUDIO_CHUNK_SIZE) {
+  // Entrega apenas buffers cheios; nunca bloqueia o loop
+  while (i2sPendingBufs > 0) {
+    // Leitura parcial (até um número ímpar de bytes) fica guardada e a
+    // próxima continua dela: as amostras não perdem o alinhamento
+    size_t bytesRead = 0;
+    i2s_read(I2S_NUM_0, (uint8_t *)i2sReadBuf + i2sReadFill, sizeof(i2sReadBuf) - i2sReadFill, &bytesRead, 0);
+    i2sReadFill += bytesRead;
+    if (i2sReadFill < sizeof(i2sReadBuf)) break;
+    i2sReadFill = 0;
+    i2sPendingBufs--;
+
+    // Palavra I2S-ADC: 4 bits de canal + 12 bits de dado -> PCM 16 bits
+    for (int i = 0; i < AUDIO_CHUNK_SIZE; i++) {
+      streamPcm[i] = (int16_t)(((int)(i2sReadBuf[i] & 0x0FFF) - 2048) << 4);
+    }
+    audioRateSamples += AUDIO_CHUNK_SIZE;
+
+    uint32_t t0 = micros();
+    streamPos = audioEncodeChunk(audioCodec, adpcmState, streamPcm, AUDIO_CHUNK_SIZE, streamChunkBuf);
+    audioEncodeMicros = micros() - t0;
+    streamSamples = AUDIO_CHUNK_SIZE;
+
+#if AUDIO_RECORD_ENABLED
+    if (gravandoAudio && !clipAppend(streamChunkBuf)) stopRecording(); // flash cheio
+#endif
+    if (!streamingAudio) {
+      streamPos = 0;
+    } else if (!audioVadEnabled || vadProcess(vadState, streamPcm, AUDIO_CHUNK_SIZE)) {
+      // Início de voz: envia o pré-roll antes do chunk atual
+      if (!vadSending) {
+        vadSending = true;
+        enviarPrerollVad();
+      }
       enviarChunkStreaming();
+    } else {
+      suprimirChunkVad();
     }
   }
+
+  // Taxa efetiva medida a cada ~1s
+  unsigned long now = millis();
+  if (now - audioRateStart >= 1000) {
+    audioMeasuredRate = (uint32_t)((uint64_t)audioRateSamples * 1000 / (now - audioRateStart));
+    audioWireRate = (uint32_t)((uint64_t)audioWireBytes * 1000 / (now - audioRateStart));
+    audioRateSamples = 0;
+    audioWireBytes = 0;
+    audioRateStart = now;
+  }
+}
+
+// Monta e envia um frame de áudio já codificado
+static void enviarPacoteAudio(const char *tag, const uint8_t *data, size_t len, uint32_t seq,
+                              uint16_t samples, AudioCodec codec, uint8_t flags) {
+#if AUDIO_WS_BINARY
+  // Frame binário: cabeçalho fixo + payload codificado, sem base64
+  AudioChunkHeader *h = (AudioChunkHeader *)audioPacket;
+  h->magic = AUDIO_BIN_MAGIC;
+  h->chunkIdx = seq;
+  h->sampleRate = SAMPLE_RATE;
+  h->codec = (uint8_t)codec;
+  h->flags = flags;
+  h->samples = samples;
+  h->length = len;
+  memcpy(audioPacket + sizeof(AudioChunkHeader), data, len);
+  size_t frameLen = sizeof(AudioChunkHeader) + len;
+  webSocket.sendBIN((uint8_t *)audioPacket, frameLen);
+#else
+  // "<tag>|<seq>|<codec>|<base64>" escrito no lugar, sem Strings temporárias.
+  // PCM8 mantém o "-1" do formato antigo.
+  int codecId = codec == AUDIO_CODEC_PCM8 ? -1 : (int)codec;
+  int hdr = snprintf(audioPacket, AUDIO_TEXT_HEADER_MAX, "%s|%u|%d|", tag, (unsigned)seq, codecId);
+  size_t n = base64Encode(data, len, audioPacket + hdr);
+  audioPacket[hdr + n] = '\0';
+  size_t frameLen = hdr + n;
+  webSocket.sendTXT(audioPacket, frameLen);
+#endif
+  audioWireBytes += frameLen;
+  audioChunksSent++;
 }
 
 void enviarChunkStreaming() {
   if (streamPos == 0) return;
+  enviarPacoteAudio("audio", streamChunkBuf, streamPos, streamChunkIdx++, streamSamples, audioCodec, 0);
+  streamPos = 0;
+}
 
-  // Converte buffer em string e codifica base64
-  String raw = "";
-  for (int i = 0; i < streamPos; i++) {
-    raw += (char)streamChunkBuf[i];
+// Guarda o chunk no pré-roll e, periodicamente, avisa o silêncio.
+// A sequência avança mesmo suprimido, para o receptor medir a lacuna.
+static void suprimirChunkVad() {
+  if (vadSending) {
+    vadSending = false;
+    vadSilenceStart = streamChunkIdx;
+    vadSilenceCount = 0;
   }
 
-  String encoded = encodeBase64(raw);
-  String pacote = "audio|" + String(streamChunkIdx++) + "|-1|" + encoded;
-  
-  // Envia via WebSocket (precisa ser externo)
-  // webSocket.sendTXT(pacote);
-  
-  Serial.printf("Chunk #%d enviado (%d bytes)\n", streamChunkIdx - 1, streamPos);
+  int slot = (vadPrerollHead + vadPrerollCount) % VAD_PREROLL_CHUNKS;
+  if (vadPrerollCount == VAD_PREROLL_CHUNKS) {
+    vadPrerollHead = (vadPrerollHead + 1) % VAD_PREROLL_CHUNKS;
+  } else {
+    vadPrerollCount++;
+  }
+  memcpy(vadPreroll[slot], streamChunkBuf, streamPos);
+  vadPrerollLen[slot] = streamPos;
+  vadPrerollSeq[slot] = streamChunkIdx++;
+  vadPrerollCodec[slot] = audioCodec;
   streamPos = 0;
+
+  audioChunksSuppressed++;
+  vadSilenceCount++;
+  if (vadSilenceCount == 1 || vadSilenceCount % VAD_MARKER_EVERY == 0) {
+    char marker[40];
+    int n = snprintf(marker, sizeof(marker), "audio_sil|%u|%u",
+                     (unsigned)vadSilenceStart, (unsigned)vadSilenceCount);
+    webSocket.sendTXT(marker, n);
+    audioWireBytes += n;
+  }
+}
+
+static void enviarPrerollVad() {
+  while (vadPrerollCount > 0) {
+    int slot = vadPrerollHead;
+    enviarPacoteAudio("audio", vadPreroll[slot], vadPrerollLen[slot], vadPrerollSeq[slot],
+                      AUDIO_CHUNK_SIZE, vadPrerollCodec[slot], 0);
+    audioChunksSuppressed--; // passou a ser enviado
+    vadPrerollHead = (vadPrerollHead + 1) % VAD_PREROLL_CHUNKS;
+    vadPrerollCount--;
+  }
 }
 
 #endif // AUDIO_H
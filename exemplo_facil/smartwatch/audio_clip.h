@@ -0,0 +1,142 @@
+#ifndef AUDIO_CLIP_H
+#define AUDIO_CLIP_H
+
+#include "config.h"
+
+#if AUDIO_RECORD_ENABLED
+
+#include <Arduino.h>
+#include "flash_fs.h"
+
+// ==========================================
+// ARMAZENAMENTO DE CLIPES DE ÁUDIO - PSRAM ou flash
+// ==========================================
+// Guarda chunks já codificados, todos do mesmo tamanho, para envio posterior.
+//   - PSRAM presente: anel em PSRAM (ps_malloc) com AUDIO_CLIP_PSRAM_SECONDS;
+//     se a gravação passar disso, mantém os segundos mais recentes.
+//   - Sem PSRAM: arquivo em LittleFS, limitado por AUDIO_CLIP_FLASH_SECONDS
+//     e pelo espaço livre. Nada fica na RAM interna além de um chunk.
+
+enum ClipStorage {
+  CLIP_STORAGE_NONE,
+  CLIP_STORAGE_PSRAM,
+  CLIP_STORAGE_FLASH
+};
+
+static ClipStorage clipStorage = CLIP_STORAGE_NONE;
+static uint8_t *clipRing = nullptr;        // PSRAM
+static File clipFile;                      // flash
+static size_t clipChunkLen = 0;            // bytes por chunk
+static uint32_t clipMaxChunks = 0;
+static uint32_t clipWritten = 0;           // chunks gravados (total)
+static uint32_t clipReadPos = 0;           // próximo chunk a ler
+
+#define CLIP_FILE_PATH "/clip.bin"
+
+// Chunks disponíveis para leitura
+static inline uint32_t clipStoredChunks() {
+  return clipWritten < clipMaxChunks ? clipWritten : clipMaxChunks;
+}
+
+// Prepara a gravação de chunks de chunkLen bytes cobrindo `seconds`
+static bool clipBegin(size_t chunkLen, uint32_t chunksPerSecond, uint32_t seconds) {
+  clipChunkLen = chunkLen;
+  clipWritten = 0;
+  clipReadPos = 0;
+
+  if (psramFound()) {
+    uint32_t maxSec = seconds < AUDIO_CLIP_PSRAM_SECONDS ? seconds : AUDIO_CLIP_PSRAM_SECONDS;
+    clipMaxChunks = maxSec * chunksPerSecond;
+    if (clipRing) free(clipRing);
+    clipRing = (uint8_t *)ps_malloc(clipMaxChunks * clipChunkLen);
+    if (clipRing) {
+      clipStorage = CLIP_STORAGE_PSRAM;
+      return true;
+    }
+  }
+
+  if (flashFsMount()) {
+    uint32_t maxSec = seconds < AUDIO_CLIP_FLASH_SECONDS ? seconds : AUDIO_CLIP_FLASH_SECONDS;
+    clipMaxChunks = maxSec * chunksPerSecond;
+    size_t freeBytes = LittleFS.totalBytes() - LittleFS.usedBytes();
+    if (clipMaxChunks * clipChunkLen > freeBytes) clipMaxChunks = freeBytes / clipChunkLen;
+    clipFile = LittleFS.open(CLIP_FILE_PATH, FILE_WRITE);
+    if (clipFile && clipMaxChunks > 0) {
+      clipStorage = CLIP_STORAGE_FLASH;
+      return true;
+    }
+  }
+
+  clipStorage = CLIP_STORAGE_NONE;
+  return false;
+}
+
+// Retorna false quando o armazenamento não aceita mais chunks (flash cheio)
+static bool clipAppend(const uint8_t *data) {
+  if (clipStorage == CLIP_STORAGE_PSRAM) {
+    memcpy(clipRing + (clipWritten % clipMaxChunks) * clipChunkLen, data, clipChunkLen);
+    clipWritten++;
+    return true;
+  }
+  if (clipStorage == CLIP_STORAGE_FLASH) {
+    if (clipWritten >= clipMaxChunks) return false;
+    if (clipFile.write(data, clipChunkLen) != clipChunkLen) return false;
+    clipWritten++;
+    return true;
+  }
+  return false;
+}
+
+// Posiciona a leitura no chunk mais antigo (início do envio ou reenvio)
+static void clipRewind() {
+  if (clipStorage == CLIP_STORAGE_PSRAM) {
+    clipReadPos = clipWritten > clipMaxChunks ? clipWritten - clipMaxChunks : 0;
+  } else if (clipStorage == CLIP_STORAGE_FLASH) {
+    if (clipFile) clipFile.seek(0);
+    clipReadPos = 0;
+  }
+}
+
+// Fecha a escrita e posiciona a leitura no chunk mais antigo
+static void clipEndWrite() {
+  if (clipStorage == CLIP_STORAGE_FLASH) {
+    clipFile.close();
+    clipFile = LittleFS.open(CLIP_FILE_PATH, FILE_READ);
+  }
+  clipRewind();
+}
+
+// Lê o próximo chunk; false ao fim do clipe
+static bool clipReadNext(uint8_t *out) {
+  if (clipReadPos >= clipWritten) return false;
+  if (clipStorage == CLIP_STORAGE_PSRAM) {
+    memcpy(out, clipRing + (clipReadPos % clipMaxChunks) * clipChunkLen, clipChunkLen);
+  } else if (clipStorage == CLIP_STORAGE_FLASH) {
+    if (!clipFile || clipFile.read(out, clipChunkLen) != clipChunkLen) return false;
+  } else {
+    return false;
+  }
+  clipReadPos++;
+  return true;
+}
+
+// Libera PSRAM / apaga o arquivo
+static void clipRelease() {
+  if (clipRing) { free(clipRing); clipRing = nullptr; }
+  if (clipFile) clipFile.close();
+  if (clipStorage == CLIP_STORAGE_FLASH) LittleFS.remove(CLIP_FILE_PATH);
+  clipStorage = CLIP_STORAGE_NONE;
+  clipWritten = clipReadPos = 0;
+}
+
+static inline const char *clipStorageName() {
+  switch (clipStorage) {
+    case CLIP_STORAGE_PSRAM: return "psram";
+    case CLIP_STORAGE_FLASH: return "flash";
+    default:                 return "none";
+  }
+}
+
+#endif // AUDIO_RECORD_ENABLED
+
+#endif // AUDIO_CLIP_H
@@ -0,0 +1,183 @@
+#ifndef AUDIO_CODEC_H
+#define AUDIO_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ==========================================
+// CODECS DE ÁUDIO - PCM8 / µ-law / IMA-ADPCM
+// ==========================================
+// Estágio entre a captura (PCM 16 bits) e enviarChunkStreaming().
+// Só usa stdint: os decodificadores de referência compilam igual no
+// host/backend para validar o que o relógio envia.
+//
+//   PCM8   1 byte/amostra  (compatível com o formato antigo, leitura >> 4)
+//   ULAW   1 byte/amostra  (G.711, ~13 bits de faixa dinâmica)
+//   ADPCM  4 bits/amostra  (IMA; cada chunk começa com bloco de 4 bytes:
+//                           preditor int16 LE, índice, reservado)
+
+enum AudioCodec {
+  AUDIO_CODEC_PCM8  = 0,
+  AUDIO_CODEC_ULAW  = 1,
+  AUDIO_CODEC_ADPCM = 2
+};
+
+#define ADPCM_BLOCK_HEADER 4
+
+// Bytes de saída para n amostras
+static inline size_t audioCodecEncodedSize(AudioCodec codec, size_t n) {
+  if (codec == AUDIO_CODEC_ADPCM) return ADPCM_BLOCK_HEADER + (n + 1) / 2;
+  return n;
+}
+
+static inline const char *audioCodecName(AudioCodec codec) {
+  switch (codec) {
+    case AUDIO_CODEC_ULAW:  return "ulaw";
+    case AUDIO_CODEC_ADPCM: return "adpcm";
+    default:                return "pcm8";
+  }
+}
+
+// ---------- PCM8 ----------
+static inline uint8_t pcm8Encode(int16_t s) {
+  return (uint8_t)((s >> 8) + 128);
+}
+
+static inline int16_t pcm8Decode(uint8_t b) {
+  return (int16_t)(((int)b - 128) << 8);
+}
+
+// ---------- µ-law (G.711) ----------
+#define ULAW_BIAS 0x84
+#define ULAW_CLIP 32635
+
+static inline uint8_t ulawEncode(int16_t pcm) {
+  int s = pcm;
+  int sign = (s >> 8) & 0x80;
+  if (sign) s = -s;
+  if (s > ULAW_CLIP) s = ULAW_CLIP;
+  s += ULAW_BIAS;
+  int exponent = 7;
+  for (int mask = 0x4000; (s & mask) == 0 && exponent > 0; mask >>= 1) exponent--;
+  int mantissa = (s >> (exponent + 3)) & 0x0F;
+  return (uint8_t)~(sign | (exponent << 4) | mantissa);
+}
+
+static inline int16_t ulawDecode(uint8_t u) {
+  u = ~u;
+  int t = ((u & 0x0F) << 3) + ULAW_BIAS;
+  t <<= (u & 0x70) >> 4;
+  return (int16_t)((u & 0x80) ? (ULAW_BIAS - t) : (t - ULAW_BIAS));
+}
+
+// ---------- IMA-ADPCM ----------
+struct AdpcmState {
+  int16_t predictor;
+  int8_t index;
+};
+
+static const int16_t ADPCM_STEP_TABLE[89] = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+  11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+  32767
+};
+
+static const int8_t ADPCM_INDEX_TABLE[16] = {
+  -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+// Aplica um nibble ao estado (comum ao codificador e ao decodificador)
+static inline int16_t adpcmStep(AdpcmState &st, uint8_t nibble) {
+  int step = ADPCM_STEP_TABLE[st.index];
+  int diff = step >> 3;
+  if (nibble & 4) diff += step;
+  if (nibble & 2) diff += step >> 1;
+  if (nibble & 1) diff += step >> 2;
+  int pred = st.predictor + ((nibble & 8) ? -diff : diff);
+  if (pred > 32767) pred = 32767;
+  if (pred < -32768) pred = -32768;
+  st.predictor = (int16_t)pred;
+  int idx = st.index + ADPCM_INDEX_TABLE[nibble];
+  st.index = (int8_t)(idx < 0 ? 0 : (idx > 88 ? 88 : idx));
+  return st.predictor;
+}
+
+static inline uint8_t adpcmEncodeSample(AdpcmState &st, int16_t s) {
+  int step = ADPCM_STEP_TABLE[st.index];
+  int diff = s - st.predictor;
+  uint8_t nibble = 0;
+  if (diff < 0) { nibble = 8; diff = -diff; }
+  if (diff >= step) { nibble |= 4; diff -= step; }
+  step >>= 1;
+  if (diff >= step) { nibble |= 2; diff -= step; }
+  step >>= 1;
+  if (diff >= step) { nibble |= 1; }
+  adpcmStep(st, nibble);
+  return nibble;
+}
+
+// ---------- Chunk ----------
+// Codifica n amostras em out (audioCodecEncodedSize bytes). O estado ADPCM
+// segue entre chunks, mas cada chunk carrega seu estado inicial e pode ser
+// decodificado isoladamente (tolerante a chunks suprimidos/perdidos).
+static size_t audioEncodeChunk(AudioCodec codec, AdpcmState &st,
+                               const int16_t *pcm, size_t n, uint8_t *out) {
+  switch (codec) {
+    case AUDIO_CODEC_ULAW:
+      for (size_t i = 0; i < n; i++) out[i] = ulawEncode(pcm[i]);
+      return n;
+
+    case AUDIO_CODEC_ADPCM: {
+      out[0] = (uint8_t)(st.predictor & 0xFF);
+      out[1] = (uint8_t)((uint16_t)st.predictor >> 8);
+      out[2] = (uint8_t)st.index;
+      out[3] = 0;
+      uint8_t *o = out + ADPCM_BLOCK_HEADER;
+      for (size_t i = 0; i < n; i += 2) {
+        uint8_t lo = adpcmEncodeSample(st, pcm[i]);
+        uint8_t hi = (i + 1 < n) ? adpcmEncodeSample(st, pcm[i + 1]) : 0;
+        *o++ = (uint8_t)(lo | (hi << 4));
+      }
+      return o - out;
+    }
+
+    case AUDIO_CODEC_PCM8:
+    default:
+      for (size_t i = 0; i < n; i++) out[i] = pcm8Encode(pcm[i]);
+      return n;
+  }
+}
+
+// Decodificador de referência: retorna o número de amostras escritas em pcm
+static size_t audioDecodeChunk(AudioCodec codec, const uint8_t *in, size_t len,
+                               int16_t *pcm, size_t maxSamples) {
+  size_t n = 0;
+  switch (codec) {
+    case AUDIO_CODEC_ULAW:
+      for (; n < len && n < maxSamples; n++) pcm[n] = ulawDecode(in[n]);
+      return n;
+
+    case AUDIO_CODEC_ADPCM: {
+      if (len < ADPCM_BLOCK_HEADER) return 0;
+      AdpcmState st;
+      st.predictor = (int16_t)(in[0] | (in[1] << 8));
+      st.index = (int8_t)(in[2] > 88 ? 88 : in[2]);
+      for (size_t i = ADPCM_BLOCK_HEADER; i < len && n < maxSamples; i++) {
+        pcm[n++] = adpcmStep(st, in[i] & 0x0F);
+        if (n < maxSamples) pcm[n++] = adpcmStep(st, in[i] >> 4);
+      }
+      return n;
+    }
+
+    case AUDIO_CODEC_PCM8:
+    default:
+      for (; n < len && n < maxSamples; n++) pcm[n] = pcm8Decode(in[n]);
+      return n;
+  }
+}
+
+#endif // AUDIO_CODEC_H
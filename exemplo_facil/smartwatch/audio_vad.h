@@ -0,0 +1,80 @@
+#ifndef AUDIO_VAD_H
+#define AUDIO_VAD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+// ==========================================
+// DETECÇÃO DE VOZ (VAD) - energia + taxa de cruzamentos por zero
+// ==========================================
+// Decide por bloco capturado se há voz. Custo: duas passadas inteiras
+// sobre o bloco (média DC, depois energia |x| e cruzamentos).
+//   - piso de ruído adaptativo (média lenta da energia em blocos sem voz)
+//   - voz: energia acima de ratio x piso + mínimo, com ZCR abaixo do
+//     típico de chiado; energia muito alta vale mesmo com ZCR alto
+//     (fricativas "s", "f")
+//   - hangover: mantém "voz" por alguns blocos após o último detectado
+
+struct VadState {
+  int32_t noise;        // piso de ruído (energia média |x|)
+  bool primed;          // piso já inicializado
+  uint8_t hangover;     // blocos restantes de hangover
+  int32_t lastEnergy;   // diagnóstico
+  uint16_t lastZcr;     // cruzamentos por 1000 amostras
+};
+
+static inline void vadReset(VadState &v) {
+  v.noise = 0;
+  v.primed = false;
+  v.hangover = 0;
+  v.lastEnergy = 0;
+  v.lastZcr = 0;
+}
+
+// Retorna true se o bloco deve ser transmitido (voz ou hangover)
+static bool vadProcess(VadState &v, const int16_t *pcm, size_t n) {
+  if (n == 0) return false;
+
+  int32_t sum = 0;
+  for (size_t i = 0; i < n; i++) sum += pcm[i];
+  int32_t dc = sum / (int32_t)n;
+
+  uint32_t energy = 0;
+  uint32_t crossings = 0;
+  bool prevPos = (pcm[0] - dc) >= 0;
+  for (size_t i = 0; i < n; i++) {
+    int32_t x = pcm[i] - dc;
+    energy += (uint32_t)(x < 0 ? -x : x);
+    // Histerese evita contar ruído em torno de zero
+    if (prevPos && x < -VAD_ZC_HYSTERESIS) { prevPos = false; crossings++; }
+    else if (!prevPos && x > VAD_ZC_HYSTERESIS) { prevPos = true; crossings++; }
+  }
+  int32_t e = (int32_t)(energy / n);
+  uint16_t zcr = (uint16_t)(crossings * 1000 / n);
+  v.lastEnergy = e;
+  v.lastZcr = zcr;
+
+  if (!v.primed) {
+    v.noise = e;
+    v.primed = true;
+  }
+
+  int32_t threshold = v.noise * VAD_ENERGY_RATIO + VAD_ENERGY_MIN;
+  bool voiced = (e > threshold && zcr < VAD_ZCR_MAX) || e > threshold * 2;
+
+  if (voiced) {
+    v.hangover = VAD_HANGOVER_CHUNKS;
+    return true;
+  }
+
+  // Só aprende o ruído em blocos sem voz
+  v.noise += (e - v.noise) / 16;
+  if (v.hangover > 0) {
+    v.hangover--;
+    return true;
+  }
+  return false;
+}
+
+#endif // AUDIO_VAD_H
@@ -5,6 +5,8 @@
 #include <Keypad.h>
 #include "keypad_config.h"
 #include "rf433.h"
+#include "ws_queue.h"
+#include "remote_input.h"
 
 // Forward declarations para evitar dependência circular
 void setScreen(ScreenMode screen);
@@ -14,6 +16,7 @@ void startStreaming();
 void stopStreaming();
 void syncScreenIndex();
 void processCalculatorInput(int buttonIndex, bool longPress);
+void displayInvalidate();
 
 // Funções de paginação da tela remota (definidas em screen_remote.h)
 // Como screen_remote.h é incluído no display_tft.h e não aqui, precisamos declarar
@@ -26,6 +29,7 @@ extern int getRemotePage();
 // Variáveis de notificações declaradas externamente
 extern int notificationCount;
 extern int currentNotificationIndex;
+extern void scrollNotification(int delta);
 
 // Variável de navegação RF433
 extern int currentRFCodeIndex;
@@ -82,7 +86,8 @@ int mapearTecla(char tecla) {
   return -1;
 }
 
-void updateButtons() {
+// Lê mudanças de estado do teclado matricial
+static void scanKeypad() {
   if (!teclado.getKeys()) return;
 
   static unsigned long pressStart[16] = {0};
@@ -102,6 +107,9 @@ void updateButtons() {
       Serial.print("Botão ");
       Serial.print(nomesTeclas[index]);
       Serial.println(" pressionado");
+
+      // Controle remoto: key-down imediato (repeat/up seguem em remote_input.h)
+      if (getCurrentScreen() == SCREEN_REMOTE) remoteKeyDown(index, getRemotePage());
     } else if (keyState == RELEASED) {
       unsigned long duracao = 0;
       if (isPressed[index]) {
@@ -113,6 +121,12 @@ void updateButtons() {
       Serial.print(nomesTeclas[index]);
       Serial.printf(" → Duração: %lums", duracao);
 
+      if (remoteKeyHeld(index)) {
+        Serial.println(" → Remote key-up");
+        remoteKeyUp(index);
+        continue;
+      }
+
       if (duracao >= LONG_PRESS_THRESHOLD) {
         Serial.println(" → Clique LONGO");
         processButtonAction(index, true);
@@ -124,6 +138,12 @@ void updateButtons() {
   }
 }
 
+void updateButtons() {
+  scanKeypad();
+  // Repeats de teclas seguradas e envio do frame de eventos remotos
+  updateRemoteInput();
+}
+
 // Array das telas disponíveis em ordem sequencial
 const ScreenMode screenOrder[] = {
   SCREEN_WATCHFACE,
@@ -192,6 +212,7 @@ void processButtonAction(int index, bool longPress) {
   // Se estiver na calculadora, processa entrada da calculadora
   if (currentScreen == SCREEN_CALCULATOR) {
     processCalculatorInput(index, longPress);
+    displayInvalidate();
     return;
   }
   
@@ -211,47 +232,14 @@ void processButtonAction(int index, bool longPress) {
       return;
     }
 
-    String cmd = "";
-    int page = getRemotePage();
-
-    if (page == 1) {
-      // --- PÁGINA 1: SETAS ---
-      // S2(1)=CIMA, S5(4)=ESQ, S6(5)=ENTER, S7(6)=DIR, S10(9)=BAIXO
-      switch (index) {
-        case 1: cmd = "CIMA"; break;      // S2
-        case 4: cmd = "ESQ"; break;       // S5
-        case 6: cmd = "DIR"; break;       // S7
-        case 9: cmd = "BAIXO"; break;     // S10
-        case 5: cmd = "ENTER"; break;     // S6
-      }
-    } else if (page == 2) {
-      // --- PÁGINA 2: NUMÉRICO ---
-      // S1..S3 (0..2) -> 1,2,3
-      // S5..S7 (4..6) -> 4,5,6
-      // S9..S11 (8..10) -> 7,8,9
-      // S12 (11) -> 0
-      // S4 (3) -> ENTER
-      // S8 (7) -> BACKSPACE
-      switch (index) {
-        case 0: cmd = "NUM_1"; break;
-        case 1: cmd = "NUM_2"; break;
-        case 2: cmd = "NUM_3"; break;
-        case 4: cmd = "NUM_4"; break;
-        case 5: cmd = "NUM_5"; break;
-        case 6: cmd = "NUM_6"; break;
-        case 8: cmd = "NUM_7"; break;
-        case 9: cmd = "NUM_8"; break;
-        case 10: cmd = "NUM_9"; break;
-        case 11: cmd = "NUM_0"; break; // S12
-        case 3: cmd = "ENTER"; break;  // S4
-        case 7: cmd = "BACKSPACE"; break; // S8
-      }
-    }
-    if (cmd != "") {
-      String payload = randomId + "|" + remoteSecret + "|" + cmd;
-      webSocket.sendTXT(payload);
-      Serial.println("Remote CMD enviado: " + payload);
-    }
+    // Teclas de setas/numéricas são enviadas como eventos down/up/repeat
+    // direto do scanKeypad() (remote_input.h)
+    return;
+  }
+
+  // Notificações: pressão longa em S14/S15 rola a mensagem atual
+  if (currentScreen == SCREEN_NOTIFICATIONS && longPress && (index == 13 || index == 14)) {
+    scrollNotification(index == 13 ? -1 : 1);
     return;
   }
 
@@ -263,6 +251,7 @@ void processButtonAction(int index, bool longPress) {
       } else {
         currentNotificationIndex = notificationCount - 1; // Volta para a última
       }
+      displayInvalidate();
       return;
     } else if (index == 14 && !longPress) { // S15 - próxima
       if (currentNotificationIndex < notificationCount - 1) {
@@ -270,6 +259,7 @@ void processButtonAction(int index, bool longPress) {
       } else {
         currentNotificationIndex = 0; // Volta para a primeira
       }
+      displayInvalidate();
       return;
     }
   }
@@ -284,6 +274,7 @@ void processButtonAction(int index, bool longPress) {
         } else {
           currentRFCodeIndex = codesCount - 1; // Volta para o último
         }
+        displayInvalidate();
         return;
       } else if (index == 13 && !longPress) { // S14 - próximo código
         if (currentRFCodeIndex < codesCount - 1) {
@@ -291,6 +282,7 @@ void processButtonAction(int index, bool longPress) {
         } else {
           currentRFCodeIndex = 0; // Volta para o primeiro
         }
+        displayInvalidate();
         return;
       } else if (index == 0 && !longPress) { // S1 - enviar código atual
         sendRFCode(currentRFCodeIndex + 1); // Índices começam em 1
@@ -309,6 +301,7 @@ void processButtonAction(int index, bool longPress) {
         } else {
           currentIRCodeIndex = codesCount - 1; // Volta para o último
         }
+        displayInvalidate();
         return;
       } else if (index == 13 && !longPress) { // S14 - próximo código
         if (currentIRCodeIndex < codesCount - 1) {
@@ -316,6 +309,7 @@ void processButtonAction(int index, bool longPress) {
         } else {
           currentIRCodeIndex = 0; // Volta para o primeiro
         }
+        displayInvalidate();
         return;
       } else if (index == 1 && !longPress) { // S2 - listar códigos
         Serial.println("IR: Solicitando lista de codigos ao Arduino");
@@ -0,0 +1,66 @@
+#ifndef CLOCK_SERVICE_H
+#define CLOCK_SERVICE_H
+
+#include <Arduino.h>
+#include <time.h>
+
+// ==========================================
+// RELÓGIO EM CACHE - hora quebrada e textos atualizados 1x por segundo
+// ==========================================
+// updateClock() (no loop) só chama localtime_r/snprintf quando o segundo do
+// RTC muda; as telas leem os campos e buffers prontos, sem String.
+// Eventos: clockSecondSeq / clockMinuteSeq incrementam a cada troca; cada tela
+// guarda o último valor visto e redesenha só o que mudou (clockChanged()).
+// Sem NTP, mostra 00:00:00 / 01/01 / 2025 como antes.
+
+extern bool ntpSincronizado;
+
+struct ClockState {
+  int hour, minute, second;
+  int day, month, year;
+  int wday;
+  char timeStr[9];     // "HH:MM:SS"
+  char dateStr[6];     // "DD/MM"
+};
+
+ClockState clockNow = { 0, 0, 0, 1, 1, 2025, 0, "00:00:00", "01/01" };
+uint32_t clockSecondSeq = 0;
+uint32_t clockMinuteSeq = 0;
+static time_t clockLastEpoch = 0;
+
+void updateClock() {
+  if (!ntpSincronizado) return;
+  time_t now = time(nullptr);
+  if (now == clockLastEpoch) return;
+  clockLastEpoch = now;
+
+  struct tm t;
+  localtime_r(&now, &t);
+  bool minuteChanged = t.tm_min != clockNow.minute || t.tm_hour != clockNow.hour ||
+                       clockSecondSeq == 0;
+
+  clockNow.hour = t.tm_hour;
+  clockNow.minute = t.tm_min;
+  clockNow.second = t.tm_sec;
+  clockNow.day = t.tm_mday;
+  clockNow.month = t.tm_mon + 1;
+  clockNow.year = t.tm_year + 1900;
+  clockNow.wday = t.tm_wday;
+  snprintf(clockNow.timeStr, sizeof(clockNow.timeStr), "%02d:%02d:%02d",
+           clockNow.hour, clockNow.minute, clockNow.second);
+  if (minuteChanged) {
+    snprintf(clockNow.dateStr, sizeof(clockNow.dateStr), "%02d/%02d",
+             clockNow.day, clockNow.month);
+    clockMinuteSeq++;
+  }
+  clockSecondSeq++;
+}
+
+// true (uma vez) se seq avançou desde o último valor visto em `seen`
+static inline bool clockChanged(uint32_t &seen, uint32_t seq) {
+  if (seen == seq) return false;
+  seen = seq;
+  return true;
+}
+
+#endif // CLOCK_SERVICE_H
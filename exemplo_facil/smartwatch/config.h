@@ -29,9 +29,25 @@
 
 // ===== ÁUDIO =====
 #define SAMPLE_RATE 8000              // Taxa de amostragem 8kHz
-#define RECORD_SECONDS 3              // Duração da gravação em segundos
-#define BUFFER_SIZE (SAMPLE_RATE * RECORD_SECONDS)
+#define RECORD_SECONDS 3              // Duração padrão da gravação em segundos
+#define AUDIO_RECORD_ENABLED 1        // 0 = sem gravação de clipes (nenhum buffer reservado)
+#define AUDIO_CLIP_PSRAM_SECONDS 60   // Anel em PSRAM (mantém os últimos N segundos)
+#define AUDIO_CLIP_FLASH_SECONDS 300  // Limite do arquivo em LittleFS sem PSRAM
+#define AUDIO_CLIP_UPLOAD_INTERVAL_MS 40 // Um chunk (64ms de áudio) a cada 40ms no envio
 #define AUDIO_CHUNK_SIZE 512          // Tamanho dos blocos para envio
+#define AUDIO_DMA_BUF_COUNT 4         // Buffers DMA de AUDIO_CHUNK_SIZE (I2S ADC)
+#define MIC_ADC_CHANNEL ADC1_CHANNEL_7 // GPIO35 = ADC1 canal 7
+#define AUDIO_DEFAULT_CODEC 0         // 0 = PCM8, 1 = µ-law, 2 = IMA-ADPCM
+// VAD (detecção de voz) - só transmite trechos com voz
+#define AUDIO_VAD_ENABLED 1           // Padrão ao iniciar (comandos vad_on/vad_off)
+#define VAD_ENERGY_RATIO 3            // Voz: energia > 3x o piso de ruído...
+#define VAD_ENERGY_MIN 200            // ...+ mínimo absoluto (PCM 16 bits, média |x|)
+#define VAD_ZCR_MAX 350               // Cruzamentos por 1000 amostras (acima = chiado)
+#define VAD_ZC_HYSTERESIS 64          // Faixa morta para contar cruzamentos
+#define VAD_HANGOVER_CHUNKS 5         // Continua enviando ~320ms após a voz
+#define VAD_PREROLL_CHUNKS 2          // Chunks anteriores enviados no início da voz
+#define VAD_MARKER_EVERY 16           // Marcador de silêncio a cada ~1s suprimido
+#define AUDIO_WS_BINARY 0             // 1 = frame binário sem base64; 0 = texto "audio|idx|-1|base64"
 
 // ===== NTP (Network Time Protocol) =====
 #define NTP_SERVER "pool.ntp.org"
@@ -44,14 +60,36 @@
 #define WS_PATH "/"
 #define WS_USER "esp"
 #define WS_PASS "neurelix"
+#define WSQ_BYTES 2048                // Fila de saída: bytes totais pendentes
+#define WSQ_MAX_ENTRIES 16            // Fila de saída: mensagens pendentes
+#define WSQ_FRAME_MAX 512             // Maior frame (ecos maiores são truncados)
+#define WSQ_FLUSH_BUDGET 1024         // Bytes enviados por passada do loop
+#define WS_VERBOSE_LOG 0              // 1 = loga cada frame recebido (texto + bytes finais em hex)
 
 // ===== DNS SERVER (Portal de configuração) =====
 #define DNS_PORT 53
+#define PORTAL_MAX_NETS 20            // Redes guardadas do último scan
+#define PORTAL_HASH_SLOTS 64          // Conjunto de SSIDs vistos (potência de 2)
+#define PORTAL_CHUNK_SIZE 1024        // Pedaço da página enviado por vez
 
 // ===== SENSORES =====
 // MPU6050
 #define MPU_I2C_ADDRESS 0x68
-#define MPU_READ_INTERVAL_MS 100      // Lê MPU a cada 100ms
+#define MPU_READ_INTERVAL_MS 20       // Lê MPU a cada 20ms (50Hz, pedômetro)
+
+// Pedômetro (amostrado junto com o MPU, 50Hz)
+#define GRAVITY_MS2 9.80665f
+#define PEDO_HP_ALPHA 0.02f           // Passa-alta: média lenta da gravidade (~1s)
+#define PEDO_LP_ALPHA 0.35f           // Passa-baixa: corte ~5Hz
+#define PEDO_ENVELOPE_DECAY 0.99f     // Decaimento do envelope de picos (~2s)
+#define PEDO_THRESHOLD_RATIO 0.5f     // Limiar = 50% do envelope
+#define PEDO_MIN_THRESHOLD 1.0f       // m/s², ignora tremores
+#define PEDO_MIN_STEP_MS 250          // Período refratário (máx. 4 passos/s)
+#define PEDO_BUDGET_US 50             // Orçamento de CPU por amostra
+#define PEDO_SAVE_STEPS 200           // Grava no flash a cada 200 passos...
+#define PEDO_SAVE_INTERVAL_MS 600000UL // ...ou a cada 10 min com mudança
+#define PEDO_DAILY_GOAL 8000          // Meta diária (arco de passos)
+#define PEDO_KCAL_PER_STEP 0.04f      // Estimativa média por passo
 
 // MAX30102 (Heart Rate & SpO2)
 #define MAX30102_I2C_ADDRESS 0x57
@@ -88,16 +126,53 @@
 #define READ_INTERVAL_MS 5000UL       // Intervalo entre leituras/report
 #define STALE_MS 15000UL              // Expiração de valores suavizados
 
+// ===== TELEMETRIA (stream binário de sensores) =====
+#define TELEMETRY_INTERVAL_MS 100     // Taxa padrão: 10 amostras/s
+#define TELEMETRY_MIN_INTERVAL_MS 20  // Limite da taxa do MPU (50Hz)
+#define TELEMETRY_BATCH 10            // Amostras por frame WebSocket
+
 // ===== BOTÕES =====
 #define LONG_PRESS_THRESHOLD 2000     // 2 segundos para clique longo
 
+// Controle remoto (remote_input.h)
+#define REMOTE_REPEAT_DELAY_MS 400    // Segurando seta: primeiro repeat
+#define REMOTE_REPEAT_INTERVAL_MS 80  // Depois, um repeat a cada 80ms
+#define REMOTE_MAX_EVENTS 16          // Eventos por frame binário
+
 // ===== DISPLAY =====
-#define TFT_UPDATE_INTERVAL 200       // Atualiza watchface a cada 200ms
-#define TFT_STATIC_UPDATE_INTERVAL 1000  // Elementos estáticos a cada 1s
+// Taxa de quadros por tela (0 = só redesenha quando invalidada)
+#define DISPLAY_FPS_WATCHFACE 1       // + a cada virada de segundo do relógio
+#define DISPLAY_FPS_SENSORS 5
+#define DISPLAY_FPS_STATUS 1
+#define DISPLAY_FPS_CUBE3D 30
+#define DISPLAY_MAX_SLEEP_MS 10       // Sono máximo do loop entre quadros
+#define FACE_CACHE_BAND_ROWS 24       // Linhas por faixa ao gerar o cache do fundo
+#define FACE_CACHE_DMA_PIXELS 2048    // Pixels por bloco de DMA (2 buffers)
+#define ICON_RLE_CHUNK 128            // Pixels por pushColors ao desenhar ícones RLE
+#define ICON_RLE_BLOCK_MIN 16         // Corridas a partir daqui vão direto com pushBlock
+#define GLYPH_CACHE_SLOTS 12          // Glifos grandes já misturados (LRU); 12 cobre 0-9, ':' e ' '
+#define TEXT_LAYOUT_CHARS (NOTIFY_MSG_MAX + 1) // Texto guardado por layout: uma notificação inteira
+#define TEXT_LAYOUT_LINES 32          // Linhas quebradas guardadas por layout (~20 para NOTIFY_MSG_MAX)
+#define QR_AREA_PX 150                // Lado do QR na tela (com a zona de silêncio)
+#define QR_MODULE_MIN_PX 2            // Menor módulo que a câmera ainda lê na tela
+#define QR_QUIET_MODULES 2            // Zona de silêncio: módulos claros em volta
+
+// ===== NOTIFICAÇÕES =====
+#define NOTIFY_CAPACITY 32            // Notificações guardadas (as mais antigas saem)
+#define NOTIFY_ARENA_BYTES 4096       // Arena única para os textos
+#define NOTIFY_MSG_MAX 512            // Bytes por mensagem (o resto é cortado)
+#define NOTIFY_PERSIST 1              // 0 = só RAM; 1 = log em LittleFS, relido no boot
+#define NOTIFY_LOG_MAX_BYTES 16384    // Acima disso o log é compactado
+#define NOTIFY_TOAST_Y 84             // Centro do toast sobre a tela atual (linha)
+#define NOTIFY_TOAST_MS 2500          // Tempo parado na tela
+#define NOTIFY_TOAST_FRAMES 4         // Quadros da entrada e da saída
+#define NOTIFY_TOAST_FRAME_MS 25      // Intervalo entre quadros da animação
 
 // ===== TEMPORIZAÇÕES =====
 #define PING_INTERVAL_MS 50000        // Ping a cada 50s
-#define DISPLAY_UPDATE_INTERVAL_MS 200 // Atualiza display a cada 200ms
+#define WIFI_CONNECT_TIMEOUT_MS 15000 // Sem conexão após 15s -> portal
+#define NTP_SYNC_TIMEOUT_MS 10000     // Sem NTP após 10s -> API HTTP (em segundo plano)
+#define TIME_API_TIMEOUT_MS 8000      // Timeout da requisição HTTP de hora
 
 // ===== MODOS DE TELA =====
 enum ScreenMode {
@@ -6,7 +6,7 @@
   - Tudo em estilo C procedural (sem classes, sem .cpp).
   - Usa `extern TFT_eSPI tft;` para desenhar.
   - Consome variáveis de orientação: `mpuPitch`, `mpuRoll`, `mpuYaw` (em graus).
-  - Controle de FPS leve (~30 FPS) usando millis().
+  - Taxa (~30 FPS) definida pelo agendador de quadros do display_tft.h.
 
   Integração:
   - Incluir este arquivo em `display_tft.h` (ou onde gerencia as telas).
@@ -94,7 +94,7 @@ static const int ARROW_PERSISTENCE = 20;
 // Declaração antecipada de variáveis de estado
 static uint32_t c_lastMicros = 0;
 static unsigned long c_lastUpdate = 0;
-static const unsigned long UPDATE_MS = 33; // ~30 FPS
+static const unsigned long UPDATE_MS = 33; // dt padrão (~30 FPS)
 static bool cube_needsRedraw = false;
 
 static int centerX = 120;
@@ -203,8 +203,7 @@ void cube3d_init()
 
 void cube3d_update(unsigned long nowMillis)
 {
-  // Controle de FPS (throttle)
-  if (nowMillis - c_lastUpdate < UPDATE_MS) return;
+  // Cadência vem do agendador (DISPLAY_FPS_CUBE3D); dt real via micros()
   c_lastUpdate = nowMillis;
   cube_needsRedraw = true;
 
@@ -0,0 +1,101 @@
+#ifndef DISPLAY_CLIP_H
+#define DISPLAY_CLIP_H
+
+#include <TFT_eSPI.h>
+
+// ==========================================
+// RECORTE DO DISPLAY - base + retângulo
+// ==========================================
+// O overlay de notificação (notify_overlay.h) reserva uma faixa da tela e as
+// telas passam a desenhar só fora dela: displayClipBase() define esse recorte
+// base. Quem recorta por conta própria (restauração do fundo, dano do
+// watchface, rolagem de texto) usa displayClipPush()/displayClipPop() no
+// lugar de setViewport()/resetViewport(): o retângulo é cruzado com a base e,
+// no fim, volta para a base (resetViewport() liberaria a faixa do overlay).
+// Só o objeto registrado em displayClipInit() tem base; em sprites push/pop
+// são setViewport()/resetViewport() comuns.
+// O estado fica aqui porque os getters de viewport do TFT_eSPI não informam
+// o recorte em coordenadas de tela quando setViewport(..., false).
+
+struct DisplayClip {
+  int16_t x, y, w, h;
+};
+
+static TFT_eSPI *displayClipOwner = nullptr;
+static DisplayClip displayClipBaseRect = { 0, 0, 0, 0 };
+static DisplayClip displayClipNow = { 0, 0, 0, 0 };     // recorte aplicado
+static bool displayClipHasBase = false;
+
+static DisplayClip displayClipFull(TFT_eSPI &tft) {
+  DisplayClip c = { 0, 0, (int16_t)tft.width(), (int16_t)tft.height() };
+  return c;
+}
+
+static DisplayClip displayClipIntersect(const DisplayClip &a, const DisplayClip &b) {
+  int16_t x0 = max(a.x, b.x), y0 = max(a.y, b.y);
+  int16_t x1 = min(a.x + a.w, b.x + b.w), y1 = min(a.y + a.h, b.y + b.h);
+  DisplayClip c = { x0, y0, (int16_t)max(0, x1 - x0), (int16_t)max(0, y1 - y0) };
+  return c;
+}
+
+static void displayClipApply(TFT_eSPI &tft, const DisplayClip &c) {
+  displayClipNow = c;
+  DisplayClip full = displayClipFull(tft);
+  if (c.x == 0 && c.y == 0 && c.w == full.w && c.h == full.h) {
+    tft.resetViewport();
+  } else {
+    // Recorte vazio: o TFT_eSPI descarta todo desenho (viewport fora da tela)
+    tft.setViewport(c.x, c.y, c.w, c.h, false);
+  }
+}
+
+static void displayClipInit(TFT_eSPI &tft) {
+  displayClipOwner = &tft;
+  displayClipHasBase = false;
+  displayClipApply(tft, displayClipFull(tft));
+}
+
+// Recorte base do display (faixa livre para as telas)
+static void displayClipBase(TFT_eSPI &tft, int16_t x, int16_t y, int16_t w, int16_t h) {
+  DisplayClip c = { x, y, w, h };
+  displayClipBaseRect = displayClipIntersect(c, displayClipFull(tft));
+  displayClipHasBase = true;
+  displayClipApply(tft, displayClipBaseRect);
+}
+
+static void displayClipBaseReset(TFT_eSPI &tft) {
+  displayClipHasBase = false;
+  displayClipApply(tft, displayClipFull(tft));
+}
+
+static void displayClipPush(TFT_eSPI &tft, int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (&tft != displayClipOwner) {
+    tft.setViewport(x, y, w, h, false);
+    return;
+  }
+  DisplayClip c = { x, y, w, h };
+  displayClipApply(tft, displayClipIntersect(c, displayClipHasBase ? displayClipBaseRect : displayClipFull(tft)));
+}
+
+static void displayClipPop(TFT_eSPI &tft) {
+  if (&tft != displayClipOwner) {
+    tft.resetViewport();
+    return;
+  }
+  displayClipApply(tft, displayClipHasBase ? displayClipBaseRect : displayClipFull(tft));
+}
+
+// O retângulo inteiro está dentro do recorte atual? (janela de endereços
+// direta não recorta; fora disso, desenhar pela biblioteca)
+static bool displayClipContains(TFT_eSPI &tft, int16_t x, int16_t y, int16_t w, int16_t h) {
+  DisplayClip c = displayClipFull(tft);
+  if (&tft == displayClipOwner) {
+    c = displayClipNow;
+  } else if (tft.getViewportX() != 0 || tft.getViewportY() != 0 ||
+             tft.getViewportWidth() != c.w || tft.getViewportHeight() != c.h) {
+    return false;
+  }
+  return x >= c.x && y >= c.y && x + w <= c.x + c.w && y + h <= c.y + c.h;
+}
+
+#endif // DISPLAY_CLIP_H
@@ -10,6 +10,10 @@
 #include "rf433.h"
 #include "qr_code.h"
 #include "cubo3d.h"
+#include "widgets.h"
+#include "text_layout.h"
+#include "text_charset.h"
+#include "notify_store.h"
 
 // Declarações externas para QR Code
 extern void setQrcodeText(String text);
@@ -19,6 +23,11 @@ extern void forceQrcodeRedraw();
 
 // Declarações externas
 extern bool ntpSincronizado;
+extern bool isAudioActive();
+extern uint32_t getAudioSampleRate();
+extern uint32_t getAudioDroppedBuffers();
+extern uint32_t audioChunksSent;
+extern uint32_t audioChunksSuppressed;
 
 // ==========================================
 // MÓDULO DE DISPLAY TFT 240x240
@@ -31,16 +40,17 @@ TFT_eSPI tft;
 #include "screen_rf433.h"
 #include "screen_ir.h"
 #include "screen_remote.h" // Adicionado
+#include "notify_overlay.h"
 
 // Estado
 ScreenMode currentScreen = SCREEN_WATCHFACE;
 ScreenMode lastScreen = SCREEN_NONE; // Para detectar mudança de tela
-int currentWatchFace = 3; // Padrão: V3
+int currentWatchFace = CURRENT_WATCHFACE; // 1 = passos/kcal, 3 = barras curvas
 bool firstRender = true; // Flag de primeira renderização
 
-// Timestamps para throttling
-unsigned long lastDisplayUpdate = 0;
-unsigned long lastStaticUpdate = 0;
+// Custo de CPU por quadro (média móvel e pico, em µs)
+uint32_t displayFrameMicros = 0;
+uint32_t displayFrameMaxMicros = 0;
 
 // Estado da calculadora (declarado externamente em calculadora.h)
 extern Calc3RoundBrightState calculatorState;
@@ -50,18 +60,15 @@ int currentRFCodeIndex = 0; // Índice do código RF sendo visualizado
 // Estado IR
 int currentIRCodeIndex = 0; // Índice do código IR sendo visualizado
 
-// Sistema de notificações
-#define MAX_NOTIFICATIONS 10
-struct Notification {
-  String message;
-  String timestamp;
-  bool isRead;
-};
-
-Notification notifications[MAX_NOTIFICATIONS];
-int notificationCount = 0;
+// Sistema de notificações (armazém em notify_store.h)
+int notificationCount = 0;          // Espelho de notifyCount() para os botões
 int currentNotificationIndex = 0;
-int lastDisplayedNotification = -1; // Para detectar mudanças na notificação atual
+uint32_t notificationsRev = 0;      // Incrementa a cada inclusão/limpeza
+int notificationScroll = 0;         // Primeira linha visível da mensagem
+
+// Layout da mensagem: quebrado uma vez por notificação exibida
+static TextCircle screenCircle;
+static TextLayout notificationLayout;
 
 // Funções públicas
 void initDisplay();
@@ -75,13 +82,16 @@ void renderQrcodeScreen(bool firstRender);
 void renderRF433Screen(bool firstRender);
 void renderIRScreen(bool firstRender);
 void renderRemoteScreen(bool firstRender); // Adicionado
+void displayInvalidate();
+uint32_t displaySleepMs(uint32_t maxMs);
 void setScreen(ScreenMode screen);
 ScreenMode getCurrentScreen();
 void showMessage(String msg);
 
 // Funções de notificações
-void addNotification(String message);
+void addNotification(String message, uint32_t receivedUs = 0);
 void clearNotifications();
+void scrollNotification(int delta);
 bool hasUnreadNotifications();
 
 // ===== IMPLEMENTAÇÃO =====
@@ -96,6 +106,7 @@ void initDisplay() {
   Serial.println("TFT.init() concluído");
 
   tft.setRotation(0); // Rotação normal
+  displayClipInit(tft);
   Serial.println("Rotação definida");
 
   // Inicializar backlight
@@ -118,6 +129,10 @@ void initDisplay() {
   initQrcode();
   Serial.println("QR Code inicializado");
 
+  // Notificações salvas antes do reboot
+  notifyStoreBegin();
+  notificationCount = notifyCount();
+
   // Inicializa estado da calculadora
   calculatorState.currentExpr = "";
   calculatorState.currentResult = "0";
@@ -147,147 +162,261 @@ ScreenMode getCurrentScreen() {
   return currentScreen;
 }
 
-void updateDisplay() {
-  unsigned long now = millis();
-  
-  // Throttling: limita taxa de atualização
-  if (now - lastDisplayUpdate < TFT_UPDATE_INTERVAL) {
-    return; // Pula esta frame
+// Telas com assinatura diferente de render(bool)
+static void renderWatchfaceScreen(bool firstRender) {
+  renderWatchface(firstRender, false);
+}
+
+static void renderCube3DScreen(bool firstRender) {
+  // Atualiza estado baseado nos sensores e desenha o cubo; a cadência vem
+  // de DISPLAY_FPS_CUBE3D na SCREEN_TABLE
+  if (firstRender) cube_needsRedraw = true;
+  cube3d_update(millis());
+  cube3d_draw();
+}
+
+// ==========================================
+// AGENDADOR DE QUADROS
+// ==========================================
+// Cada tela declara sua taxa na tabela abaixo:
+//   fps = 0  só redesenha quando invalidada (troca de tela, displayInvalidate()
+//            ou o contador `rev` mudou); parada, não faz nenhuma chamada de desenho
+//   fps > 0  redesenha a cada 1000/fps ms (cadência fixa)
+//   rev      contador de revisão opcional (ex.: segundo do relógio, lista de
+//            notificações); quando muda, a tela é redesenhada na hora
+// updateDisplay() só renderiza quando o prazo da tela atual venceu; o loop
+// dorme até esse prazo com displaySleepMs().
+struct ScreenEntry {
+  ScreenMode mode;
+  void (*render)(bool firstRender);
+  uint8_t fps;
+  const uint32_t *rev;
+};
+
+extern uint32_t qrcodeRev;
+extern uint32_t rf433Rev;
+
+static const ScreenEntry SCREEN_TABLE[] = {
+  { SCREEN_WATCHFACE,     renderWatchfaceScreen,    DISPLAY_FPS_WATCHFACE, &clockSecondSeq },
+  { SCREEN_SENSORS,       renderSensorsScreen,      DISPLAY_FPS_SENSORS,   nullptr },
+  { SCREEN_CALCULATOR,    renderCalculatorScreen,   0,                     nullptr },
+  { SCREEN_NOTIFICATIONS, renderNotificationScreen, 0,                     &notificationsRev },
+  { SCREEN_STATUS,        renderStatusScreen,       DISPLAY_FPS_STATUS,    nullptr },
+  { SCREEN_REMOTE,        renderRemoteScreen,       0,                     nullptr },
+  { SCREEN_CUBE3D,        renderCube3DScreen,       DISPLAY_FPS_CUBE3D,    nullptr },
+  { SCREEN_QRCODE,        renderQrcodeScreen,       0,                     &qrcodeRev },
+  { SCREEN_IR,            renderIRScreen,           0,                     &rf433Rev },
+  { SCREEN_RF433,         renderRF433Screen,        0,                     &rf433Rev },
+};
+#define SCREEN_TABLE_SIZE (sizeof(SCREEN_TABLE) / sizeof(SCREEN_TABLE[0]))
+
+// Estatísticas por tela (mesma ordem da tabela)
+struct ScreenStats {
+  uint32_t frames;
+  uint32_t avgMicros;     // média móvel do tempo de render
+  uint32_t maxMicros;
+  uint32_t overruns;      // quadro terminou depois do prazo do seguinte
+};
+
+static ScreenStats screenStats[SCREEN_TABLE_SIZE];
+static bool displayInvalidated = false;
+static uint32_t displayDeadline = 0;      // millis() do próximo quadro periódico
+static uint32_t displaySeenRev = 0;
+
+static int screenEntryIndex(ScreenMode mode) {
+  for (size_t i = 0; i < SCREEN_TABLE_SIZE; i++) {
+    if (SCREEN_TABLE[i].mode == mode) return (int)i;
   }
-  lastDisplayUpdate = now;
-  
-  // Atualiza elemento que varia mais devagar
-  bool updateStatic = (now - lastStaticUpdate >= TFT_STATIC_UPDATE_INTERVAL);
-  if (updateStatic) {
-    lastStaticUpdate = now;
+  return -1;
+}
+
+// Pede um redesenho da tela atual no próximo updateDisplay()
+void displayInvalidate() {
+  displayInvalidated = true;
+}
+
+// Quanto o loop pode dormir sem atrasar o próximo quadro (limitado a maxMs)
+uint32_t displaySleepMs(uint32_t maxMs) {
+  if (firstRender || displayInvalidated) return 0;
+  maxMs = notifyOverlaySleepMs(maxMs);
+  int idx = screenEntryIndex(currentScreen);
+  if (idx < 0 || SCREEN_TABLE[idx].fps == 0) return maxMs;
+  int32_t left = (int32_t)(displayDeadline - millis());
+  if (left <= 0) return 0;
+  return (uint32_t)left < maxMs ? (uint32_t)left : maxMs;
+}
+
+static void logScreenStats(ScreenMode mode) {
+  int idx = screenEntryIndex(mode);
+  if (idx < 0 || screenStats[idx].frames == 0) return;
+  const ScreenStats &st = screenStats[idx];
+  Serial.printf("Tela %d: %u quadros, %uus médio, %uus max, %u atrasos\n", mode,
+                (unsigned)st.frames, (unsigned)st.avgMicros, (unsigned)st.maxMicros, (unsigned)st.overruns);
+  if (mode == SCREEN_WATCHFACE && faceCacheFrames) {
+    Serial.printf("Cache do fundo: %s, %u px/quadro restaurados do cache, geração %ums\n",
+                  faceCacheStorageName(), (unsigned)faceCacheAvgHitArea, (unsigned)faceCacheBuildMs);
+  }
+}
+
+void updateDisplay() {
+  int idx = screenEntryIndex(currentScreen);
+  if (idx < 0) return;
+  const ScreenEntry &e = SCREEN_TABLE[idx];
+  uint32_t now = millis();
+
+  bool periodic = e.fps > 0 && (int32_t)(now - displayDeadline) >= 0;
+  bool revChanged = e.rev && *e.rev != displaySeenRev;
+  if (!firstRender && !displayInvalidated && !revChanged && !periodic) {
+    // Tela parada: só o toast anda (as linhas que ele libera são repintadas
+    // com render(true) recortado); nada a fazer se ele também não venceu
+    notifyOverlayUpdate(e.render);
+    return;
   }
-  
-  // Verifica se precisa forçar redesenho da tela de notificações
-  bool forceNotificationRedraw = (currentScreen == SCREEN_NOTIFICATIONS &&
-                                  lastDisplayedNotification != currentNotificationIndex);
 
-  // Renderiza tela atual
   if (firstRender) {
+    logScreenStats(lastScreen);
     Serial.printf("Renderizando tela: %d (firstRender=true)\n", currentScreen);
   }
-
-  switch (currentScreen) {
-    case SCREEN_WATCHFACE:
-      renderWatchface(firstRender, updateStatic);
-      break;
-    case SCREEN_SENSORS:
-      renderSensorsScreen(firstRender);
-      break;
-    case SCREEN_CALCULATOR:
-      renderCalculatorScreen(firstRender);
-      break;
-    case SCREEN_NOTIFICATIONS:
-      renderNotificationScreen(firstRender || forceNotificationRedraw);
-      lastDisplayedNotification = currentNotificationIndex; // Atualiza o último exibido
-      break;
-    case SCREEN_STATUS:
-      renderStatusScreen(firstRender);
-      break;
-    case SCREEN_REMOTE: // Adicionado
-      renderRemoteScreen(firstRender);
-      break;
-    case SCREEN_CUBE3D:
-      // Atualiza estado baseado nos sensores e desenha o cubo (throttle interno)
-      cube3d_update(now);
-      cube3d_draw();
-      break;
-    case SCREEN_QRCODE:
-      renderQrcodeScreen(firstRender);
-      break;
-    case SCREEN_IR:
-      renderIRScreen(firstRender);
-      break;
-    case SCREEN_RF433:
-      renderRF433Screen(firstRender);
-      break;
+  displayInvalidated = false;
+  if (e.rev) displaySeenRev = *e.rev;
+
+  uint32_t frameStart = micros();
+  e.render(firstRender);
+  uint32_t frameUs = micros() - frameStart;
+
+  displayFrameMicros = (displayFrameMicros * 7 + frameUs) / 8;
+  if (frameUs > displayFrameMaxMicros) displayFrameMaxMicros = frameUs;
+
+  ScreenStats &st = screenStats[idx];
+  st.avgMicros = st.frames ? (st.avgMicros * 7 + frameUs) / 8 : frameUs;
+  if (frameUs > st.maxMicros) st.maxMicros = frameUs;
+  st.frames++;
+
+  if (e.fps > 0) {
+    // Quadro do prazo mantém a cadência; quadro por evento reinicia a contagem
+    uint32_t period = 1000 / e.fps;
+    displayDeadline = (periodic && !firstRender) ? displayDeadline + period : now + period;
+    uint32_t end = millis();
+    if ((int32_t)(end - displayDeadline) >= 0) {
+      st.overruns++;
+      displayDeadline = end + period;
+    }
   }
 
   firstRender = false; // Já renderizou pela primeira vez
+
+  // Toast por cima, depois do quadro: as linhas devolvidas pela tela saem
+  // com os mesmos dados que o resto dela
+  notifyOverlayUpdate(e.render);
+}
+
+// Watchface V1: passos/kcal do pedômetro. drawWatchFace() compara cada
+// elemento com o que está na tela e só restaura/redesenha o que mudou.
+void renderWatchfaceV1(bool firstRender) {
+  SensorData sd = getSensorData();
+
+  WatchFaceData d;
+  d.hour = clockNow.hour;
+  d.minute = clockNow.minute;
+  d.steps = (int)getStepsToday();
+  d.heart = sd.bpm > 0 ? sd.bpm : 0;
+  d.kcal = getKcalToday();
+  d.battery = 85;
+  d.date = clockNow.dateStr;
+  d.wday = "";
+  d.stepsProgress = getStepsProgress();
+  d.heartProgress = sd.bpm > 0 ? (float)sd.bpm / 200.0f : 0.0f;
+
+  drawWatchFace(tft, d, firstRender);
 }
 
 void renderWatchface(bool firstRender, bool updateStatic) {
-  WatchFaceV3Data wfData;
+  if (currentWatchFace == 1) {
+    faceCacheFrameBegin();
+    renderWatchfaceV1(firstRender);
+    faceCacheFrameEnd();
+    return;
+  }
 
-  // Extrai hora/minuto/segundo da string de tempo
-  String timeStr = getTimeString();
-  wfData.hour = timeStr.substring(0, 2).toInt();
-  wfData.minute = timeStr.substring(3, 5).toInt();
-  wfData.second = timeStr.substring(6, 8).toInt();
+  // V3 só muda quando o segundo vira (ponteiros) ou o BPM muda; o mostrador
+  // e a hora em texto só quando o minuto vira
+  static uint32_t seenSecond = 0;
+  static uint32_t seenMinute = 0;
+  static int lastHeart = -1;
+  SensorData sd = getSensorData();
+  bool secondChanged = clockChanged(seenSecond, clockSecondSeq);
+  if (!firstRender && !secondChanged && sd.bpm == lastHeart) {
+    return;
+  }
+  lastHeart = sd.bpm;
 
-  // Debug: mostrar valores extraídos
-  //Serial.printf("DEBUG - timeStr: '%s', hour: %d, minute: %d, second: %d\n",
-  //              timeStr.c_str(), wfData.hour, wfData.minute, wfData.second);
+  WatchFaceV3Data wfData = {};
+  wfData.hour = clockNow.hour;
+  wfData.minute = clockNow.minute;
+  wfData.second = clockNow.second;
 
-  // Verificar se NTP está sincronizado
-  //Serial.printf("NTP sincronizado: %s\n", ntpSincronizado ? "SIM" : "NAO");
-  
   // Dados dos sensores
-  SensorData sd = getSensorData();
   wfData.heart = sd.bpm > 0 ? sd.bpm : 0;
   wfData.heartProgress = sd.bpm > 0 ? (float)sd.bpm / 200.0f : 0.0f;
   wfData.sys = 120; // Fixo por enquanto
   wfData.dia = 80;
   wfData.battery = 85;
-  String dateStr = getDateString();
-  wfData.date = dateStr.c_str();
-  wfData.year = getCurrentYear();
-
-  // Debug: mostrar data
-  //Serial.printf("DEBUG - date: '%s', year: %d\n", dateStr.c_str(), wfData.year);
+  wfData.date = clockNow.dateStr;
+  wfData.year = clockNow.year;
+  wfData.minuteChanged = clockChanged(seenMinute, clockMinuteSeq);
   
   // Desenha watchface
-  // Static() apenas na primeira renderização
+  // Static() apenas na primeira renderização (fundo vem do cache)
+  faceCacheFrameBegin();
   if (firstRender) {
     drawWatchFaceV3Static(tft, wfData, true);
   }
   // Update() sempre (relógio, batimentos, etc)
   drawWatchFaceV3Update(tft, wfData);
+  faceCacheFrameEnd();
 }
 
+// Tela de sensores: widgets retidos, só repinta o valor que mudou
+enum {
+  SW_TITLE, SW_MPU_LABEL, SW_HR_LABEL,
+  SW_ACC, SW_TEMP, SW_STEPS, SW_BPM, SW_SPO2, SW_BPM_ARC,
+  SW_COUNT
+};
+
+static Widget sensorsWidgets[SW_COUNT] = {
+  widgetLabel(120, 30, 2, MC_DATUM, COLOR_TEXT, COLOR_BG, "Sensores"),
+  widgetLabel(120, 60, 2, TC_DATUM, COLOR_CYAN, COLOR_BG, "MPU6050"),
+  widgetLabel(120, 130, 2, TC_DATUM, COLOR_HEART, COLOR_BG, "Heart Rate"),
+  widgetValue(120, 85, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 105, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 118, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 155, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 175, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  // Batimentos de 40 a 180 bpm na borda de baixo, da esquerda para a direita
+  widgetArc(120, 120, 110, 8, 135, 45, COLOR_HEART, COLOR_FRAME, COLOR_BG),
+};
+
 void renderSensorsScreen(bool firstRender) {
-  // Limpa tela apenas na primeira renderização
   if (firstRender) {
     tft.fillScreen(COLOR_BG);
-
-    // Título (estático) - centralizado no topo
-    tft.setTextColor(COLOR_TEXT, COLOR_BG);
-    tft.setTextDatum(MC_DATUM);
-    tft.setTextFont(2);
-    tft.drawString("Sensores", 120, 30);
-
-    // Labels estáticos - centralizados
-    tft.setTextColor(COLOR_CYAN);
-    tft.setTextDatum(TC_DATUM); // Topo centralizado
-    tft.drawString("MPU6050", 120, 60);
-
-    tft.setTextColor(COLOR_HEART);
-    tft.setTextDatum(TC_DATUM); // Topo centralizado
-    tft.drawString("Heart Rate", 120, 130);
+    widgetsInvalidate(sensorsWidgets, SW_COUNT);
   }
 
-  // Dados dinâmicos - centralizados
   SensorData sd = getSensorData();
-
-  // MPU6050 - valores centralizados
-  tft.setTextColor(COLOR_TEXT, COLOR_BG);
-  tft.setTextDatum(MC_DATUM); // Centro completo
-  tft.setTextFont(1);
-  tft.drawString(String("Acc: ") + String(sd.accelX, 1) + ", " + String(sd.accelY, 1), 120, 85);
-  tft.drawString(String("Temp: ") + String(sd.tempMPU, 1) + "C", 120, 105);
-
-  // MAX30102 - valores centralizados
-  tft.setTextDatum(MC_DATUM); // Centro completo
+  widgetSetTextf(sensorsWidgets[SW_ACC], "Acc: %.1f, %.1f", sd.accelX, sd.accelY);
+  widgetSetTextf(sensorsWidgets[SW_TEMP], "Temp: %.1fC", sd.tempMPU);
+  widgetSetTextf(sensorsWidgets[SW_STEPS], "Passos: %u  %dkcal", (unsigned)getStepsToday(), getKcalToday());
   if (sd.bpm > 0) {
-    tft.drawString(String("BPM: ") + String(sd.bpm), 120, 155);
-    tft.drawString(String("SpO2: ") + String(sd.spo2) + "%", 120, 175);
+    widgetSetTextf(sensorsWidgets[SW_BPM], "BPM: %d", sd.bpm);
+    widgetSetTextf(sensorsWidgets[SW_SPO2], "SpO2: %d%%", sd.spo2);
+    widgetSetProgress(sensorsWidgets[SW_BPM_ARC], (sd.bpm - 40) / 140.0f);
   } else {
-    tft.drawString("Dedo nao detectado", 120, 155);
+    widgetSetText(sensorsWidgets[SW_BPM], "Dedo nao detectado");
+    widgetSetText(sensorsWidgets[SW_SPO2], "");
+    widgetSetProgress(sensorsWidgets[SW_BPM_ARC], 0);
   }
+
+  widgetsFlush(tft, sensorsWidgets, SW_COUNT);
 }
 
 void renderCalculatorScreen(bool firstRender) {
@@ -297,6 +426,18 @@ void renderCalculatorScreen(bool firstRender) {
 }
 
 void renderNotificationScreen(bool firstRender) {
+  // Retido: só redesenha quando a notificação exibida, a lista ou a rolagem muda
+  static int drawnIndex = -1;
+  static uint32_t drawnRev = UINT32_MAX;
+  static int drawnScroll = -1;
+  if (!firstRender && drawnIndex == currentNotificationIndex && drawnRev == notificationsRev &&
+      drawnScroll == notificationScroll) {
+    return;
+  }
+  if (drawnIndex != currentNotificationIndex) notificationScroll = 0;
+  drawnIndex = currentNotificationIndex;
+  drawnRev = notificationsRev;
+
   // Só limpa a tela na primeira renderização ou quando necessário
   if (firstRender) {
     tft.fillScreen(COLOR_BG);
@@ -306,12 +447,17 @@ void renderNotificationScreen(bool firstRender) {
     tft.setTextDatum(MC_DATUM);
     tft.setTextFont(2);
     tft.drawString("Notificacoes", 120, 30);
+
+    if (screenCircle.r == 0) {
+      textCircleInit(screenCircle, 120, 120, 114);
+      textLayoutInit(notificationLayout, &screenCircle, 2, 1, TEXT_ALIGN_CENTER, 0, 240, 68, 192);
+    }
   }
 
   // Limpa apenas a área de conteúdo dinâmico (evita piscar)
-  // Área do timestamp e mensagem: Y=50-180, X=20-220
+  // Timestamp, mensagem e indicador: Y=45-210
   if (!firstRender) {
-    tft.fillRect(20, 45, 200, 140, COLOR_BG);
+    tft.fillRect(0, 45, 240, 165, COLOR_BG);
   }
 
   // Se não há notificações
@@ -325,117 +471,94 @@ void renderNotificationScreen(bool firstRender) {
 
   // Mostra a notificação atual
   if (notificationCount > 0 && currentNotificationIndex < notificationCount) {
-    Notification &notif = notifications[currentNotificationIndex];
-
     // Timestamp centralizado
     tft.setTextColor(COLOR_SUB);
     tft.setTextDatum(MC_DATUM);
     tft.setTextFont(1);
-    tft.drawString(notif.timestamp, 120, 55);
-
-    // Mensagem centralizada (quebrada em linhas se necessário)
-    tft.setTextColor(COLOR_TEXT);
-    tft.setTextFont(2);
-
-    String msg = notif.message;
-    int maxCharsPerLine = 18; // Menos caracteres por linha para tela redonda
-    int start = 0;
-    int lineCount = 0;
-
-    // Conta quantas linhas teremos para centralizar verticalmente
-    int tempStart = 0;
-    while (tempStart < msg.length()) {
-      int tempEnd = tempStart + maxCharsPerLine;
-      if (tempEnd > msg.length()) tempEnd = msg.length();
-
-      if (tempEnd < msg.length() && msg.charAt(tempEnd) != ' ') {
-        int spacePos = msg.lastIndexOf(' ', tempEnd);
-        if (spacePos > tempStart) tempEnd = spacePos;
-      }
-
-      lineCount++;
-      tempStart = tempEnd;
-      while (tempStart < msg.length() && msg.charAt(tempStart) == ' ') tempStart++;
-    }
-
-    // Centraliza verticalmente as linhas de texto
-    int totalTextHeight = lineCount * 20; // 20 pixels por linha
-    int centerY = 120; // Centro vertical da tela
-    int startY = centerY - (totalTextHeight / 2) + 10;
-
-    // Agora desenha as linhas centralizadas
-    start = 0;
-    int currentLine = 0;
-
-    while (start < msg.length() && currentLine < lineCount) {
-      int end = start + maxCharsPerLine;
-      if (end > msg.length()) end = msg.length();
-
-      // Procura por quebra de palavra se possível
-      if (end < msg.length() && msg.charAt(end) != ' ') {
-        int spacePos = msg.lastIndexOf(' ', end);
-        if (spacePos > start) end = spacePos;
-      }
-
-      String line = msg.substring(start, end);
-      line.trim(); // Remove espaços extras
-
-      // Centraliza horizontalmente cada linha
-      tft.setTextDatum(MC_DATUM);
-      tft.drawString(line, 120, startY + (currentLine * 20));
-
-      currentLine++;
-      start = end;
-
-      // Pula espaços no início da próxima linha
-      while (start < msg.length() && msg.charAt(start) == ' ') start++;
-    }
+    tft.drawString(notifyTime(currentNotificationIndex), 120, 55);
+
+    // Mensagem: linhas pela corda do círculo (centralizada se couber,
+    // senão rola de linha em linha)
+    char text[TEXT_LAYOUT_CHARS];
+    textToDisplay(notifyText(currentNotificationIndex), text, sizeof(text));
+    textLayoutSet(tft, notificationLayout, text);
+    int maxScroll = textLayoutMaxScroll(notificationLayout);
+    if (notificationScroll > maxScroll) notificationScroll = maxScroll;
+    drawnScroll = notificationScroll;
+    textLayoutDraw(tft, notificationLayout, COLOR_TEXT, COLOR_BG, notificationScroll);
 
     // Indicador de navegação se houver múltiplas notificações
+    tft.setTextColor(COLOR_ACCENT);
+    tft.setTextDatum(MC_DATUM);
+    tft.setTextFont(1);
     if (notificationCount > 1) {
-      tft.setTextColor(COLOR_ACCENT);
-      tft.setTextDatum(MC_DATUM);
-      tft.setTextFont(1);
       tft.drawString(String(currentNotificationIndex + 1) + "/" + String(notificationCount), 120, 200);
     }
+    if (maxScroll > 0) {
+      // Setas de rolagem (há texto acima/abaixo)
+      if (notificationScroll > 0) tft.fillTriangle(150, 62, 146, 66, 154, 66, COLOR_ACCENT);
+      if (notificationScroll < maxScroll) tft.fillTriangle(146, 196, 154, 196, 150, 200, COLOR_ACCENT);
+    }
 
     // Marca como lida
-    notif.isRead = true;
+    notifyMarkRead(currentNotificationIndex);
   }
 }
 
+// Tela de status: uptime muda a cada segundo, o resto raramente
+enum {
+  STW_TITLE, STW_ICON_WIFI, STW_ICON_MIC, STW_ID, STW_IP, STW_UPTIME, STW_HEAP, STW_WIFI,
+  STW_AUDIO, STW_VAD, STW_WSQ, STW_FRAME,
+  STW_COUNT
+};
+
+static Widget statusWidgets[STW_COUNT] = {
+  widgetLabel(120, 20, 2, MC_DATUM, COLOR_TEXT, COLOR_BG, "Status Sistema"),
+  widgetIcon(106, 32, ICON_WIFI_ICON_BITS, COLOR_ACCENT, COLOR_BG),
+  widgetIcon(126, 32, ICON_MIC, COLOR_RED, COLOR_BG),
+  widgetValue(120, 50, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 75, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 100, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 125, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 150, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 175, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 190, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 205, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+  widgetValue(120, 220, 1, MC_DATUM, COLOR_TEXT, COLOR_BG),
+};
+
 void renderStatusScreen(bool firstRender) {
-  // Limpa tela apenas na primeira renderização
   if (firstRender) {
     tft.fillScreen(COLOR_BG);
-
-    // Título (estático) - centralizado no topo
-    tft.setTextColor(COLOR_TEXT, COLOR_BG);
-    tft.setTextDatum(MC_DATUM);
-    tft.setTextFont(2);
-    tft.drawString("Status Sistema", 120, 20);
+    widgetsInvalidate(statusWidgets, STW_COUNT);
   }
 
-  // Valores dinâmicos - linhas centralizadas verticalmente
-  tft.setTextDatum(MC_DATUM); // Centro completo para todas as linhas
-  tft.setTextFont(1);
-  tft.setTextColor(COLOR_TEXT, COLOR_BG);
-
-  // Formatar e centralizar cada linha
-  String idStr = String("ID: ") + randomId;
-  tft.drawString(idStr, 120, 50);
-
-  String ipStr = String("IP: ") + WiFi.localIP().toString();
-  tft.drawString(ipStr, 120, 75);
-
-  String uptimeStr = String("Uptime: ") + String(millis() / 1000) + "s";
-  tft.drawString(uptimeStr, 120, 100);
+  widgetSetTextf(statusWidgets[STW_ID], "ID: %s", randomId.c_str());
+  IPAddress ip = WiFi.localIP();
+  widgetSetTextf(statusWidgets[STW_IP], "IP: %u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+  widgetSetTextf(statusWidgets[STW_UPTIME], "Uptime: %lus", millis() / 1000);
+  widgetSetTextf(statusWidgets[STW_HEAP], "Memoria: %u bytes", (unsigned)ESP.getFreeHeap());
+  widgetSetText(statusWidgets[STW_WIFI], isWiFiConnected() ? "WiFi: Conectado" : "WiFi: Desconectado");
+  widgetSetVisible(statusWidgets[STW_ICON_WIFI], isWiFiConnected());
+  widgetSetVisible(statusWidgets[STW_ICON_MIC], isAudioActive());
+
+  if (isAudioActive()) {
+    widgetSetTextf(statusWidgets[STW_AUDIO], "Audio: %uHz  perdidos: %u",
+                   (unsigned)getAudioSampleRate(), (unsigned)getAudioDroppedBuffers());
+    widgetSetTextf(statusWidgets[STW_VAD], "VAD: %u env / %u sil",
+                   (unsigned)audioChunksSent, (unsigned)audioChunksSuppressed);
+  } else {
+    widgetSetText(statusWidgets[STW_AUDIO], "");
+    widgetSetText(statusWidgets[STW_VAD], "");
+  }
 
-  String memoriaStr = String("Memoria: ") + String(ESP.getFreeHeap()) + " bytes";
-  tft.drawString(memoriaStr, 120, 125);
+  // Fila de saída WebSocket: profundidade, latência média e tempo de envio
+  widgetSetTextf(statusWidgets[STW_WSQ], "Fila WS: %u (%uB) %ums %uus",
+                 (unsigned)wsqDepth(), (unsigned)wsqBytes(), (unsigned)wsqLatencyMs, (unsigned)wsqSendMicros);
+  widgetSetTextf(statusWidgets[STW_FRAME], "Quadro: %uus max %uus",
+                 (unsigned)displayFrameMicros, (unsigned)displayFrameMaxMicros);
 
-  String wifiStr = String("WiFi: ") + (isWiFiConnected() ? "Conectado" : "Desconectado");
-  tft.drawString(wifiStr, 120, 150);
+  widgetsFlush(tft, statusWidgets, STW_COUNT);
 }
 
 void showMessage(String msg) {
@@ -449,35 +572,38 @@ void showMessage(String msg) {
 
 // ===== FUNÇÕES DE NOTIFICAÇÕES =====
 
-void addNotification(String message) {
-  if (notificationCount < MAX_NOTIFICATIONS) {
-    notifications[notificationCount].message = message;
-    notifications[notificationCount].timestamp = getTimeString();
-    notifications[notificationCount].isRead = false;
-    notificationCount++;
-  } else {
-    // Remove a mais antiga e adiciona a nova
-    for (int i = 0; i < MAX_NOTIFICATIONS - 1; i++) {
-      notifications[i] = notifications[i + 1];
-    }
-    notifications[MAX_NOTIFICATIONS - 1].message = message;
-    notifications[MAX_NOTIFICATIONS - 1].timestamp = getTimeString();
-    notifications[MAX_NOTIFICATIONS - 1].isRead = false;
+void addNotification(String message, uint32_t receivedUs) {
+  uint16_t dropped = notifyStoreAdd(message.c_str(), message.length(), clockNow.timeStr);
+  notificationCount = notifyCount();
+  // Mantém a mesma notificação na tela se as antigas saíram do anel
+  currentNotificationIndex = currentNotificationIndex >= dropped ? currentNotificationIndex - dropped : 0;
+  notificationsRev++;
+  // Na tela de notificações a própria lista já mostra a nova
+  if (currentScreen != SCREEN_NOTIFICATIONS) {
+    notifyOverlayShow(message.c_str(), clockNow.timeStr, receivedUs ? receivedUs : micros());
   }
 }
 
 void clearNotifications() {
+  notifyStoreClear();
   notificationCount = 0;
   currentNotificationIndex = 0;
+  notificationScroll = 0;
+  notificationsRev++;
+}
+
+// Rola a mensagem exibida em linhas (limitada ao layout em renderNotificationScreen)
+void scrollNotification(int delta) {
+  int next = notificationScroll + delta;
+  if (next < 0) next = 0;
+  if (next > textLayoutMaxScroll(notificationLayout)) next = textLayoutMaxScroll(notificationLayout);
+  if (next == notificationScroll) return;
+  notificationScroll = next;
+  displayInvalidate();
 }
 
 bool hasUnreadNotifications() {
-  for (int i = 0; i < notificationCount; i++) {
-    if (!notifications[i].isRead) {
-      return true;
-    }
-  }
-  return false;
+  return notifyUnread() > 0;
 }
 
 void renderQrcodeScreen(bool firstRender) {
@@ -0,0 +1,280 @@
+#ifndef FACE_CACHE_H
+#define FACE_CACHE_H
+
+#include <TFT_eSPI.h>
+#include <esp_heap_caps.h>
+#include "config.h"
+#include "display_clip.h"
+#include "flash_fs.h"
+
+// ==========================================
+// CACHE DO FUNDO DO WATCHFACE - PSRAM ou flash
+// ==========================================
+// A camada estática de cada face (fundo, trilhas, ícones, moldura da bateria)
+// é desenhada uma vez, em faixas de FACE_CACHE_BAND_ROWS linhas num sprite
+// pequeno, e guardada como imagem RGB565 na ordem de bytes do display:
+//   - PSRAM presente: 240x240 em PSRAM, refeita ao trocar de face;
+//   - Sem PSRAM: um arquivo por face em LittleFS, marcado com a data da
+//     compilação (só é refeito depois de gravar um firmware novo).
+// faceCacheRestore() devolve um retângulo ao display por DMA, em blocos de
+// linhas com dois buffers alternados (monta um enquanto o outro é enviado).
+// Sem cache, redesenha a camada estática recortada ao retângulo.
+// Métrica: área restaurada do cache por quadro.
+
+#define FACE_CACHE_WIDTH 240
+#define FACE_CACHE_HEIGHT 240
+#define FACE_CACHE_MAGIC 0x43424657UL   // "WFBC"
+
+enum FaceCacheStorage : uint8_t {
+  FACE_CACHE_NONE,
+  FACE_CACHE_PSRAM,
+  FACE_CACHE_FLASH
+};
+
+struct FaceRect {
+  int16_t x, y, w, h;
+};
+
+struct FaceCacheHeader {
+  uint32_t magic;
+  char stamp[24];      // __DATE__ " " __TIME__ do firmware que gerou
+};
+
+// Desenha a camada estática em coordenadas de tela. Deve pintar o fundo com
+// fillRect(0, 0, 240, 240): fillScreen só cobriria a primeira faixa.
+typedef void (*FaceStaticDraw)(TFT_eSPI &gfx);
+
+static const char FACE_CACHE_STAMP[] = __DATE__ " " __TIME__;
+
+static FaceCacheStorage faceCacheStorage = FACE_CACHE_NONE;
+static uint16_t *faceCachePixels = nullptr;     // PSRAM
+static File faceCacheFile;                       // flash (aberto para leitura)
+static int faceCacheFace = -1;                   // face guardada
+static bool faceCacheValid = false;
+static FaceStaticDraw faceCacheDraw = nullptr;   // para o caminho sem cache
+
+static uint16_t *faceCacheDmaBuf[2] = { nullptr, nullptr };
+static uint16_t faceCacheRowBuf[FACE_CACHE_WIDTH];   // sem DMA: uma linha por vez
+static bool faceCacheDma = false;
+
+// Métricas
+uint32_t faceCacheHitArea = 0;      // pixels restaurados do cache no quadro
+uint32_t faceCacheMissArea = 0;     // pixels redesenhados por falta de cache
+uint32_t faceCacheAvgHitArea = 0;   // média móvel por quadro
+uint32_t faceCacheFrames = 0;
+uint32_t faceCacheBuildMs = 0;
+
+// ---------- Retângulos ----------
+static inline bool faceRectEmpty(const FaceRect &r) {
+  return r.w <= 0 || r.h <= 0;
+}
+
+static FaceRect faceRectUnion(const FaceRect &a, const FaceRect &b) {
+  if (faceRectEmpty(a)) return b;
+  if (faceRectEmpty(b)) return a;
+  int16_t x0 = min(a.x, b.x), y0 = min(a.y, b.y);
+  int16_t x1 = max(a.x + a.w, b.x + b.w), y1 = max(a.y + a.h, b.y + b.h);
+  FaceRect r = { x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+  return r;
+}
+
+static bool faceRectIntersects(const FaceRect &a, const FaceRect &b) {
+  if (faceRectEmpty(a) || faceRectEmpty(b)) return false;
+  return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static FaceRect faceRectClip(FaceRect r) {
+  if (r.x < 0) { r.w += r.x; r.x = 0; }
+  if (r.y < 0) { r.h += r.y; r.y = 0; }
+  if (r.x + r.w > FACE_CACHE_WIDTH) r.w = FACE_CACHE_WIDTH - r.x;
+  if (r.y + r.h > FACE_CACHE_HEIGHT) r.h = FACE_CACHE_HEIGHT - r.y;
+  return r;
+}
+
+const char *faceCacheStorageName() {
+  switch (faceCacheStorage) {
+    case FACE_CACHE_PSRAM: return "psram";
+    case FACE_CACHE_FLASH: return "flash";
+    default: return "nenhum";
+  }
+}
+
+// ---------- Preparação (uma vez) ----------
+static void faceCacheSetup(TFT_eSPI &tft) {
+  static bool done = false;
+  if (done) return;
+  done = true;
+
+  for (int i = 0; i < 2; i++) {
+    faceCacheDmaBuf[i] = (uint16_t *)heap_caps_malloc(FACE_CACHE_DMA_PIXELS * 2, MALLOC_CAP_DMA);
+  }
+  faceCacheDma = faceCacheDmaBuf[0] && faceCacheDmaBuf[1] && tft.initDMA();
+
+  if (psramFound()) {
+    faceCachePixels = (uint16_t *)ps_malloc(FACE_CACHE_WIDTH * FACE_CACHE_HEIGHT * 2);
+    if (faceCachePixels) {
+      faceCacheStorage = FACE_CACHE_PSRAM;
+      return;
+    }
+  }
+  if (flashFsMount()) faceCacheStorage = FACE_CACHE_FLASH;
+}
+
+static void faceCachePath(char *buf, size_t n, int face) {
+  snprintf(buf, n, "/wfbg%d.raw", face);
+}
+
+// Arquivo existente gerado por este firmware?
+static bool faceCacheOpenExisting(const char *path) {
+  File f = LittleFS.open(path, FILE_READ);
+  if (!f) return false;
+  FaceCacheHeader h;
+  bool ok = f.read((uint8_t *)&h, sizeof(h)) == sizeof(h) &&
+            h.magic == FACE_CACHE_MAGIC &&
+            strncmp(h.stamp, FACE_CACHE_STAMP, sizeof(h.stamp)) == 0 &&
+            f.size() == sizeof(h) + FACE_CACHE_WIDTH * FACE_CACHE_HEIGHT * 2;
+  if (!ok) {
+    f.close();
+    return false;
+  }
+  faceCacheFile = f;
+  return true;
+}
+
+// Desenha a camada estática em faixas e guarda no armazenamento escolhido
+static bool faceCacheBuild(TFT_eSPI &tft, int face, FaceStaticDraw drawStatic) {
+  uint32_t t0 = millis();
+  char path[16];
+  faceCachePath(path, sizeof(path), face);
+
+  if (faceCacheStorage == FACE_CACHE_FLASH) {
+    if (faceCacheFile) faceCacheFile.close();
+    if (faceCacheOpenExisting(path)) {
+      Serial.printf("Cache do fundo (face %d): reaproveitado de %s\n", face, path);
+      return true;
+    }
+    faceCacheFile = LittleFS.open(path, FILE_WRITE);
+    if (!faceCacheFile) return false;
+    FaceCacheHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = FACE_CACHE_MAGIC;
+    strncpy(h.stamp, FACE_CACHE_STAMP, sizeof(h.stamp) - 1);
+    faceCacheFile.write((const uint8_t *)&h, sizeof(h));
+  }
+
+  TFT_eSprite band(&tft);
+  band.setColorDepth(16);
+  bool ok = band.createSprite(FACE_CACHE_WIDTH, FACE_CACHE_BAND_ROWS) != nullptr;
+
+  for (int y0 = 0; ok && y0 < FACE_CACHE_HEIGHT; y0 += FACE_CACHE_BAND_ROWS) {
+    int rows = min(FACE_CACHE_BAND_ROWS, FACE_CACHE_HEIGHT - y0);
+    // Viewport com origem deslocada: a face desenha em coordenadas de tela
+    band.setViewport(0, -y0, FACE_CACHE_WIDTH, FACE_CACHE_HEIGHT, true);
+    drawStatic(band);
+    band.resetViewport();
+
+    const uint16_t *src = (const uint16_t *)band.getPointer();
+    size_t bytes = (size_t)rows * FACE_CACHE_WIDTH * 2;
+    if (faceCacheStorage == FACE_CACHE_PSRAM) {
+      memcpy(faceCachePixels + y0 * FACE_CACHE_WIDTH, src, bytes);
+    } else {
+      ok = faceCacheFile.write((const uint8_t *)src, bytes) == bytes;
+    }
+  }
+  band.deleteSprite();
+
+  if (faceCacheStorage == FACE_CACHE_FLASH) {
+    faceCacheFile.close();
+    if (!ok) LittleFS.remove(path);
+    else ok = faceCacheOpenExisting(path);
+  }
+
+  faceCacheBuildMs = millis() - t0;
+  Serial.printf("Cache do fundo (face %d): %s, %s em %lums\n", face, faceCacheStorageName(),
+                ok ? "gerado" : "falhou", (unsigned long)faceCacheBuildMs);
+  return ok;
+}
+
+// Garante o cache da face (gera na primeira vez ou ao trocar de face)
+bool faceCacheEnsure(TFT_eSPI &tft, int face, FaceStaticDraw drawStatic) {
+  faceCacheSetup(tft);
+  faceCacheDraw = drawStatic;
+  if (face == faceCacheFace) return faceCacheValid;
+
+  faceCacheFace = face;
+  faceCacheValid = faceCacheStorage != FACE_CACHE_NONE && faceCacheBuild(tft, face, drawStatic);
+  return faceCacheValid;
+}
+
+// Copia `rows` linhas do retângulo (x, y, w) do cache para buf
+static void faceCacheGather(uint16_t *buf, int x, int y, int w, int rows) {
+  if (faceCacheStorage == FACE_CACHE_PSRAM) {
+    for (int i = 0; i < rows; i++) {
+      memcpy(buf + i * w, faceCachePixels + (y + i) * FACE_CACHE_WIDTH + x, w * 2);
+    }
+    return;
+  }
+  size_t base = sizeof(FaceCacheHeader);
+  if (x == 0 && w == FACE_CACHE_WIDTH) {
+    faceCacheFile.seek(base + (size_t)y * FACE_CACHE_WIDTH * 2);
+    faceCacheFile.read((uint8_t *)buf, (size_t)rows * w * 2);
+    return;
+  }
+  for (int i = 0; i < rows; i++) {
+    faceCacheFile.seek(base + ((size_t)(y + i) * FACE_CACHE_WIDTH + x) * 2);
+    faceCacheFile.read((uint8_t *)(buf + i * w), w * 2);
+  }
+}
+
+// Restaura um retângulo do fundo
+void faceCacheRestore(TFT_eSPI &tft, FaceRect r) {
+  r = faceRectClip(r);
+  if (faceRectEmpty(r)) return;
+
+  if (!faceCacheValid) {
+    // Sem cache: redesenha a camada estática só dentro do retângulo
+    if (faceCacheDraw) {
+      displayClipPush(tft, r.x, r.y, r.w, r.h);
+      faceCacheDraw(tft);
+      displayClipPop(tft);
+    }
+    faceCacheMissArea += (uint32_t)r.w * r.h;
+    return;
+  }
+
+  bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(false);   // cache já está na ordem de bytes do display
+  tft.startWrite();
+  int chunkRows = faceCacheDma ? FACE_CACHE_DMA_PIXELS / r.w : 1;
+  int k = 0;
+  for (int y = r.y; y < r.y + r.h; y += chunkRows) {
+    int rows = min(chunkRows, r.y + r.h - y);
+    uint16_t *buf = faceCacheDma ? faceCacheDmaBuf[k] : faceCacheRowBuf;
+    faceCacheGather(buf, r.x, y, r.w, rows);
+    if (faceCacheDma) {
+      // pushImageDMA espera o envio anterior: o buffer k já está livre
+      tft.pushImageDMA(r.x, y, r.w, rows, buf);
+      k ^= 1;
+    } else {
+      tft.pushImage(r.x, y, r.w, rows, buf);
+    }
+  }
+  if (faceCacheDma) tft.dmaWait();
+  tft.endWrite();
+  tft.setSwapBytes(swap);
+
+  faceCacheHitArea += (uint32_t)r.w * r.h;
+}
+
+// Métrica por quadro: chamar antes e depois de desenhar a face
+void faceCacheFrameBegin() {
+  faceCacheHitArea = 0;
+  faceCacheMissArea = 0;
+}
+
+void faceCacheFrameEnd() {
+  faceCacheAvgHitArea = faceCacheFrames ? (faceCacheAvgHitArea * 7 + faceCacheHitArea) / 8 : faceCacheHitArea;
+  faceCacheFrames++;
+}
+
+#endif // FACE_CACHE_H
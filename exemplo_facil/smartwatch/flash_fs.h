@@ -0,0 +1,26 @@
+#ifndef FLASH_FS_H
+#define FLASH_FS_H
+
+#include <FS.h>
+#include <LittleFS.h>
+
+// ==========================================
+// LITTLEFS COMPARTILHADO
+// ==========================================
+// Um único ponto de montagem para quem grava em flash (clipes de áudio,
+// cache do watchface, log de notificações). A primeira chamada monta
+// (formatando se a partição estiver vazia ou corrompida); as seguintes só
+// devolvem o resultado. Se falhar, a próxima chamada tenta de novo.
+
+static bool flashFsOk = false;
+
+static bool flashFsMount() {
+  if (!flashFsOk) flashFsOk = LittleFS.begin(true);
+  return flashFsOk;
+}
+
+static inline bool flashFsMounted() {
+  return flashFsOk;
+}
+
+#endif // FLASH_FS_H
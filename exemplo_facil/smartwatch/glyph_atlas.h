@@ -0,0 +1,232 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <TFT_eSPI.h>
+#include "config.h"
+
+// ==========================================
+// ATLAS DE GLIFOS - dígitos grandes com antisserrilhado
+// ==========================================
+// Os glifos são rasterizados no host (tools/glyph_pack.py) em alfa de 4 bits
+// por pixel, na célula inteira do caractere. Para desenhar, o alfa vira
+// RGB565 por uma tabela de 16 cores misturadas entre frente e fundo (o fundo
+// é conhecido: a célula é enviada opaca, sem limpar antes). Os glifos já
+// misturados ficam num cache pequeno (GLYPH_CACHE_SLOTS, LRU).
+// GlyphLine guarda o texto na tela e só reenvia as posições que mudaram,
+// ex.: de 12:59 para 13:00 saem 3 glifos; de 13:00 para 13:01, 1.
+
+struct GlyphInfo {
+  char ch;
+  uint8_t w;            // avanço = largura da célula (par)
+  uint16_t offset;      // bytes em alpha
+};
+
+struct GlyphFont {
+  uint8_t height;
+  uint8_t count;
+  const GlyphInfo *glyphs;
+  const uint8_t *alpha; // 2 pixels por byte, nibble alto primeiro
+};
+
+#include "glyphs_time.h"
+
+#define GLYPH_LINE_MAX 12
+
+// Métricas
+uint32_t glyphsDrawn = 0;
+uint32_t glyphCacheHits = 0;
+uint32_t glyphCacheMisses = 0;
+
+// ---------- Mistura ----------
+struct GlyphLut {
+  uint16_t fg, bg;
+  uint16_t c[16];       // alfa 0..15 -> cor
+};
+
+static void glyphLutBuild(GlyphLut &lut, uint16_t fg, uint16_t bg) {
+  lut.fg = fg;
+  lut.bg = bg;
+  int fr = fg >> 11, fgr = (fg >> 5) & 63, fb = fg & 31;
+  int br = bg >> 11, bgr = (bg >> 5) & 63, bb = bg & 31;
+  for (int a = 0; a < 16; a++) {
+    int r = (fr * a + br * (15 - a) + 7) / 15;
+    int g = (fgr * a + bgr * (15 - a) + 7) / 15;
+    int b = (fb * a + bb * (15 - a) + 7) / 15;
+    lut.c[a] = (r << 11) | (g << 5) | b;
+  }
+}
+
+static const GlyphLut &glyphLut(uint16_t fg, uint16_t bg) {
+  static GlyphLut lut = { 0, 0, { 0 } };
+  static bool valid = false;
+  if (!valid || lut.fg != fg || lut.bg != bg) {
+    glyphLutBuild(lut, fg, bg);
+    valid = true;
+  }
+  return lut;
+}
+
+// ---------- Busca ----------
+static bool glyphFind(const GlyphFont &f, char ch, GlyphInfo &out) {
+  for (uint8_t i = 0; i < f.count; i++) {
+    memcpy_P(&out, &f.glyphs[i], sizeof(out));
+    if (out.ch == ch) return true;
+  }
+  return false;
+}
+
+// Caractere ausente no atlas vira espaço (se houver)
+static bool glyphFindOrSpace(const GlyphFont &f, char ch, GlyphInfo &out) {
+  return glyphFind(f, ch, out) || glyphFind(f, ' ', out);
+}
+
+static int16_t glyphTextWidth(const GlyphFont &f, const char *text) {
+  int16_t w = 0;
+  GlyphInfo g;
+  for (const char *p = text; *p; p++) {
+    if (glyphFindOrSpace(f, *p, g)) w += g.w;
+  }
+  return w;
+}
+
+static void glyphDecode(const GlyphFont &f, const GlyphInfo &g, const GlyphLut &lut,
+                        uint16_t *out, uint32_t first, uint32_t count) {
+  const uint8_t *src = f.alpha + g.offset;
+  for (uint32_t i = first; i < first + count; i++) {
+    uint8_t b = pgm_read_byte(src + (i >> 1));
+    *out++ = lut.c[(i & 1) ? (b & 0x0F) : (b >> 4)];
+  }
+}
+
+// ---------- Cache de glifos misturados ----------
+struct GlyphCacheSlot {
+  const GlyphFont *font;
+  char ch;
+  uint16_t fg, bg;
+  uint32_t lastUse;
+  uint16_t capacity;    // pixels alocados
+  uint16_t *px;
+};
+
+static GlyphCacheSlot glyphCache[GLYPH_CACHE_SLOTS];
+static uint32_t glyphCacheClock = 0;
+
+// Célula pronta para pushImage; nullptr se não houver memória
+static const uint16_t *glyphTile(const GlyphFont &f, const GlyphInfo &g, uint16_t fg, uint16_t bg) {
+  glyphCacheClock++;
+  GlyphCacheSlot *victim = &glyphCache[0];
+  for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+    GlyphCacheSlot &s = glyphCache[i];
+    if (s.px && s.font == &f && s.ch == g.ch && s.fg == fg && s.bg == bg) {
+      s.lastUse = glyphCacheClock;
+      glyphCacheHits++;
+      return s.px;
+    }
+    if (s.lastUse < victim->lastUse) victim = &s;
+  }
+  glyphCacheMisses++;
+
+  uint16_t need = (uint16_t)g.w * f.height;
+  if (victim->capacity < need) {
+    free(victim->px);
+    victim->px = (uint16_t *)(psramFound() ? ps_malloc(need * 2) : malloc(need * 2));
+    victim->capacity = victim->px ? need : 0;
+    if (!victim->px) {
+      victim->lastUse = 0;
+      return nullptr;
+    }
+  }
+  glyphDecode(f, g, glyphLut(fg, bg), victim->px, 0, need);
+  victim->font = &f;
+  victim->ch = g.ch;
+  victim->fg = fg;
+  victim->bg = bg;
+  victim->lastUse = glyphCacheClock;
+  return victim->px;
+}
+
+// Desenha um glifo com canto superior esquerdo em (x, y); retorna o avanço
+static int16_t glyphDraw(TFT_eSPI &tft, const GlyphFont &f, char ch, int x, int y,
+                         uint16_t fg, uint16_t bg) {
+  GlyphInfo g;
+  if (!glyphFindOrSpace(f, ch, g)) return 0;
+
+  bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(true);   // células em RGB565 nativo
+  const uint16_t *tile = glyphTile(f, g, fg, bg);
+  if (tile) {
+    tft.pushImage(x, y, g.w, f.height, tile);
+  } else {
+    // Sem memória para o cache: linha a linha
+    uint16_t row[64];
+    const GlyphLut &lut = glyphLut(fg, bg);
+    for (int r = 0; r < f.height; r++) {
+      for (int c0 = 0; c0 < g.w; c0 += 64) {
+        int n = g.w - c0 < 64 ? g.w - c0 : 64;
+        glyphDecode(f, g, lut, row, (uint32_t)r * g.w + c0, n);
+        tft.pushImage(x + c0, y + r, n, 1, row);
+      }
+    }
+  }
+  tft.setSwapBytes(swap);
+  glyphsDrawn++;
+  return g.w;
+}
+
+// ---------- Linha com estado (relógio) ----------
+struct GlyphLine {
+  const GlyphFont *font;
+  uint16_t fg, bg;
+  int16_t x, y;         // canto superior esquerdo desenhado
+  int16_t shownW;       // largura desenhada (0 = nada)
+  char shown[GLYPH_LINE_MAX];
+};
+
+static void glyphLineInit(GlyphLine &l, const GlyphFont &f, uint16_t fg, uint16_t bg) {
+  l.font = &f;
+  l.fg = fg;
+  l.bg = bg;
+  l.x = l.y = 0;
+  l.shownW = 0;
+  l.shown[0] = '\0';
+}
+
+// Desenha text em (x, y) reenviando só as posições que mudaram (force: todas).
+// Se um caractere muda de largura, tudo à direita dele é redesenhado; a
+// sobra de um texto mais curto volta à cor de fundo. Retorna glifos enviados.
+static uint8_t glyphLineDraw(TFT_eSPI &tft, GlyphLine &l, int x, int y, const char *text, bool force) {
+  const GlyphFont &f = *l.font;
+  if (x != l.x || y != l.y || l.shownW == 0) force = true;
+
+  uint8_t sent = 0;
+  int16_t cx = x;
+  bool shifted = force;
+  bool oldEnded = false;
+  size_t i = 0;
+  for (; text[i] && i < GLYPH_LINE_MAX - 1; i++) {
+    char old = oldEnded ? '\0' : l.shown[i];
+    if (!old) oldEnded = true;
+    GlyphInfo g;
+    if (!glyphFindOrSpace(f, text[i], g)) continue;
+    if (!shifted && old != text[i]) {
+      GlyphInfo og;
+      if (!old || !glyphFindOrSpace(f, old, og) || og.w != g.w) shifted = true;
+    }
+    if (shifted || old != text[i]) {
+      glyphDraw(tft, f, text[i], cx, y, l.fg, l.bg);
+      sent++;
+    }
+    cx += g.w;
+  }
+  int16_t w = cx - x;
+  if (!force && w < l.shownW) tft.fillRect(x + w, y, l.shownW - w, f.height, l.bg);
+
+  memcpy(l.shown, text, i);
+  l.shown[i] = '\0';
+  l.x = x;
+  l.y = y;
+  l.shownW = w;
+  return sent;
+}
+
+#endif // GLYPH_ATLAS_H
@@ -0,0 +1,149 @@
+#ifndef ICON_RLE_H
+#define ICON_RLE_H
+
+#include <TFT_eSPI.h>
+#include "config.h"
+#include "display_clip.h"
+
+// ==========================================
+// ÍCONES RLE + PALETA
+// ==========================================
+// Os bitmaps 1 bit de tools/icons_src.h são convertidos por
+// tools/icon_pack.py em icons_rle.h (rodar de novo ao mudar
+// tools/icons_src.h ou a lista PACKED). Cada ícone vira tokens de
+// 1 byte em ordem de varredura:
+//   0cnnnnnn  corrida da cor c: n + 1 pixels; n = 63: 64 + próximo byte
+//   1ppppppp  7 pixels literais (bit 0 = primeiro)
+// O desenho abre uma janela do tamanho do ícone e envia as cores em
+// rajadas: corridas longas com pushBlock, o resto acumulado em pushColors
+// (ICON_RLE_CHUNK pixels por vez), em vez de um drawPixel por pixel.
+
+struct IconRle {
+  uint16_t w, h;
+  uint16_t palette;     // índice em ICON_RLE_PALETTE (2 cores)
+  uint16_t bytes;       // tamanho dos tokens
+  uint32_t data;        // deslocamento em ICON_RLE_DATA
+};
+
+#include "icons_rle.h"
+
+// Tempo do último ícone desenhado (us)
+uint32_t iconDrawMicros = 0;
+
+// Leitor dos tokens: devolve corridas (cor, n); literais saem 1 pixel por vez
+struct IconRleReader {
+  const uint8_t *p;
+  uint32_t left;        // pixels que faltam
+  uint8_t lit;          // bits literais pendentes
+  uint8_t litLeft;
+
+  bool next(uint8_t &idx, uint16_t &n) {
+    if (left == 0) return false;
+    if (litLeft) {
+      idx = lit & 1;
+      lit >>= 1;
+      litLeft--;
+      n = 1;
+      left--;
+      return true;
+    }
+    uint8_t t = pgm_read_byte(p++);
+    if (t & 0x80) {
+      lit = t & 0x7F;
+      litLeft = left < 7 ? left : 7;
+      return next(idx, n);
+    }
+    idx = (t >> 6) & 1;
+    n = t & 63;
+    n = n == 63 ? 64 + pgm_read_byte(p++) : n + 1;
+    if (n > left) n = left;
+    left -= n;
+    return true;
+  }
+};
+
+static IconRleReader iconRleReader(const IconRle &ic) {
+  IconRleReader r;
+  r.p = ICON_RLE_DATA + ic.data;
+  r.left = (uint32_t)ic.w * ic.h;
+  r.lit = 0;
+  r.litLeft = 0;
+  return r;
+}
+
+static void iconRleInfo(IconId id, IconRle &ic) {
+  memcpy_P(&ic, &ICON_RLE_TABLE[id], sizeof(ic));
+}
+
+// Tamanho do ícone (para caixas de widgets)
+static void iconRleSize(IconId id, int16_t &w, int16_t &h) {
+  IconRle ic;
+  iconRleInfo(id, ic);
+  w = ic.w;
+  h = ic.h;
+}
+
+// Desenha com as cores dadas (colors[0] = fundo, colors[1] = frente)
+static void drawIconRle(TFT_eSPI &tft, IconId id, int x, int y, const uint16_t colors[2]) {
+  uint32_t t0 = micros();
+  IconRle ic;
+  iconRleInfo(id, ic);
+  IconRleReader rd = iconRleReader(ic);
+  uint8_t idx;
+  uint16_t n;
+
+  // Janela direta só com o ícone inteiro dentro do recorte (a janela de
+  // endereços não recorta); senão, linhas recortadas pela biblioteca
+  bool whole = displayClipContains(tft, x, y, ic.w, ic.h);
+
+  if (!whole) {
+    uint16_t col = 0, row = 0;
+    while (rd.next(idx, n)) {
+      while (n) {
+        uint16_t seg = ic.w - col < n ? ic.w - col : n;
+        tft.drawFastHLine(x + col, y + row, seg, colors[idx]);
+        n -= seg;
+        col += seg;
+        if (col == ic.w) { col = 0; row++; }
+      }
+    }
+    iconDrawMicros = micros() - t0;
+    return;
+  }
+
+  uint16_t buf[ICON_RLE_CHUNK];
+  uint16_t fill = 0;
+  tft.startWrite();
+  tft.setAddrWindow(x, y, ic.w, ic.h);
+  while (rd.next(idx, n)) {
+    if (n >= ICON_RLE_BLOCK_MIN) {
+      if (fill) { tft.pushColors(buf, fill, true); fill = 0; }
+      tft.pushBlock(colors[idx], n);
+      continue;
+    }
+    while (n--) {
+      buf[fill++] = colors[idx];
+      if (fill == ICON_RLE_CHUNK) { tft.pushColors(buf, fill, true); fill = 0; }
+    }
+  }
+  if (fill) tft.pushColors(buf, fill, true);
+  tft.endWrite();
+  iconDrawMicros = micros() - t0;
+}
+
+// Ícone de duas cores com frente/fundo escolhidos na hora
+static void drawIconRle(TFT_eSPI &tft, IconId id, int x, int y, uint16_t fg, uint16_t bg) {
+  const uint16_t colors[2] = { bg, fg };
+  drawIconRle(tft, id, x, y, colors);
+}
+
+// Com as cores da paleta gravada
+static void drawIconRle(TFT_eSPI &tft, IconId id, int x, int y) {
+  IconRle ic;
+  iconRleInfo(id, ic);
+  uint16_t colors[2];
+  memcpy_P(colors, &ICON_RLE_PALETTE[ic.palette], sizeof(colors));
+  drawIconRle(tft, id, x, y, colors);
+}
+
+#endif // ICON_RLE_H
@@ -0,0 +1,31 @@
+#ifndef ICONS_RLE_H
+#define ICONS_RLE_H
+
+// GERADO por tools/icon_pack.py a partir de icons_src.h - não editar à mão.
+// Formato e decodificador: icon_rle.h
+// 2 ícones: 16 bytes 1 bit -> 19 bytes RLE (+ 32 de tabela/paleta)
+
+enum IconId : uint8_t {
+  ICON_WIFI_ICON_BITS,     // 8x8, 8 -> 9 bytes
+  ICON_MIC,                // 8x8, 8 -> 10 bytes
+  ICON_RLE_COUNT
+};
+
+static const uint16_t ICON_RLE_PALETTE[] PROGMEM = {
+  0x0000, 0xFFFF,   // wifi_icon_bits
+  0x0000, 0xFFFF,   // mic
+};
+
+static const uint8_t ICON_RLE_DATA[] PROGMEM = {
+  // wifi_icon_bits
+  0xFE, 0x82, 0xF2, 0x91, 0x84, 0x83, 0x89, 0x07, 0x8C,
+  // mic
+  0x98, 0xF8, 0xF0, 0xE1, 0x93, 0xF3, 0xB0, 0xBF, 0x98, 0x80,
+};
+
+static const IconRle ICON_RLE_TABLE[ICON_RLE_COUNT] PROGMEM = {
+  { 8, 8, 0, 9, 0 },   // wifi_icon_bits
+  { 8, 8, 2, 10, 9 },   // mic
+};
+
+#endif // ICONS_RLE_H
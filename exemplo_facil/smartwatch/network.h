@@ -11,6 +11,8 @@
 #include <SPI.h>
 #include <Wire.h>
 #include <HTTPClient.h>
+#include "ws_queue.h"
+#include "clock_service.h"
 
 // ==========================================
 // MÓDULO DE REDE - WiFi, WebSocket, NTP
@@ -31,6 +33,23 @@ extern DNSServer dnsServer;
 bool ntpSincronizado = false;
 unsigned long lastPing = 0;
 
+// Inicialização assíncrona: initNetwork() só dispara o WiFi; o resto avança
+// em updateNetwork() sem bloquear o loop (display/botões/sensores já rodam).
+enum NetState {
+  NET_IDLE,
+  NET_PORTAL,           // AP de configuração
+  NET_WIFI_CONNECTING,  // aguardando WL_CONNECTED
+  NET_NTP_WAIT,         // SNTP em andamento (WebSocket já conectando)
+  NET_TIME_API,         // fallback HTTP rodando em task separada
+  NET_ONLINE
+};
+
+NetState netState = NET_IDLE;
+unsigned long netStateSince = 0;
+
+// Resultado da task de fallback HTTP (0 = rodando, 1 = ok, -1 = falhou)
+volatile int8_t timeApiResult = 0;
+
 // Funções públicas
 void initNetwork();
 void updateNetwork();
@@ -46,10 +65,12 @@ String gerarRandom(int len);
 // Portal de configuração
 void startConfigPortal();
 void handleRoot();
+void handleScan();
 void handleSave();
 
 // NTP
 void configurarNTP();
+bool syncTimeFromAPI();
 
 // ===== IMPLEMENTAÇÃO =====
 
@@ -62,67 +83,175 @@ String gerarRandom(int len) {
   return res;
 }
 
-void handleRoot() {
-  // Faz scan de redes Wi-Fi disponíveis
-  int n = WiFi.scanNetworks();
-  String options = "";
-  for (int i = 0; i < n; i++) {
+// ===== PORTAL: página estática + lista de redes via /scan =====
+// A página sai da flash em pedaços (chunked) e busca as redes em JSON.
+// O scan é assíncrono (WiFi.scanNetworks(true)), concluído em updateNetwork()
+// e guardado num cache de tamanho fixo, sem duplicatas (conjunto de hashes).
+
+static const char PORTAL_PAGE[] PROGMEM = R"rawliteral(<!DOCTYPE html>
+<html>
+<head>
+  <meta charset='utf-8'>
+  <meta name='viewport' content='width=device-width,initial-scale=1'>
+  <title>Configuracao Smartwatch ESP32</title>
+  <style>
+    body{font-family:Arial,Helvetica,sans-serif;background:#FFFFFF;margin:0;padding:0;color:#11181C;}
+    .container{max-width:400px;margin:40px auto;padding:24px;background:#F2F2F2;border-radius:12px;box-shadow:0 2px 8px rgba(0,0,0,0.1);}
+    h2{text-align:center;color:#FF7A00;margin-bottom:24px;}
+    label{display:block;margin-bottom:6px;font-weight:600;}
+    select,input{width:100%;padding:10px;margin-bottom:16px;border:1px solid #E0E0E0;border-radius:6px;box-sizing:border-box;}
+    button{width:100%;background:#FF7A00;color:#fff;padding:12px 0;border:none;border-radius:6px;font-size:16px;font-weight:bold;cursor:pointer;}
+    button:active{opacity:0.9;}
+    .refresh{background:#006AFF;margin-top:-8px;margin-bottom:16px;}
+  </style>
+  <script>
+    function copySSID(){var sel=document.getElementById('ssidSelect');document.getElementById('ssid').value=sel.value;}
+    function opt(sel,v,t){var o=document.createElement('option');o.value=v;o.text=t;sel.add(o);}
+    function load(r){
+      fetch('/scan'+(r?'?refresh=1':'')).then(function(x){return x.json();}).then(function(d){
+        var sel=document.getElementById('ssidSelect'),cur=sel.value;
+        sel.innerHTML='';
+        if(!d.nets.length)opt(sel,'',d.scanning?'Buscando redes...':'Nenhuma rede encontrada');
+        d.nets.forEach(function(n){opt(sel,n.s,n.s+' ('+n.r+' dBm)');});
+        if(cur)sel.value=cur;
+        copySSID();
+        if(d.scanning)setTimeout(load,1500);
+      }).catch(function(){setTimeout(load,3000);});
+    }
+  </script>
+</head>
+<body>
+  <div class='container'>
+    <h2>Configurar Wi-Fi & Email</h2>
+    <form action='/save' method='POST'>
+      <label for='ssidSelect'>Rede Wi-Fi</label>
+      <select id='ssidSelect' onchange='copySSID()'>
+        <option value=''>Buscando redes...</option>
+      </select>
+      <input type='hidden' id='ssid' name='ssid'>
+      <button type='button' class='refresh' onclick='load(1)'>Atualizar lista</button>
+      <label for='password'>Senha</label>
+      <input type='text' id='password' name='password' placeholder='Senha do Wi-Fi' required>
+      <label for='email'>E-mail</label>
+      <input type='email' id='email' name='email' placeholder='Seu e-mail' required>
+      <button type='submit'>Salvar</button>
+    </form>
+  </div>
+  <script>load(0);</script>
+</body>
+</html>
+)rawliteral";
+
+struct PortalNet {
+  char ssid[33];
+  int8_t rssi;
+};
+
+static PortalNet portalNets[PORTAL_MAX_NETS];
+static uint8_t portalNetCount = 0;
+static bool portalScanning = false;
+
+static uint32_t fnv1a(const char *s) {
+  uint32_t h = 2166136261u;
+  while (*s) {
+    h ^= (uint8_t)*s++;
+    h *= 16777619u;
+  }
+  return h ? h : 1;   // 0 marca slot vazio
+}
+
+// Insere no conjunto (endereçamento aberto); false se já existia
+static bool hashSetInsert(uint32_t *slots, uint32_t h) {
+  uint32_t i = h & (PORTAL_HASH_SLOTS - 1);
+  while (slots[i] != 0) {
+    if (slots[i] == h) return false;
+    i = (i + 1) & (PORTAL_HASH_SLOTS - 1);
+  }
+  slots[i] = h;
+  return true;
+}
+
+static void portalStartScan() {
+  if (portalScanning) return;
+  if (WiFi.scanNetworks(true) == WIFI_SCAN_FAILED) return;
+  portalScanning = true;
+}
+
+// Copia o resultado do scan para o cache (mais fortes primeiro, sem repetir SSID)
+static void portalPollScan() {
+  if (!portalScanning) return;
+  int n = WiFi.scanComplete();
+  if (n == WIFI_SCAN_RUNNING) return;
+  portalScanning = false;
+  if (n < 0) return;   // WIFI_SCAN_FAILED: mantém o cache anterior
+
+  uint32_t seen[PORTAL_HASH_SLOTS] = {0};
+  portalNetCount = 0;
+  for (int i = 0; i < n && portalNetCount < PORTAL_MAX_NETS; i++) {
     String ssidItem = WiFi.SSID(i);
     if (ssidItem.length() == 0) continue;
-    if (options.indexOf("value='" + ssidItem + "'") >= 0) continue;
-    int rssi = WiFi.RSSI(i);
-    options += "<option value='" + ssidItem + "'>" + ssidItem + " (" + String(rssi) + " dBm)</option>";
+    if (!hashSetInsert(seen, fnv1a(ssidItem.c_str()))) continue;
+    PortalNet &net = portalNets[portalNetCount++];
+    strncpy(net.ssid, ssidItem.c_str(), sizeof(net.ssid) - 1);
+    net.ssid[sizeof(net.ssid) - 1] = '\0';
+    net.rssi = (int8_t)WiFi.RSSI(i);
+  }
+  WiFi.scanDelete();
+  Serial.printf("Portal: %d redes (%u únicas)\n", n, (unsigned)portalNetCount);
+}
+
+// Escreve s como string JSON (com aspas) em out; retorna o tamanho
+static size_t jsonEscape(const char *s, char *out, size_t cap) {
+  size_t o = 0;
+  out[o++] = '"';
+  for (; *s && o + 7 < cap; s++) {
+    uint8_t c = (uint8_t)*s;
+    if (c == '"' || c == '\\') {
+      out[o++] = '\\';
+      out[o++] = (char)c;
+    } else if (c < 0x20) {
+      o += snprintf(out + o, cap - o, "\\u%04x", c);
+    } else {
+      out[o++] = (char)c;
+    }
   }
-  if (options.length() == 0) {
-    options = "<option>Nenhuma rede encontrada</option>";
+  out[o++] = '"';
+  out[o] = '\0';
+  return o;
+}
+
+void handleRoot() {
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/html", "");
+  const size_t total = sizeof(PORTAL_PAGE) - 1;
+  for (size_t off = 0; off < total; off += PORTAL_CHUNK_SIZE) {
+    size_t len = total - off < PORTAL_CHUNK_SIZE ? total - off : PORTAL_CHUNK_SIZE;
+    server.sendContent_P(PORTAL_PAGE + off, len);
   }
+  server.sendContent("");   // fim do chunked
+}
 
-  String page = R"rawliteral(
-    <!DOCTYPE html>
-    <html>
-    <head>
-      <meta charset='utf-8'>
-      <meta name='viewport' content='width=device-width,initial-scale=1'>
-      <title>Configuracao Smartwatch ESP32</title>
-      <style>
-        body{font-family:Arial,Helvetica,sans-serif;background:#FFFFFF;margin:0;padding:0;color:#11181C;}
-        .container{max-width:400px;margin:40px auto;padding:24px;background:#F2F2F2;border-radius:12px;box-shadow:0 2px 8px rgba(0,0,0,0.1);}        
-        h2{text-align:center;color:#FF7A00;margin-bottom:24px;}
-        label{display:block;margin-bottom:6px;font-weight:600;}
-        select,input{width:100%;padding:10px;margin-bottom:16px;border:1px solid #E0E0E0;border-radius:6px;box-sizing:border-box;}
-        button{width:100%;background:#FF7A00;color:#fff;padding:12px 0;border:none;border-radius:6px;font-size:16px;font-weight:bold;cursor:pointer;}
-        button:active{opacity:0.9;}
-        .refresh{background:#006AFF;margin-top:-8px;margin-bottom:16px;}
-      </style>
-      <script>
-        function copySSID(){var sel=document.getElementById('ssidSelect');document.getElementById('ssid').value=sel.value;}
-        function refresh(){location.reload();}
-      </script>
-    </head>
-    <body>
-      <div class='container'>
-        <h2>Configurar Wi-Fi & Email</h2>
-        <form action='/save' method='POST'>
-          <label for='ssidSelect'>Rede Wi-Fi</label>
-          <select id='ssidSelect' onchange='copySSID()'>
-            %OPTIONS%
-          </select>
-          <input type='hidden' id='ssid' name='ssid'>
-          <button type='button' class='refresh' onclick='refresh()'>Atualizar lista</button>
-          <label for='password'>Senha</label>
-          <input type='text' id='password' name='password' placeholder='Senha do Wi-Fi' required>
-          <label for='email'>E-mail</label>
-          <input type='email' id='email' name='email' placeholder='Seu e-mail' required>
-          <button type='submit'>Salvar</button>
-        </form>
-      </div>
-      <script>copySSID();</script>
-    </body>
-    </html>
-  )rawliteral";
-
-  page.replace("%OPTIONS%", options);
-  server.send(200, "text/html", page);
+// GET /scan[?refresh=1] -> {"scanning":bool,"nets":[{"s":"ssid","r":-60},...]}
+void handleScan() {
+  if (server.hasArg("refresh") || (portalNetCount == 0 && !portalScanning)) portalStartScan();
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+
+  char buf[32 + 6 * 32 + 24];
+  int n = snprintf(buf, sizeof(buf), "{\"scanning\":%s,\"nets\":[", portalScanning ? "true" : "false");
+  server.sendContent(buf, n);
+  for (uint8_t i = 0; i < portalNetCount; i++) {
+    size_t o = 0;
+    if (i) buf[o++] = ',';
+    memcpy(buf + o, "{\"s\":", 5);
+    o += 5;
+    o += jsonEscape(portalNets[i].ssid, buf + o, sizeof(buf) - o - 16);
+    o += snprintf(buf + o, sizeof(buf) - o, ",\"r\":%d}", portalNets[i].rssi);
+    server.sendContent(buf, o);
+  }
+  server.sendContent("]}", 2);
+  server.sendContent("");
 }
 
 void handleSave() {
@@ -143,7 +272,11 @@ void startConfigPortal() {
   IPAddress gateway(192, 168, 10, 1);
   IPAddress subnet(255, 255, 255, 0);
 
-  WiFi.mode(WIFI_AP);
+  // Para as tentativas com as credenciais antigas: enquanto o usuário digita
+  // as novas, a STA só faz scan (reconexões trocariam o canal do AP)
+  WiFi.setAutoReconnect(false);
+  WiFi.disconnect(false, false);
+  WiFi.mode(WIFI_AP_STA);   // STA necessário para o scan
   WiFi.softAPConfig(local_ip, gateway, subnet);
   WiFi.softAP("Smartwatch Config");
 
@@ -153,15 +286,18 @@ void startConfigPortal() {
 
   dnsServer.start(DNS_PORT, "*", local_ip);
   server.on("/", handleRoot);
+  server.on("/scan", handleScan);
   server.on("/save", HTTP_POST, handleSave);
   server.begin();
+
+  portalStartScan();
 }
 
 // Função alternativa usando API HTTP para sincronização de tempo
 bool syncTimeFromAPI() {
   HTTPClient http;
   http.begin("http://worldtimeapi.org/api/timezone/America/Cuiaba");
-  http.setTimeout(8000); // 8 segundos timeout (aumentado)
+  http.setTimeout(TIME_API_TIMEOUT_MS);
 
   Serial.println("Tentando sincronizar via API HTTP...");
   Serial.print("Fazendo requisição para: ");
@@ -193,7 +329,12 @@ bool syncTimeFromAPI() {
       time_t unixTime = unixtimeStr.toInt();
       Serial.printf("Valor unixtime convertido: %ld\n", unixTime);
 
-      if (unixTime > 0) {
+      if (unixTime > 0 && time(nullptr) > 24 * 3600) {
+        // O SNTP (ainda ativo) respondeu durante a requisição: a hora dele
+        // vale, não é sobrescrita pela da API
+        Serial.println("Hora já sincronizada via NTP, resposta da API ignorada");
+        return false;
+      } else if (unixTime > 0) {
         // A API já retorna o tempo local, então não precisamos ajustar
         struct timeval tv;
         tv.tv_sec = unixTime;
@@ -219,71 +360,47 @@ bool syncTimeFromAPI() {
   return false;
 }
 
+static void setNetState(NetState st) {
+  netState = st;
+  netStateSince = millis();
+}
+
+// Task descartável: HTTPClient bloqueia até TIME_API_TIMEOUT_MS
+static void timeApiTask(void *) {
+  timeApiResult = syncTimeFromAPI() ? 1 : -1;
+  vTaskDelete(NULL);
+}
+
+// Dispara SNTP (não bloqueia); a conclusão é verificada em updateNetwork()
 void configurarNTP() {
-  // Primeiro tenta NTP tradicional
   configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
-
   Serial.println("Sincronizando com servidor NTP...");
+}
 
-  int tentativas = 0;
-  while (time(nullptr) < 24 * 3600 && tentativas < 10) {
-    Serial.print(".");
-    delay(1000);
-    tentativas++;
-  }
-
-  if (time(nullptr) > 24 * 3600) {
-    ntpSincronizado = true;
-    Serial.println("\nNTP sincronizado com sucesso!");
-    return;
-  }
-
-  Serial.println("\nNTP tradicional falhou, tentando API HTTP...");
+static void iniciarWebSocket() {
+  webSocket.setReconnectInterval(5000);
+  webSocket.setAuthorization(WS_USER, WS_PASS);
+  webSocket.setExtraHeaders("Sec-WebSocket-Extensions:");
+  webSocket.onEvent(handleWebSocketEvent);
+  webSocket.beginSSL(WS_HOST, WS_PORT, WS_PATH);
+}
 
-  // Fallback: tenta API HTTP
-  if (syncTimeFromAPI()) {
-    ntpSincronizado = true;
-    Serial.println("Sincronização NTP concluída (via API HTTP)!");
-  } else {
-    Serial.println("Falha em todas as tentativas de sincronização NTP");
-  }
+static void marcarHoraSincronizada(const char *fonte) {
+  ntpSincronizado = true;
+  Serial.printf("Hora sincronizada via %s (%lums após boot)\n", fonte, millis());
 }
 
+// Compatibilidade: cópias dos textos em cache (clock_service.h)
 String getTimeString() {
-  if (!ntpSincronizado) {
-    return "00:00:00";
-  }
-
-  time_t now = time(nullptr);
-  struct tm *tmNow = localtime(&now);
-
-  char buf[9];
-  sprintf(buf, "%02d:%02d:%02d", tmNow->tm_hour, tmNow->tm_min, tmNow->tm_sec);
-  return String(buf);
+  return String(clockNow.timeStr);
 }
 
 String getDateString() {
-  if (!ntpSincronizado) {
-    return "01/01";
-  }
-
-  time_t now = time(nullptr);
-  struct tm *tmNow = localtime(&now);
-
-  char buf[6];
-  sprintf(buf, "%02d/%02d", tmNow->tm_mday, tmNow->tm_mon + 1);
-  return String(buf);
+  return String(clockNow.dateStr);
 }
 
 int getCurrentYear() {
-  if (!ntpSincronizado) {
-    return 2025;
-  }
-
-  time_t now = time(nullptr);
-  struct tm *tmNow = localtime(&now);
-
-  return tmNow->tm_year + 1900;
+  return clockNow.year;
 }
 
 bool isWiFiConnected() {
@@ -313,52 +430,84 @@ void initNetwork() {
   if (ssid.length() == 0) {
     Serial.println("Credenciais nao encontradas, iniciando portal...");
     startConfigPortal();
+    setNetState(NET_PORTAL);
     return;
   }
 
   Serial.println("Conectando WiFi...");
   WiFi.begin(ssid.c_str(), password.c_str());
-  unsigned long startAttemptTime = millis();
-  while (WiFi.status() != WL_CONNECTED && millis() - startAttemptTime < 15000) {
-    delay(500);
-    Serial.print(".");
-  }
-
-  if (WiFi.status() != WL_CONNECTED) {
-    Serial.println("\nFalha ao conectar, iniciando portal...");
-    startConfigPortal();
-    return;
-  }
+  setNetState(NET_WIFI_CONNECTING);
+}
 
-  Serial.println("\nWiFi conectado!");
-  Serial.print("IP: ");
-  Serial.println(WiFi.localIP());
+void updateNetwork() {
+  switch (netState) {
+    case NET_PORTAL:
+      dnsServer.processNextRequest();
+      server.handleClient();
+      portalPollScan();
+      return;
+
+    case NET_WIFI_CONNECTING:
+      if (WiFi.status() == WL_CONNECTED) {
+        Serial.printf("WiFi conectado! IP: %s (%lums após boot)\n",
+                      WiFi.localIP().toString().c_str(), millis());
+        configurarNTP();
+        iniciarWebSocket();
+        setNetState(NET_NTP_WAIT);
+      } else if (millis() - netStateSince > WIFI_CONNECT_TIMEOUT_MS) {
+        Serial.println("Falha ao conectar, iniciando portal...");
+        startConfigPortal();
+        setNetState(NET_PORTAL);
+      }
+      return;
+
+    case NET_NTP_WAIT:
+      if (time(nullptr) > 24 * 3600) {
+        marcarHoraSincronizada("NTP");
+        setNetState(NET_ONLINE);
+      } else if (millis() - netStateSince > NTP_SYNC_TIMEOUT_MS) {
+        Serial.println("NTP tradicional falhou, tentando API HTTP...");
+        timeApiResult = 0;
+        xTaskCreatePinnedToCore(timeApiTask, "timeApi", 8192, NULL, 1, NULL, 0);
+        setNetState(NET_TIME_API);
+      }
+      break;
+
+    case NET_TIME_API:
+      // O SNTP continua ativo; vale o que responder primeiro
+      if (timeApiResult == 1) {
+        marcarHoraSincronizada("API HTTP");
+        setNetState(NET_ONLINE);
+      } else if (time(nullptr) > 24 * 3600) {
+        marcarHoraSincronizada("NTP");
+        setNetState(NET_ONLINE);
+      } else if (timeApiResult == -1) {
+        Serial.println("Falha em todas as tentativas de sincronização NTP");
+        setNetState(NET_ONLINE);
+      }
+      break;
 
-  // Configura NTP
-  configurarNTP();
+    case NET_ONLINE:
+      // SNTP pode concluir depois de um fallback que falhou
+      if (!ntpSincronizado && time(nullptr) > 24 * 3600) marcarHoraSincronizada("NTP");
+      break;
 
-  // Configura WebSocket
-  webSocket.setReconnectInterval(5000);
-  webSocket.setAuthorization(WS_USER, WS_PASS);
-  webSocket.setExtraHeaders("Sec-WebSocket-Extensions:");
-  webSocket.onEvent(handleWebSocketEvent);
-  webSocket.beginSSL(WS_HOST, WS_PORT, WS_PATH);
-}
+    default:
+      return;
+  }
 
-void updateNetwork() {
+  // WebSocket e ping rodam em paralelo à sincronização de hora
   if (WiFi.status() == WL_CONNECTED) {
     webSocket.loop();
 
     // Ping periódico
     if (millis() - lastPing > PING_INTERVAL_MS) {
-      webSocket.sendTXT("ping");
+      wsEnqueue("ping", 4, WSQ_PRIO_NORMAL, WSQ_DROPPABLE, WSQ_KEY_PING);
       Serial.println("ping");
       lastPing = millis();
     }
-  } else {
-    // No modo AP (portal de configuração)
-    dnsServer.processNextRequest();
-    server.handleClient();
+
+    if (webSocket.isConnected()) wsQueueFlush();
   }
 }
 
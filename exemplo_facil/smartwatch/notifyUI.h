@@ -6,30 +6,17 @@
 #define NOTIFY_UI_H
 
 #include <TFT_eSPI.h>
-#include <math.h>
+#include "config.h"
+#include "text_layout.h"
+#include "text_charset.h"
 
 // ---------- Util ----------
-static inline uint16_t RGB(uint8_t r,uint8_t g,uint8_t b){
-  return ((r&0xF8)<<8)|((g&0xFC)<<3)|(b>>3);
-}
-static String asciiOnly(String s){
-  s.replace("á","a"); s.replace("é","e"); s.replace("í","i");
-  s.replace("ó","o"); s.replace("ú","u"); s.replace("ç","c");
-  s.replace("Á","A"); s.replace("É","E"); s.replace("Í","I");
-  s.replace("Ó","O"); s.replace("Ú","U"); s.replace("Ç","C");
-  s.replace("ã","a"); s.replace("õ","o"); s.replace("Ã","A"); s.replace("Õ","O");
-  s.replace("â","a"); s.replace("ê","e"); s.replace("ô","o"); s.replace("Â","A"); s.replace("Ê","E"); s.replace("Ô","O");
-  s.replace("×","x"); s.replace("÷","/"); s.replace("−","-");
-  // filtra não-ASCII
-  String out; out.reserve(s.length());
-  for (uint16_t i=0;i<s.length();++i){ char c=s[i]; if ((uint8_t)c>=32 && (uint8_t)c<=126) out+=c; }
-  return out.length()? out : String("?");
-}
-static int chordWidthAtY(int cx,int cy,int R,int y){
-  float dy = (float)y - (float)cy;
-  float inside = (float)R*(float)R - dy*dy;
-  if (inside <= 0) return 0;
-  return (int)floorf(2.0f * sqrtf(inside));
+// Nota: RGB() já está definido em config.h
+// Cordas do círculo seguro do cartão (tabela feita uma vez)
+static const TextCircle &notifySafeCircle(int cx, int cy, int r){
+  static TextCircle c = { 0, 0, 0, { 0 } };
+  if (c.r != r || c.cx != cx || c.cy != cy) textCircleInit(c, cx, cy, r);
+  return c;
 }
 
 // ---------- Dados da notificação ----------
@@ -98,36 +85,27 @@ static void drawAppIcon(TFT_eSPI &tft, int cx, int cy, int r, const char* app, u
 }
 
 // ---------- Texto com wrap em largura fixa ----------
+// A quebra fica guardada (text_layout.h): redesenhar o mesmo corpo não mede
+// o texto de novo.
 static void drawWrapped(TFT_eSPI &tft, const String& text, int x, int y, int w, int lines, uint8_t textSize, uint16_t fg, uint16_t bg){
-  tft.setTextFont(1);
+  static TextLayout wrap;
   tft.setTextSize(textSize);
-  tft.setTextColor(fg, bg);
-  tft.setTextDatum(TL_DATUM);
-
-  String s = asciiOnly(text);
-  int i = 0;
-  int lineH = tft.fontHeight(1) * textSize + 2;
-  for (int ln=0; ln<lines && i < s.length(); ++ln){
-    int best = i, j = i+1, lastSpace = -1;
-    while (j <= s.length()){
-      String cand = s.substring(i, j);
-      if (tft.textWidth(cand) > w) break;
-      if (s[j-1] == ' ') lastSpace = j-1;
-      best = j;
-      j++;
-    }
-    int end = best;
-    if (lastSpace > i && lastSpace < best) end = lastSpace;
-    String line = s.substring(i, end);
-    // trim fim
-    while (line.length() && line[line.length()-1]==' ') line.remove(line.length()-1);
-    if (!line.length()){ line = s.substring(i, min((int)s.length(), i+1)); end = i + line.length(); }
-    tft.drawString(line, x, y + ln*lineH);
-    i = (end < (int)s.length() && s[end]==' ') ? end+1 : end;
-  }
+  int lineH = tft.fontHeight(1) + 2;
+  textLayoutBox(wrap, nullptr, 1, textSize, TEXT_ALIGN_LEFT, x, w, y, y + lines*lineH, 0, 2, lines);
+  char buf[TEXT_LAYOUT_CHARS];
+  const DisplayCharset cs = textCharsetFor(1);
+  textToDisplay(text.c_str(), buf, sizeof(buf), cs);
+  textLayoutSet(tft, wrap, buf);
+  textCharsetBegin(tft, cs);
+  textLayoutDraw(tft, wrap, fg, bg);
+  textCharsetEnd(tft, cs);
 }
 
 // ---------- Cartão (toast) ----------
+static inline int notifyToastHeight(bool actions){
+  return actions ? 110 : 92;
+}
+
 // yCenter define a altura do cartão; 88 é bom para topo/centro.
 // actions: mostra "Desc  |  Abrir  |  Resp" (opcional)
 static void drawNotifyToast(TFT_eSPI &tft, const NotifyCard &n, int yCenter = 88, bool actions=false){
@@ -145,14 +123,15 @@ static void drawNotifyToast(TFT_eSPI &tft, const NotifyCard &n, int yCenter = 88
   // tft.drawCircle(CX,CY,R,COL_FRAME);
 
   // tamanho do cartão pela corda do círculo nesta altura
-  int cardH = actions ? 110 : 92;
+  int cardH = notifyToastHeight(actions);
   int yTop  = yCenter - cardH/2;
   int yBot  = yCenter + cardH/2;
 
   // largura = corda na base do cartão (para não vazar nas bordas)
-  int chordTop = chordWidthAtY(CX, CY, SAFE, yTop+12);
-  int chordMid = chordWidthAtY(CX, CY, SAFE, yCenter);
-  int chordBot = chordWidthAtY(CX, CY, SAFE, yBot-12);
+  const TextCircle &safe = notifySafeCircle(CX, CY, SAFE);
+  int chordTop = textChordWidth(safe, yTop+12, yTop+12);
+  int chordMid = textChordWidth(safe, yCenter, yCenter);
+  int chordBot = textChordWidth(safe, yBot-12, yBot-12);
   int cardW = min(chordTop, min(chordMid, chordBot)) - 12; // folga
   if (cardW > 212) cardW = 212;
   if (cardW < 140) cardW = 140;
@@ -175,17 +154,24 @@ static void drawNotifyToast(TFT_eSPI &tft, const NotifyCard &n, int yCenter = 88
   if (n.unread) tft.fillCircle(iconX + iconR-3, iconY - iconR+3, 3, RGB(255,80,120)); // badge
 
   // app (pequeno) à direita do ícone
+  char buf[48];
+  const DisplayCharset cs = textCharsetFor(1);
+  textCharsetBegin(tft, cs);
   tft.setTextFont(1); tft.setTextSize(1); tft.setTextColor(COL_SUB, COL_CARD); tft.setTextDatum(TL_DATUM);
-  tft.drawString(asciiOnly(n.app), iconX + iconR + 6, yTop + 6);
+  textToDisplay(n.app, buf, sizeof(buf), cs);
+  tft.drawString(buf, iconX + iconR + 6, yTop + 6);
 
   // tempo (canto superior direito)
   tft.setTextDatum(TR_DATUM);
-  tft.drawString(asciiOnly(n.time), xLeft + cardW - 8, yTop + 6);
+  textToDisplay(n.time, buf, sizeof(buf), cs);
+  tft.drawString(buf, xLeft + cardW - 8, yTop + 6);
 
   // Título (remetente) — maior
   tft.setTextDatum(TL_DATUM);
   tft.setTextSize(2); tft.setTextColor(COL_TEXT, COL_CARD);
-  tft.drawString(asciiOnly(n.title), xLeft + pad, yTop + 24);
+  textToDisplay(n.title, buf, sizeof(buf), cs);
+  tft.drawString(buf, xLeft + pad, yTop + 24);
+  textCharsetEnd(tft, cs);
 
   // Corpo com wrap (2–3 linhas)
   int textX = xLeft + pad;
@@ -0,0 +1,197 @@
+#ifndef NOTIFY_OVERLAY_H
+#define NOTIFY_OVERLAY_H
+
+#include "config.h"
+#include <TFT_eSPI.h>
+#include "notifyUI.h"
+#include "display_clip.h"
+
+// ==========================================
+// OVERLAY DE NOTIFICAÇÃO - toast sobre a tela atual
+// ==========================================
+// O cartão (drawNotifyToast) é desenhado uma vez num sprite do tamanho da
+// faixa que ocupa e entra de cima para baixo em NOTIFY_TOAST_FRAMES quadros;
+// cada quadro envia só as linhas novas. O fundo do sprite é transparente: em
+// volta do cartão fica o que já estava na tela.
+// Não há pixels salvos: o display não tem MISO ligado (sem leitura) e uma
+// cópia ficaria velha, porque a tela de baixo continua mudando. Enquanto o
+// toast aparece, o agendador segue desenhando a tela atual, recortada abaixo
+// dele (displayClipBase()); na saída, cada faixa liberada é devolvida pela
+// própria tela com render(true) recortado só nela.
+// O sprite (240 x altura do cartão, 16 bpp: ~44 KB) só existe enquanto há
+// toast: é criado ao mostrar e apagado quando a saída termina. Com PSRAM o
+// TFT_eSprite já aloca lá; sem PSRAM a RAM interna volta livre no fim.
+// Métrica: latência da chegada da mensagem ao primeiro quadro do toast.
+
+enum NotifyOverlayPhase : uint8_t {
+  OVERLAY_IDLE,
+  OVERLAY_IN,
+  OVERLAY_SHOWN,
+  OVERLAY_OUT
+};
+
+static TFT_eSprite notifyOverlaySprite(&tft);
+static NotifyOverlayPhase overlayPhase = OVERLAY_IDLE;
+static int16_t overlayTop = 0;        // primeira linha do cartão na tela
+static int16_t overlayH = 0;
+static int16_t overlayShown = 0;      // linhas do cartão reservadas na tela
+static int16_t overlaySent = 0;       // linhas do sprite atual já enviadas
+static uint8_t overlayFrame = 0;
+static uint32_t overlayNextMs = 0;
+static uint32_t overlayReceivedUs = 0; // 0 = latência já medida
+
+// Métricas
+uint32_t notifyToasts = 0;
+uint32_t notifyToastLatencyUs = 0;
+uint32_t notifyToastMaxLatencyUs = 0;
+
+bool notifyOverlayActive() {
+  return overlayPhase != OVERLAY_IDLE;
+}
+
+// Linhas visíveis no quadro f da entrada (desacelera no fim)
+static int16_t overlayRows(uint8_t f) {
+  if (f >= NOTIFY_TOAST_FRAMES) return overlayH;
+  int32_t left = NOTIFY_TOAST_FRAMES - f;
+  return overlayH - (int32_t)overlayH * left * left / (NOTIFY_TOAST_FRAMES * NOTIFY_TOAST_FRAMES);
+}
+
+// A tela de baixo desenha só abaixo das linhas ocupadas pelo toast
+static void overlayClipBelow() {
+  int16_t y = overlayTop + overlayShown;
+  displayClipBase(tft, 0, y, tft.width(), tft.height() - y);
+}
+
+static void overlaySendRows(int16_t from, int16_t to) {
+  if (to <= from) return;
+  displayClipBaseReset(tft);
+  displayClipPush(tft, 0, overlayTop + from, tft.width(), to - from);
+  notifyOverlaySprite.pushSprite(0, overlayTop, TFT_TRANSPARENT);
+  displayClipPop(tft);
+}
+
+// Devolve as linhas [y0, y1) da tela à tela atual
+static void overlayRestore(int16_t y0, int16_t y1, void (*render)(bool)) {
+  if (y1 <= y0) return;
+  displayClipBase(tft, 0, y0, tft.width(), y1 - y0);
+  render(true);
+}
+
+static void overlayMeasureLatency() {
+  if (!overlayReceivedUs) return;
+  notifyToastLatencyUs = micros() - overlayReceivedUs;
+  if (notifyToastLatencyUs > notifyToastMaxLatencyUs) notifyToastMaxLatencyUs = notifyToastLatencyUs;
+  notifyToasts++;
+  overlayReceivedUs = 0;
+  Serial.printf("Toast: %uus da mensagem ao primeiro pixel (max %uus)\n",
+                (unsigned)notifyToastLatencyUs, (unsigned)notifyToastMaxLatencyUs);
+}
+
+// Mostra (ou troca) o toast; receivedUs = micros() da chegada da mensagem
+void notifyOverlayShow(const char *text, const char *time, uint32_t receivedUs) {
+  NotifyCard card;
+  card.app = "WebSocket";
+  card.title = "Mensagem";
+  card.body = text;
+  card.time = time;
+  card.accent = COLOR_ACCENT;
+
+  overlayH = notifyToastHeight(false);
+  overlayTop = NOTIFY_TOAST_Y - overlayH / 2;
+  overlayReceivedUs = receivedUs;
+  if (overlayPhase == OVERLAY_IDLE) overlayShown = 0;
+
+  if (!notifyOverlaySprite.created()) notifyOverlaySprite.createSprite(tft.width(), overlayH);
+  if (!notifyOverlaySprite.created()) {
+    // Sem memória para o sprite: cartão direto na tela, sem animação
+    displayClipBaseReset(tft);
+    displayClipPush(tft, 0, overlayTop, tft.width(), overlayH);
+    drawNotifyToast(tft, card, NOTIFY_TOAST_Y);
+    displayClipPop(tft);
+    overlayMeasureLatency();
+    overlayShown = overlaySent = overlayH;
+    overlayPhase = OVERLAY_SHOWN;
+    overlayNextMs = millis() + NOTIFY_TOAST_MS;
+    overlayClipBelow();
+    return;
+  }
+
+  notifyOverlaySprite.fillSprite(TFT_TRANSPARENT);
+  // Origem deslocada: o cartão é desenhado em coordenadas de tela
+  notifyOverlaySprite.setViewport(0, -overlayTop, tft.width(), tft.height(), true);
+  drawNotifyToast(notifyOverlaySprite, card, NOTIFY_TOAST_Y);
+  notifyOverlaySprite.resetViewport();
+
+  // Conteúdo novo: reenvia do topo, continuando a entrada de onde está
+  overlaySent = 0;
+  overlayFrame = 0;
+  while (overlayFrame < NOTIFY_TOAST_FRAMES && overlayRows(overlayFrame) < overlayShown) overlayFrame++;
+  overlayPhase = OVERLAY_IN;
+  overlayNextMs = millis();
+  overlayClipBelow();
+}
+
+// Quanto o loop pode dormir sem atrasar o próximo quadro do toast
+uint32_t notifyOverlaySleepMs(uint32_t maxMs) {
+  if (overlayPhase == OVERLAY_IDLE) return maxMs;
+  int32_t left = (int32_t)(overlayNextMs - millis());
+  if (left <= 0) return 0;
+  return (uint32_t)left < maxMs ? (uint32_t)left : maxMs;
+}
+
+bool notifyOverlayDue() {
+  return overlayPhase != OVERLAY_IDLE && (int32_t)(millis() - overlayNextMs) >= 0;
+}
+
+// Um passo do toast; render é a tela atual (para devolver as linhas)
+void notifyOverlayUpdate(void (*render)(bool)) {
+  if (!notifyOverlayDue()) return;
+  uint32_t now = millis();
+
+  switch (overlayPhase) {
+    case OVERLAY_IN: {
+      overlayFrame++;
+      int16_t rows = overlayRows(overlayFrame);
+      overlaySendRows(overlaySent, rows);
+      overlaySent = overlayShown = rows;
+      overlayMeasureLatency();
+      if (overlayFrame >= NOTIFY_TOAST_FRAMES) {
+        overlayPhase = OVERLAY_SHOWN;
+        overlayNextMs = now + NOTIFY_TOAST_MS;
+      } else {
+        overlayNextMs = now + NOTIFY_TOAST_FRAME_MS;
+      }
+      break;
+    }
+    case OVERLAY_SHOWN:
+      overlayPhase = OVERLAY_OUT;
+      overlayFrame = 0;
+      overlayNextMs = now;
+      return;
+    case OVERLAY_OUT: {
+      overlayFrame++;
+      int16_t rows = overlayRows(NOTIFY_TOAST_FRAMES - overlayFrame);
+      if (rows > 0) {
+        overlayRestore(overlayTop + rows, overlayTop + overlayShown, render);
+      } else {
+        // Último quadro: inclui as linhas acima do cartão, paradas até aqui
+        overlayRestore(0, overlayTop + overlayShown, render);
+      }
+      overlayShown = rows;
+      if (overlaySent > rows) overlaySent = rows;
+      if (!rows) {
+        overlayPhase = OVERLAY_IDLE;
+        notifyOverlaySprite.deleteSprite();
+        displayClipBaseReset(tft);
+        return;
+      }
+      overlayNextMs = now + NOTIFY_TOAST_FRAME_MS;
+      break;
+    }
+    default:
+      return;
+  }
+  overlayClipBelow();
+}
+
+#endif // NOTIFY_OVERLAY_H
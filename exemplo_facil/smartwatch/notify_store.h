@@ -0,0 +1,305 @@
+#ifndef NOTIFY_STORE_H
+#define NOTIFY_STORE_H
+
+#include "config.h"
+#include <Arduino.h>
+#include "flash_fs.h"
+
+// ==========================================
+// ARMAZÉM DE NOTIFICAÇÕES - anel + arena
+// ==========================================
+// Até NOTIFY_CAPACITY notificações num anel de entradas fixas; os textos
+// ficam todos numa arena contígua de NOTIFY_ARENA_BYTES (cada entrada
+// guarda só deslocamento e tamanho). Inserir e descartar a mais antiga são
+// O(1): a arena também é circular, e quando a próxima mensagem não cabe
+// antes do fim ela recomeça do início (o texto de cada entrada fica sempre
+// contíguo e terminado em '\0'). Sem String e sem heap.
+// Contador de não lidas mantido a cada inclusão/leitura/descarte.
+//
+// Com NOTIFY_PERSIST, cada mudança vira um registro anexado a um log em
+// LittleFS (NOTIFY_LOG_PATH), relido no boot. Quando o log passa de
+// NOTIFY_LOG_MAX_BYTES ele é compactado: reescrito só com o conteúdo atual
+// do anel (arquivo temporário + rename).
+
+#if NOTIFY_MSG_MAX >= NOTIFY_ARENA_BYTES
+#error "NOTIFY_MSG_MAX precisa ser menor que NOTIFY_ARENA_BYTES"
+#endif
+#if NOTIFY_MSG_MAX >= TEXT_LAYOUT_CHARS
+#error "TEXT_LAYOUT_CHARS precisa comportar NOTIFY_MSG_MAX (a tela mostra a mensagem inteira)"
+#endif
+
+struct NotifyEntry {
+  uint32_t id;          // sequencial, também no log
+  uint32_t offset;      // posição lógica na arena (cresce sempre)
+  uint16_t len;         // bytes do texto (sem o '\0')
+  bool read;
+  char time[9];         // "HH:MM:SS"
+};
+
+static NotifyEntry notifyRing[NOTIFY_CAPACITY];
+static char notifyArena[NOTIFY_ARENA_BYTES];
+static uint16_t notifyFirst = 0;        // entrada mais antiga
+static uint16_t notifyCountNow = 0;
+static uint16_t notifyUnreadNow = 0;
+static uint32_t notifyHead = 0;         // próxima posição lógica livre da arena
+static uint32_t notifyNextId = 1;
+
+// Métricas
+uint32_t notifyEvicted = 0;             // descartadas por falta de espaço
+uint32_t notifyLogBytes = 0;
+uint32_t notifyCompactions = 0;
+
+static inline NotifyEntry &notifyEntry(uint16_t i) {
+  return notifyRing[(notifyFirst + i) % NOTIFY_CAPACITY];
+}
+
+static inline uint16_t notifyCount() { return notifyCountNow; }
+static inline uint16_t notifyUnread() { return notifyUnreadNow; }
+
+// i = 0 é a mais antiga
+static const char *notifyText(uint16_t i) {
+  return i < notifyCountNow ? notifyArena + notifyEntry(i).offset % NOTIFY_ARENA_BYTES : "";
+}
+
+static const char *notifyTime(uint16_t i) {
+  return i < notifyCountNow ? notifyEntry(i).time : "";
+}
+
+static bool notifyIsRead(uint16_t i) {
+  return i < notifyCountNow && notifyEntry(i).read;
+}
+
+static void notifyDropOldest() {
+  if (!notifyCountNow) return;
+  if (!notifyRing[notifyFirst].read) notifyUnreadNow--;
+  notifyFirst = (notifyFirst + 1) % NOTIFY_CAPACITY;
+  notifyCountNow--;
+  notifyEvicted++;
+}
+
+// Insere na memória; retorna quantas antigas saíram para abrir espaço
+static uint16_t notifyRingAdd(uint32_t id, const char *msg, size_t len, const char *time, bool read) {
+  if (len > NOTIFY_MSG_MAX) {
+    len = NOTIFY_MSG_MAX;
+    while (len && ((uint8_t)msg[len] & 0xC0) == 0x80) len--;   // não corta um caractere UTF-8
+  }
+  uint32_t need = len + 1;
+
+  // Texto contíguo: se não cabe até o fim da arena, recomeça do início
+  uint32_t at = notifyHead % NOTIFY_ARENA_BYTES;
+  if (at + need > NOTIFY_ARENA_BYTES) notifyHead += NOTIFY_ARENA_BYTES - at;
+
+  uint16_t dropped = 0;
+  while (notifyCountNow &&
+         (notifyCountNow == NOTIFY_CAPACITY ||
+          notifyHead + need - notifyRing[notifyFirst].offset > NOTIFY_ARENA_BYTES)) {
+    notifyDropOldest();
+    dropped++;
+  }
+
+  NotifyEntry &e = notifyRing[(notifyFirst + notifyCountNow) % NOTIFY_CAPACITY];
+  e.id = id;
+  e.offset = notifyHead;
+  e.len = len;
+  e.read = read;
+  strncpy(e.time, time ? time : "", sizeof(e.time) - 1);
+  e.time[sizeof(e.time) - 1] = '\0';
+  char *dst = notifyArena + notifyHead % NOTIFY_ARENA_BYTES;
+  memcpy(dst, msg, len);
+  dst[len] = '\0';
+  notifyHead += need;
+  notifyCountNow++;
+  if (!read) notifyUnreadNow++;
+  if (id >= notifyNextId) notifyNextId = id + 1;
+  return dropped;
+}
+
+static void notifyRingClear() {
+  notifyFirst = 0;
+  notifyCountNow = 0;
+  notifyUnreadNow = 0;
+  notifyHead = 0;
+}
+
+// ---------- Log em flash ----------
+#if NOTIFY_PERSIST
+
+#define NOTIFY_LOG_PATH "/notify.log"
+#define NOTIFY_LOG_TMP "/notify.tmp"
+#define NOTIFY_LOG_MAGIC 0x3146544E     // "NTF1"
+
+enum NotifyRecord : uint8_t {
+  NOTIFY_REC_ADD = 'A',                 // id, posição na arena, hora, tamanho, texto
+  NOTIFY_REC_READ = 'R'                 // id
+};
+
+static File notifyLog;
+
+#define NOTIFY_REC_ADD_BYTES (1 + 4 + 4 + 8 + 2)
+
+// A posição na arena vai junto: o boot refaz exatamente o mesmo anel (e os
+// mesmos descartes) em vez de depender de por onde a arena começou
+static bool notifyLogWriteAdd(File &f, const NotifyEntry &e, const char *text) {
+  uint8_t hdr[NOTIFY_REC_ADD_BYTES];
+  hdr[0] = NOTIFY_REC_ADD;
+  memcpy(hdr + 1, &e.id, 4);
+  memcpy(hdr + 5, &e.offset, 4);
+  memcpy(hdr + 9, e.time, 8);
+  memcpy(hdr + 17, &e.len, 2);
+  return f.write(hdr, sizeof(hdr)) == sizeof(hdr) && f.write((const uint8_t *)text, e.len) == e.len;
+}
+
+static void notifyLogAppend(const uint8_t *rec, size_t len) {
+  if (!notifyLog) return;
+  if (notifyLog.write(rec, len) == len) notifyLogBytes += len;
+  notifyLog.flush();
+}
+
+// Reescreve o log só com o que está no anel
+static bool notifyLogCompact() {
+  if (!flashFsMounted()) return false;
+  if (notifyLog) notifyLog.close();
+  File f = LittleFS.open(NOTIFY_LOG_TMP, FILE_WRITE);
+  uint32_t magic = NOTIFY_LOG_MAGIC;
+  uint32_t bytes = 4;
+  bool ok = false;
+  if (f) ok = f.write((const uint8_t *)&magic, 4) == 4;
+  for (uint16_t i = 0; ok && i < notifyCountNow; i++) {
+    const NotifyEntry &e = notifyEntry(i);
+    ok = notifyLogWriteAdd(f, e, notifyText(i));
+    bytes += NOTIFY_REC_ADD_BYTES + e.len;
+    if (ok && e.read) {
+      uint8_t rec[5] = { NOTIFY_REC_READ };
+      memcpy(rec + 1, &e.id, 4);
+      ok = f.write(rec, 5) == 5;
+      bytes += 5;
+    }
+  }
+  if (f) f.close();
+  if (ok) {
+    LittleFS.remove(NOTIFY_LOG_PATH);
+    ok = LittleFS.rename(NOTIFY_LOG_TMP, NOTIFY_LOG_PATH);
+  }
+  if (ok) {
+    notifyLogBytes = bytes;
+    notifyCompactions++;
+  } else {
+    LittleFS.remove(NOTIFY_LOG_TMP);
+    Serial.println("Notificações: falha ao compactar o log");
+  }
+  notifyLog = LittleFS.open(NOTIFY_LOG_PATH, FILE_APPEND);
+  return ok;
+}
+
+static NotifyEntry *notifyFindId(uint32_t id) {
+  for (uint16_t i = 0; i < notifyCountNow; i++) {
+    if (notifyEntry(i).id == id) return &notifyEntry(i);
+  }
+  return nullptr;
+}
+
+// Relê o log; false se o arquivo terminou no meio de um registro
+static bool notifyLogReplay(File &f) {
+  uint32_t magic = 0;
+  if (f.read((uint8_t *)&magic, 4) != 4 || magic != NOTIFY_LOG_MAGIC) return false;
+  static char text[NOTIFY_MSG_MAX + 1];
+  while (f.available()) {
+    int type = f.read();
+    if (type == NOTIFY_REC_ADD) {
+      uint8_t hdr[NOTIFY_REC_ADD_BYTES - 1];
+      if (f.read(hdr, sizeof(hdr)) != sizeof(hdr)) return false;
+      uint32_t id, offset;
+      uint16_t len;
+      char time[9];
+      memcpy(&id, hdr, 4);
+      memcpy(&offset, hdr + 4, 4);
+      memcpy(time, hdr + 8, 8);
+      time[8] = '\0';
+      memcpy(&len, hdr + 16, 2);
+      if (len > NOTIFY_MSG_MAX || offset < notifyHead || f.read((uint8_t *)text, len) != len) return false;
+      notifyHead = offset;
+      notifyRingAdd(id, text, len, time, false);
+    } else if (type == NOTIFY_REC_READ) {
+      uint32_t id;
+      if (f.read((uint8_t *)&id, 4) != 4) return false;
+      NotifyEntry *e = notifyFindId(id);
+      if (e && !e->read) {
+        e->read = true;
+        notifyUnreadNow--;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif // NOTIFY_PERSIST
+
+// ---------- API ----------
+
+// Carrega o log do boot anterior (se houver)
+static void notifyStoreBegin() {
+#if NOTIFY_PERSIST
+  if (!flashFsMount()) {
+    Serial.println("Notificações: LittleFS indisponível, sem persistência");
+    return;
+  }
+  bool clean = true;
+  size_t size = 0;
+  if (LittleFS.exists(NOTIFY_LOG_PATH)) {
+    File f = LittleFS.open(NOTIFY_LOG_PATH, FILE_READ);
+    size = f.size();
+    clean = notifyLogReplay(f);
+    f.close();
+  } else {
+    clean = false;    // cria o arquivo com o cabeçalho
+  }
+  notifyLogBytes = size;
+  notifyEvicted = 0;
+  // Log truncado (queda de energia) ou grande demais: reescreve o válido
+  if (!clean || size > NOTIFY_LOG_MAX_BYTES) {
+    notifyLogCompact();
+  } else {
+    notifyLog = LittleFS.open(NOTIFY_LOG_PATH, FILE_APPEND);
+  }
+  Serial.printf("Notificações: %u carregadas (%u não lidas), log %u bytes\n",
+                (unsigned)notifyCountNow, (unsigned)notifyUnreadNow, (unsigned)notifyLogBytes);
+#endif
+}
+
+// Adiciona uma notificação; retorna quantas antigas foram descartadas
+static uint16_t notifyStoreAdd(const char *msg, size_t len, const char *time) {
+  uint16_t dropped = notifyRingAdd(notifyNextId, msg, len, time, false);
+#if NOTIFY_PERSIST
+  if (notifyLog) {
+    const NotifyEntry &e = notifyEntry(notifyCountNow - 1);
+    if (notifyLogWriteAdd(notifyLog, e, notifyText(notifyCountNow - 1))) notifyLogBytes += NOTIFY_REC_ADD_BYTES + e.len;
+    notifyLog.flush();
+    if (notifyLogBytes > NOTIFY_LOG_MAX_BYTES) notifyLogCompact();
+  }
+#endif
+  return dropped;
+}
+
+static void notifyMarkRead(uint16_t i) {
+  if (i >= notifyCountNow) return;
+  NotifyEntry &e = notifyEntry(i);
+  if (e.read) return;
+  e.read = true;
+  notifyUnreadNow--;
+#if NOTIFY_PERSIST
+  uint8_t rec[5] = { NOTIFY_REC_READ };
+  memcpy(rec + 1, &e.id, 4);
+  notifyLogAppend(rec, sizeof(rec));
+#endif
+}
+
+static void notifyStoreClear() {
+  notifyRingClear();
+#if NOTIFY_PERSIST
+  if (flashFsMounted()) notifyLogCompact();   // log vazio (só o cabeçalho)
+#endif
+}
+
+#endif // NOTIFY_STORE_H
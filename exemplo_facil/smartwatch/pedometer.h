@@ -0,0 +1,143 @@
+#ifndef PEDOMETER_H
+#define PEDOMETER_H
+
+#include "config.h"
+#include <Arduino.h>
+#include <Preferences.h>
+#include <time.h>
+#include <math.h>
+
+// ==========================================
+// MÓDULO DE PEDÔMETRO - Passos e kcal diários
+// ==========================================
+// Detector em streaming sobre a magnitude da aceleração:
+//   1) passa-alta (remove gravidade com média lenta)
+//   2) passa-baixa (suaviza ruído de mão/vibração)
+//   3) pico acima de limiar adaptativo (fração do envelope) com período refratário
+// Custo fixo por amostra (~15 operações float), sem buffers.
+
+// Estado do detector
+static float pedoGravity = GRAVITY_MS2;
+static float pedoFiltered = 0.0f;
+static float pedoPrev = 0.0f;
+static bool pedoRising = false;
+static float pedoEnvelope = PEDO_MIN_THRESHOLD * 2.0f;
+static unsigned long pedoLastStep = 0;
+
+// Contagem diária e persistência em lote
+static Preferences pedoPrefs;
+static uint32_t pedoStepsToday = 0;
+static uint32_t pedoStepsSaved = 0;
+static uint32_t pedoDayKey = 0;          // AAAAMMDD, 0 se relógio não sincronizado
+static time_t pedoDayEnd = 0;            // meia-noite que encerra pedoDayKey
+static unsigned long pedoLastSave = 0;
+
+// Métricas de custo
+static uint32_t pedoMaxMicros = 0;
+static uint32_t pedoOverBudget = 0;
+
+// Funções públicas
+void pedometerInit();
+void pedometerUpdate(float ax, float ay, float az, unsigned long nowMs);
+void pedometerFlush();
+uint32_t getStepsToday();
+int getKcalToday();
+float getStepsProgress();
+
+// ===== IMPLEMENTAÇÃO =====
+
+// Dia local de now; em dayEnd, o instante da próxima meia-noite
+static uint32_t pedoCurrentDayKey(time_t now, time_t &dayEnd) {
+  if (now < 24 * 3600) return 0; // ainda sem NTP
+  struct tm *t = localtime(&now);
+  dayEnd = now + 24 * 3600 - (t->tm_hour * 3600 + t->tm_min * 60 + t->tm_sec);
+  return (uint32_t)(t->tm_year + 1900) * 10000 + (t->tm_mon + 1) * 100 + t->tm_mday;
+}
+
+void pedometerInit() {
+  pedoPrefs.begin("atividade", false);
+  pedoDayKey = pedoPrefs.getUInt("day", 0);
+  pedoStepsToday = pedoPrefs.getUInt("steps", 0);
+  pedoStepsSaved = pedoStepsToday;
+  pedoLastSave = millis();
+  Serial.printf("Pedometro: %u passos restaurados (dia %u)\n", pedoStepsToday, pedoDayKey);
+}
+
+void pedometerFlush() {
+  if (pedoStepsToday == pedoStepsSaved) return;
+  pedoPrefs.putUInt("day", pedoDayKey);
+  pedoPrefs.putUInt("steps", pedoStepsToday);
+  pedoStepsSaved = pedoStepsToday;
+  pedoLastSave = millis();
+}
+
+// Troca de dia: grava o total anterior e zera o contador. localtime() só roda
+// quando o dia pode ter mudado (getStepsToday() é chamado a cada amostra de
+// telemetria e a cada quadro do watchface)
+static void pedoCheckDay() {
+  time_t now = time(nullptr);
+  if (pedoDayKey != 0 && now < pedoDayEnd) return;
+  time_t dayEnd = 0;
+  uint32_t key = pedoCurrentDayKey(now, dayEnd);
+  if (key == 0) return;
+  pedoDayEnd = dayEnd;
+  if (key == pedoDayKey) return;
+  if (pedoDayKey != 0) {
+    Serial.printf("Pedometro: novo dia, %u passos em %u\n", pedoStepsToday, pedoDayKey);
+    pedoStepsToday = 0;
+  }
+  pedoDayKey = key;
+  pedoStepsSaved = UINT32_MAX; // força gravação do novo dia
+  pedometerFlush();
+}
+
+void pedometerUpdate(float ax, float ay, float az, unsigned long nowMs) {
+  uint32_t t0 = micros();
+
+  float mag = sqrtf(ax * ax + ay * ay + az * az);
+  pedoGravity += PEDO_HP_ALPHA * (mag - pedoGravity);
+  pedoFiltered += PEDO_LP_ALPHA * ((mag - pedoGravity) - pedoFiltered);
+
+  // Envelope decai lentamente; picos o reerguem
+  pedoEnvelope *= PEDO_ENVELOPE_DECAY;
+  if (pedoFiltered > pedoEnvelope) pedoEnvelope = pedoFiltered;
+  float threshold = pedoEnvelope * PEDO_THRESHOLD_RATIO;
+  if (threshold < PEDO_MIN_THRESHOLD) threshold = PEDO_MIN_THRESHOLD;
+
+  // Pico = transição subida -> descida acima do limiar
+  bool rising = pedoFiltered > pedoPrev;
+  if (pedoRising && !rising && pedoPrev > threshold &&
+      nowMs - pedoLastStep >= PEDO_MIN_STEP_MS) {
+    pedoLastStep = nowMs;
+    pedoStepsToday++;
+  }
+  pedoRising = rising;
+  pedoPrev = pedoFiltered;
+
+  uint32_t dt = micros() - t0;
+  if (dt > pedoMaxMicros) pedoMaxMicros = dt;
+  if (dt > PEDO_BUDGET_US) pedoOverBudget++;
+
+  // Persistência em lote: a cada N passos ou intervalo, nunca por passo
+  if (pedoStepsToday - pedoStepsSaved >= PEDO_SAVE_STEPS ||
+      (pedoStepsToday != pedoStepsSaved && nowMs - pedoLastSave >= PEDO_SAVE_INTERVAL_MS)) {
+    pedoCheckDay();
+    pedometerFlush();
+  }
+}
+
+uint32_t getStepsToday() {
+  pedoCheckDay();
+  return pedoStepsToday;
+}
+
+int getKcalToday() {
+  return (int)(pedoStepsToday * PEDO_KCAL_PER_STEP);
+}
+
+float getStepsProgress() {
+  float p = (float)pedoStepsToday / (float)PEDO_DAILY_GOAL;
+  return p > 1.0f ? 1.0f : p;
+}
+
+#endif // PEDOMETER_H
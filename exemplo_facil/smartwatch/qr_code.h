@@ -2,18 +2,23 @@
 #define QR_CODE_H
 
 #include "config.h"
-#include <SPI.h>
 #include <TFT_eSPI.h>
-#include <qrcode_espi.h>
 
 // ==========================================
 // MÓDULO DE QR CODE PARA TFT_eSPI
 // ==========================================
+// Codificador próprio (modo byte, versões 1..QR_MAX_VERSION, níveis L/M/Q/H).
+// A matriz é gerada uma vez por texto e guardada em bits (qrMatrix): abrir
+// a tela de novo só redesenha. A versão é a menor em que o texto cabe e o
+// nível de correção é o maior que ainda cabe nessa versão.
+// QR_MAX_VERSION sai da tela: é o maior símbolo (com a zona de silêncio) em
+// que cada módulo ainda tem QR_MODULE_MIN_PX pixels dentro de QR_AREA_PX.
+// O desenho pinta o fundo claro com um fillRect e os módulos escuros em
+// trechos horizontais (um fillRect por trecho), no mesmo `tft` das telas.
+// Métricas: tempo de codificação e de desenho, separados.
 
 // Estado do QR Code
 extern String qrCodeText;
-extern TFT_eSPI *display;
-extern QRcode_eSPI *qrcode;
 extern bool showWifiCredentials; // true = credenciais Wi-Fi, false = IP de configuração
 
 // Funções públicas
@@ -23,6 +28,7 @@ void setQrcodeText(String text);
 void setQrcodeWifiMode(); // Define modo Wi-Fi
 void setQrcodeIpMode();   // Define modo IP
 void forceQrcodeRedraw(); // Força redesenho da tela QR Code
+int qrMaxBytes();         // Maior texto (bytes) que cabe na tela
 
 // ===== IMPLEMENTAÇÃO =====
 
@@ -35,25 +41,434 @@ enum QrCodeMode {
 
 // Estado global
 String qrCodeText = "https://neurelix.com.br"; // Texto inicial
-TFT_eSPI *display = nullptr;
-QRcode_eSPI *qrcode = nullptr;
 QrCodeMode currentQrMode = QRCODE_CUSTOM; // Modo atual do QR Code
 bool forceRedraw = false; // Flag para forçar redesenho da tela QR Code
+uint32_t qrcodeRev = 0;   // Incrementa a cada pedido de redesenho (agendador)
+
+// ---------- Codificador ----------
+// Níveis de correção em ordem crescente de redundância
+enum QrEcc : uint8_t {
+  QR_ECC_L,
+  QR_ECC_M,
+  QR_ECC_Q,
+  QR_ECC_H
+};
 
-void initQrcode() {
-  // Inicializa display e QR code seguindo o exemplo do usuário
-  if (display == nullptr) {
-    display = new TFT_eSPI();
-    display->begin();
-    display->setRotation(0);
+#define QR_MAX_VERSION (((QR_AREA_PX / QR_MODULE_MIN_PX) - 2 * QR_QUIET_MODULES - 17) / 4)
+static_assert(QR_MAX_VERSION >= 1 && QR_MAX_VERSION <= 40, "QR_AREA_PX/QR_MODULE_MIN_PX fora das versoes do QR");
+#define QR_MAX_SIZE (QR_MAX_VERSION * 4 + 17)
+#define QR_STRIDE ((QR_MAX_SIZE + 7) / 8)                                  // bytes por linha
+#define QR_MAX_CODEWORDS (((16 * QR_MAX_VERSION + 128) * QR_MAX_VERSION + 64) / 8) // limite superior
+
+// Tabelas da norma (ISO/IEC 18004), índice = versão
+static const int8_t QR_ECC_PER_BLOCK[4][41] PROGMEM = {
+  { -1,  7, 10, 15, 20, 26, 18, 20, 24, 30, 18, 20, 24, 26, 30, 22, 24, 28, 30, 28, 28, 28, 28, 30, 30, 26, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30 },
+  { -1, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26, 30, 22, 22, 24, 24, 28, 28, 26, 26, 26, 26, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28 },
+  { -1, 13, 22, 18, 26, 18, 24, 18, 22, 20, 24, 28, 26, 24, 20, 30, 24, 28, 28, 26, 30, 28, 30, 30, 30, 30, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30 },
+  { -1, 17, 28, 22, 16, 22, 28, 26, 26, 24, 28, 24, 28, 22, 24, 24, 30, 28, 28, 26, 28, 30, 24, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30 },
+};
+static const int8_t QR_NUM_BLOCKS[4][41] PROGMEM = {
+  { -1, 1, 1, 1, 1, 1, 2, 2, 2, 2,  4,  4,  4,  4,  4,  6,  6,  6,  6,  7,  8,  8,  9,  9, 10, 12, 12, 12, 13, 14, 15, 16, 17, 18, 19, 19, 20, 21, 22, 24, 25 },
+  { -1, 1, 1, 1, 2, 2, 4, 4, 4, 5,  5,  5,  8,  9,  9, 10, 10, 11, 13, 14, 16, 17, 17, 18, 20, 21, 23, 25, 26, 28, 29, 31, 33, 35, 37, 38, 40, 43, 45, 47, 49 },
+  { -1, 1, 1, 2, 2, 4, 4, 6, 6, 8,  8,  8, 10, 12, 16, 12, 17, 16, 18, 21, 20, 23, 23, 25, 27, 29, 34, 34, 35, 38, 40, 43, 45, 48, 51, 53, 56, 59, 62, 65, 68 },
+  { -1, 1, 1, 2, 4, 4, 4, 5, 6, 8,  8, 11, 11, 16, 16, 18, 16, 19, 21, 25, 25, 25, 34, 30, 32, 35, 37, 40, 42, 45, 48, 51, 54, 57, 60, 63, 66, 70, 74, 77, 81 },
+};
+
+// Matriz pronta: linhas de QR_STRIDE bytes, bit 7 = coluna da esquerda
+struct QrMatrix {
+  uint8_t version;      // 0 = nada codificado
+  uint8_t ecc;
+  uint8_t mask;
+  uint8_t size;
+  uint8_t dark[QR_MAX_SIZE * QR_STRIDE];
+};
+
+static QrMatrix qrMatrix;
+static uint8_t qrFunction[QR_MAX_SIZE * QR_STRIDE];  // padrões fixos (fora da máscara)
+static uint8_t qrData[QR_MAX_CODEWORDS];             // palavras de dados, blocos em sequência
+static uint8_t qrCodewords[QR_MAX_CODEWORDS];        // dados + correção, intercalados
+static uint8_t qrGfExp[512], qrGfLog[256];
+
+// Cache: texto da matriz atual e se coube
+static String qrCachedText;
+static bool qrCachedOk = false;
+
+// Métricas (µs)
+uint32_t qrEncodeMicros = 0;
+uint32_t qrDrawMicros = 0;
+
+static inline bool qrGet(const uint8_t *m, int x, int y) {
+  return m[y * QR_STRIDE + (x >> 3)] & (0x80 >> (x & 7));
+}
+
+static inline void qrPut(uint8_t *m, int x, int y, bool on) {
+  uint8_t &b = m[y * QR_STRIDE + (x >> 3)];
+  if (on) b |= 0x80 >> (x & 7);
+  else b &= ~(0x80 >> (x & 7));
+}
+
+static void qrSetFunction(int x, int y, bool dark) {
+  qrPut(qrMatrix.dark, x, y, dark);
+  qrPut(qrFunction, x, y, true);
+}
+
+// GF(256) com polinômio 0x11D (tabelas feitas uma vez)
+static void qrGfInit() {
+  if (qrGfExp[0]) return;
+  uint16_t x = 1;
+  for (int i = 0; i < 255; i++) {
+    qrGfExp[i] = x;
+    qrGfLog[x] = i;
+    x <<= 1;
+    if (x & 0x100) x ^= 0x11D;
+  }
+  for (int i = 255; i < 512; i++) qrGfExp[i] = qrGfExp[i - 255];
+}
+
+static inline uint8_t qrGfMul(uint8_t a, uint8_t b) {
+  return (a && b) ? qrGfExp[qrGfLog[a] + qrGfLog[b]] : 0;
+}
+
+static int qrEccPerBlock(int ver, int ecc) {
+  return (int8_t)pgm_read_byte(&QR_ECC_PER_BLOCK[ecc][ver]);
+}
+
+static int qrNumBlocks(int ver, int ecc) {
+  return (int8_t)pgm_read_byte(&QR_NUM_BLOCKS[ecc][ver]);
+}
+
+// Módulos livres para dados + correção (sem padrões, formato e versão)
+static int qrRawModules(int ver) {
+  int result = (16 * ver + 128) * ver + 64;
+  if (ver >= 2) {
+    int numAlign = ver / 7 + 2;
+    result -= (25 * numAlign - 10) * numAlign - 55;
+    if (ver >= 7) result -= 36;
+  }
+  return result;
+}
+
+static int qrDataCodewords(int ver, int ecc) {
+  return qrRawModules(ver) / 8 - qrEccPerBlock(ver, ecc) * qrNumBlocks(ver, ecc);
+}
+
+// Bits do contador de caracteres no modo byte
+static int qrCountBits(int ver) {
+  return ver < 10 ? 8 : 16;
+}
+
+int qrMaxBytes() {
+  return (qrDataCodewords(QR_MAX_VERSION, QR_ECC_L) * 8 - 4 - qrCountBits(QR_MAX_VERSION)) / 8;
+}
+
+// Posições dos padrões de alinhamento; retorna quantas
+static int qrAlignmentPositions(int ver, uint8_t *pos) {
+  if (ver == 1) return 0;
+  int numAlign = ver / 7 + 2;
+  int step = (ver == 32) ? 26 : (ver * 4 + numAlign * 2 + 1) / (numAlign * 2 - 2) * 2;
+  pos[0] = 6;
+  for (int i = numAlign - 1, p = ver * 4 + 10; i >= 1; i--, p -= step) pos[i] = p;
+  return numAlign;
+}
+
+static void qrDrawFormatBits(int ecc, int mask) {
+  static const uint8_t ECC_FORMAT[4] = { 1, 0, 3, 2 };   // L, M, Q, H
+  int data = ECC_FORMAT[ecc] << 3 | mask;
+  int rem = data;
+  for (int i = 0; i < 10; i++) rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+  int bits = (data << 10 | rem) ^ 0x5412;
+  int size = qrMatrix.size;
+
+  // Cópia junto ao localizador superior esquerdo
+  for (int i = 0; i <= 5; i++) qrSetFunction(8, i, (bits >> i) & 1);
+  qrSetFunction(8, 7, (bits >> 6) & 1);
+  qrSetFunction(8, 8, (bits >> 7) & 1);
+  qrSetFunction(7, 8, (bits >> 8) & 1);
+  for (int i = 9; i < 15; i++) qrSetFunction(14 - i, 8, (bits >> i) & 1);
+  // Segunda cópia, dividida entre os outros dois localizadores
+  for (int i = 0; i < 8; i++) qrSetFunction(size - 1 - i, 8, (bits >> i) & 1);
+  for (int i = 8; i < 15; i++) qrSetFunction(8, size - 15 + i, (bits >> i) & 1);
+  qrSetFunction(8, size - 8, true);   // módulo sempre escuro
+}
+
+static void qrDrawFunctionPatterns(int ver, int ecc) {
+  int size = qrMatrix.size;
+
+  // Temporização
+  for (int i = 0; i < size; i++) {
+    qrSetFunction(6, i, i % 2 == 0);
+    qrSetFunction(i, 6, i % 2 == 0);
+  }
+
+  // Localizadores (com o separador claro em volta)
+  const int centers[3][2] = { { 3, 3 }, { size - 4, 3 }, { 3, size - 4 } };
+  for (int f = 0; f < 3; f++) {
+    for (int dy = -4; dy <= 4; dy++) {
+      for (int dx = -4; dx <= 4; dx++) {
+        int x = centers[f][0] + dx, y = centers[f][1] + dy;
+        if (x < 0 || y < 0 || x >= size || y >= size) continue;
+        int dist = max(abs(dx), abs(dy));
+        qrSetFunction(x, y, dist != 2 && dist != 4);
+      }
+    }
+  }
+
+  // Alinhamento (menos nos cantos dos localizadores)
+  uint8_t pos[7];
+  int n = qrAlignmentPositions(ver, pos);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if ((i == 0 && j == 0) || (i == 0 && j == n - 1) || (i == n - 1 && j == 0)) continue;
+      for (int dy = -2; dy <= 2; dy++) {
+        for (int dx = -2; dx <= 2; dx++) {
+          qrSetFunction(pos[i] + dx, pos[j] + dy, max(abs(dx), abs(dy)) != 1);
+        }
+      }
+    }
+  }
+
+  // Reserva a área de formato (valor final depois da máscara)
+  qrDrawFormatBits(ecc, 0);
+
+  // Versão (7+)
+  if (ver >= 7) {
+    int rem = ver;
+    for (int i = 0; i < 12; i++) rem = (rem << 1) ^ ((rem >> 11) * 0x1F25);
+    long bits = (long)ver << 12 | rem;
+    for (int i = 0; i < 18; i++) {
+      bool bit = (bits >> i) & 1;
+      int a = size - 11 + i % 3, b = i / 3;
+      qrSetFunction(a, b, bit);
+      qrSetFunction(b, a, bit);
+    }
+  }
+}
+
+// Resto de Reed-Solomon de data pelo gerador de grau degree
+static void qrReedSolomon(const uint8_t *data, int len, int degree, uint8_t *out) {
+  uint8_t gen[30];
+  memset(gen, 0, degree);
+  gen[degree - 1] = 1;
+  uint8_t root = 1;
+  for (int i = 0; i < degree; i++) {
+    for (int j = 0; j < degree; j++) {
+      gen[j] = qrGfMul(gen[j], root);
+      if (j + 1 < degree) gen[j] ^= gen[j + 1];
+    }
+    root = qrGfMul(root, 0x02);
   }
 
-  if (qrcode == nullptr) {
-    qrcode = new QRcode_eSPI(display);
-    qrcode->init();
+  memset(out, 0, degree);
+  for (int i = 0; i < len; i++) {
+    uint8_t factor = data[i] ^ out[0];
+    memmove(out, out + 1, degree - 1);
+    out[degree - 1] = 0;
+    for (int j = 0; j < degree; j++) out[j] ^= qrGfMul(gen[j], factor);
   }
+}
+
+// Divide os dados em blocos, calcula a correção e intercala (como o leitor espera)
+static int qrInterleave(int ver, int ecc) {
+  int numBlocks = qrNumBlocks(ver, ecc);
+  int eccLen = qrEccPerBlock(ver, ecc);
+  int raw = qrRawModules(ver) / 8;
+  int numShort = numBlocks - raw % numBlocks;
+  int shortData = raw / numBlocks - eccLen;
+  int totalData = raw - eccLen * numBlocks;
+
+  uint8_t eccBuf[30];
+  int offset = 0;
+  for (int b = 0; b < numBlocks; b++) {
+    int len = shortData + (b < numShort ? 0 : 1);
+    for (int i = 0; i < len; i++) {
+      int pos = i < shortData ? i * numBlocks + b : shortData * numBlocks + (b - numShort);
+      qrCodewords[pos] = qrData[offset + i];
+    }
+    qrReedSolomon(qrData + offset, len, eccLen, eccBuf);
+    for (int i = 0; i < eccLen; i++) qrCodewords[totalData + i * numBlocks + b] = eccBuf[i];
+    offset += len;
+  }
+  return raw;
+}
+
+// Percorre a matriz em zigue-zague (colunas duplas, de baixo para cima e volta)
+static void qrPlaceCodewords(int count) {
+  int size = qrMatrix.size;
+  int i = 0;
+  for (int right = size - 1; right >= 1; right -= 2) {
+    if (right == 6) right = 5;   // pula a coluna de temporização
+    bool upward = ((right + 1) & 2) == 0;
+    for (int vert = 0; vert < size; vert++) {
+      int y = upward ? size - 1 - vert : vert;
+      for (int j = 0; j < 2; j++) {
+        int x = right - j;
+        if (qrGet(qrFunction, x, y)) continue;
+        bool bit = i < count * 8 && ((qrCodewords[i >> 3] >> (7 - (i & 7))) & 1);
+        qrPut(qrMatrix.dark, x, y, bit);
+        i++;
+      }
+    }
+  }
+}
+
+// Inverte os módulos de dados pela máscara (aplicar duas vezes desfaz)
+static void qrApplyMask(int mask) {
+  int size = qrMatrix.size;
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      if (qrGet(qrFunction, x, y)) continue;
+      bool invert;
+      switch (mask) {
+        case 0:  invert = (x + y) % 2 == 0; break;
+        case 1:  invert = y % 2 == 0; break;
+        case 2:  invert = x % 3 == 0; break;
+        case 3:  invert = (x + y) % 3 == 0; break;
+        case 4:  invert = (x / 3 + y / 2) % 2 == 0; break;
+        case 5:  invert = x * y % 2 + x * y % 3 == 0; break;
+        case 6:  invert = (x * y % 2 + x * y % 3) % 2 == 0; break;
+        default: invert = ((x + y) % 2 + x * y % 3) % 2 == 0; break;
+      }
+      if (invert) qrPut(qrMatrix.dark, x, y, !qrGet(qrMatrix.dark, x, y));
+    }
+  }
+}
+
+// Penalidade da norma: trechos longos, blocos 2x2, falsos localizadores e
+// desequilíbrio claro/escuro. A máscara de menor penalidade é a usada.
+static long qrPenalty() {
+  int size = qrMatrix.size;
+  long penalty = 0;
+  int darkCount = 0;
+
+  for (int pass = 0; pass < 2; pass++) {        // 0 = linhas, 1 = colunas
+    for (int a = 0; a < size; a++) {
+      int run = 0;
+      bool last = false;
+      uint16_t window = 0;   // últimos 15 módulos (1 = escuro); fora da matriz é claro
+      for (int b = 0; b < size + 4; b++) {
+        bool c = b < size && (pass ? qrGet(qrMatrix.dark, a, b) : qrGet(qrMatrix.dark, b, a));
+        if (b < size) {
+          if (pass == 0 && c) darkCount++;
+          if (b > 0 && c == last) {
+            run++;
+          } else {
+            if (run >= 5) penalty += 3 + (run - 5);
+            run = 1;
+          }
+          last = c;
+        }
+        // 1:1:3:1:1 com 4 claros antes ou depois
+        window = ((window << 1) | c) & 0x7FFF;
+        if (((window >> 4) & 0x7F) == 0x5D && ((window & 0xF) == 0 || (window >> 11) == 0)) penalty += 40;
+      }
+      if (run >= 5) penalty += 3 + (run - 5);
+    }
+  }
+
+  for (int y = 0; y + 1 < size; y++) {
+    for (int x = 0; x + 1 < size; x++) {
+      bool c = qrGet(qrMatrix.dark, x, y);
+      if (c == qrGet(qrMatrix.dark, x + 1, y) && c == qrGet(qrMatrix.dark, x, y + 1) &&
+          c == qrGet(qrMatrix.dark, x + 1, y + 1)) penalty += 3;
+    }
+  }
+
+  int total = size * size;
+  penalty += (long)(abs(darkCount * 2 - total) * 10 / total) * 10;
+  return penalty;
+}
+
+// Escreve n bits de value em qrData a partir de bit (zerado antes)
+static void qrPutBits(long &bit, uint32_t value, int n) {
+  for (int i = n - 1; i >= 0; i--, bit++) {
+    if ((value >> i) & 1) qrData[bit >> 3] |= 0x80 >> (bit & 7);
+  }
+}
 
-  Serial.println("QR Code module initialized");
+// Codifica text em modo byte na matriz; false se não couber em QR_MAX_VERSION
+static bool qrEncode(const uint8_t *text, size_t len) {
+  qrGfInit();
+  qrMatrix.version = 0;
+
+  int ver = 0;
+  long bitsNeeded = 0;
+  for (int v = 1; v <= QR_MAX_VERSION && !ver; v++) {
+    bitsNeeded = 4 + qrCountBits(v) + 8L * len;
+    if (bitsNeeded <= qrDataCodewords(v, QR_ECC_L) * 8L) ver = v;
+  }
+  if (!ver) return false;
+  int ecc = QR_ECC_L;
+  for (int e = QR_ECC_M; e <= QR_ECC_H; e++) {
+    if (bitsNeeded <= qrDataCodewords(ver, e) * 8L) ecc = e;
+  }
+
+  // Segmento: modo byte (0100), contador, bytes; terminador e preenchimento
+  int capacity = qrDataCodewords(ver, ecc);
+  memset(qrData, 0, capacity);
+  long bit = 0;
+  qrPutBits(bit, 0x4, 4);
+  qrPutBits(bit, len, qrCountBits(ver));
+  for (size_t i = 0; i < len; i++) qrPutBits(bit, text[i], 8);
+  bit = min(bit + 4, capacity * 8L);
+  for (int i = (bit + 7) / 8, k = 0; i < capacity; i++, k++) qrData[i] = (k & 1) ? 0x11 : 0xEC;
+
+  qrMatrix.size = ver * 4 + 17;
+  memset(qrMatrix.dark, 0, sizeof(qrMatrix.dark));
+  memset(qrFunction, 0, sizeof(qrFunction));
+  qrDrawFunctionPatterns(ver, ecc);
+  qrPlaceCodewords(qrInterleave(ver, ecc));
+
+  int best = 0;
+  long bestPenalty = -1;
+  for (int m = 0; m < 8; m++) {
+    qrApplyMask(m);
+    qrDrawFormatBits(ecc, m);
+    long p = qrPenalty();
+    if (bestPenalty < 0 || p < bestPenalty) {
+      bestPenalty = p;
+      best = m;
+    }
+    qrApplyMask(m);
+  }
+  qrApplyMask(best);
+  qrDrawFormatBits(ecc, best);
+
+  qrMatrix.version = ver;
+  qrMatrix.ecc = ecc;
+  qrMatrix.mask = best;
+  return true;
+}
+
+// Desenha a matriz centrada em (cx, cy): fundo claro + trechos escuros
+static void qrDraw(TFT_eSPI &tft, int cx, int cy) {
+  int size = qrMatrix.size;
+  int px = QR_AREA_PX / (size + 2 * QR_QUIET_MODULES);
+  int side = (size + 2 * QR_QUIET_MODULES) * px;
+  int x0 = cx - side / 2, y0 = cy - side / 2;
+
+  tft.startWrite();
+  tft.fillRect(x0, y0, side, side, TFT_WHITE);
+  x0 += QR_QUIET_MODULES * px;
+  y0 += QR_QUIET_MODULES * px;
+  for (int y = 0; y < size; y++) {
+    const uint8_t *row = qrMatrix.dark + y * QR_STRIDE;
+    int x = 0;
+    while (x < size) {
+      if (!(x & 7) && !row[x >> 3]) { x += 8; continue; }   // 8 claros de uma vez
+      if (!qrGet(qrMatrix.dark, x, y)) { x++; continue; }
+      int end = x + 1;
+      while (end < size && qrGet(qrMatrix.dark, end, y)) end++;
+      tft.fillRect(x0 + x * px, y0 + y * px, (end - x) * px, px, TFT_BLACK);
+      x = end;
+    }
+  }
+  tft.endWrite();
+}
+
+void initQrcode() {
+  // Tabelas do codificador; a matriz sai na primeira vez que a tela abre
+  qrGfInit();
+  Serial.printf("QR Code module initialized (ate versao %d, %d bytes)\n", QR_MAX_VERSION, qrMaxBytes());
 }
 
 void setQrcodeText(String text) {
@@ -83,13 +498,11 @@ void setQrcodeIpMode() {
 
 void forceQrcodeRedraw() {
   forceRedraw = true;
+  qrcodeRev++;
   Serial.println("[QR] Redesenho da tela QR Code forçado");
 }
 
 void renderQrcodeScreen(TFT_eSPI &tft, bool firstRender) {
-  Serial.printf("[QR] renderQrcodeScreen called - firstRender: %s, forceRedraw: %s\n",
-                firstRender ? "true" : "false", forceRedraw ? "true" : "false");
-
   // Só renderiza quando a tela abre pela primeira vez OU quando forçado
   if (!firstRender && !forceRedraw) {
     return; // Não pisca - mantém o conteúdo atual
@@ -98,8 +511,6 @@ void renderQrcodeScreen(TFT_eSPI &tft, bool firstRender) {
   // Reseta a flag de força de redesenho
   forceRedraw = false;
 
-  Serial.println("[QR] ===== RENDERIZANDO TELA QR CODE =====");
-
   // Limpa a tela apenas uma vez
   tft.fillScreen(COLOR_BG);
 
@@ -131,8 +542,6 @@ void renderQrcodeScreen(TFT_eSPI &tft, bool firstRender) {
       tft.setTextFont(1);
       tft.drawString("MODO WIFI", 120, 200);
       tft.drawString("S7=WiFi  S8=IP", 120, 215);
-
-      Serial.println("[QR] Modo Wi-Fi ativo - QR Code para conectar ao Wi-Fi do ESP");
       break;
     }
 
@@ -145,8 +554,6 @@ void renderQrcodeScreen(TFT_eSPI &tft, bool firstRender) {
       tft.setTextFont(1);
       tft.drawString("MODO IP", 120, 200);
       tft.drawString("S7=WiFi  S8=IP", 120, 215);
-
-      Serial.println("[QR] Modo IP ativo - QR Code com IP do ESP");
       break;
     }
 
@@ -163,7 +570,6 @@ void renderQrcodeScreen(TFT_eSPI &tft, bool firstRender) {
         tft.drawString("Use: qrcode|seu_texto", 120, 120);
         tft.drawString("via WebSocket", 120, 135);
         tft.drawString("S7=WiFi  S8=IP", 120, 155);
-        Serial.println("[QR] Modo personalizado - nenhum texto definido");
         return;
       }
 
@@ -171,43 +577,35 @@ void renderQrcodeScreen(TFT_eSPI &tft, bool firstRender) {
       tft.setTextFont(1);
       tft.drawString("QR PERSONALIZADO", 120, 200);
       tft.drawString("S7=WiFi  S8=IP", 120, 215);
-
-      Serial.println("[QR] Modo personalizado ativo");
       break;
     }
   }
 
-  // Gera o QR Code usando a biblioteca
-  if (qrcode == nullptr) {
-    Serial.println("[QR] ERRO: QRcode não inicializado!");
-    tft.setTextColor(TFT_RED);
-    tft.drawString("ERRO: QR Code", 120, 100);
-    tft.drawString("nao inicializado", 120, 120);
-    return;
+  // Codifica só quando o texto muda; a matriz fica guardada
+  if (codeToDisplay != qrCachedText) {
+    uint32_t t0 = micros();
+    qrCachedOk = qrEncode((const uint8_t *)codeToDisplay.c_str(), codeToDisplay.length());
+    qrEncodeMicros = micros() - t0;
+    qrCachedText = codeToDisplay;
+    if (qrCachedOk) {
+      Serial.printf("[QR] payload length=%d -> versao %d-%c (%dx%d), mascara %d, codificado em %uus\n",
+                    codeToDisplay.length(), qrMatrix.version, "LMQH"[qrMatrix.ecc], qrMatrix.size,
+                    qrMatrix.size, qrMatrix.mask, (unsigned)qrEncodeMicros);
+    }
   }
 
-  // Log comprimento do payload antes de gerar
-  Serial.printf("[QR] payload length=%d\n", codeToDisplay.length());
-  Serial.printf("[QR] QR Code (preview 0..30): %s\n", codeToDisplay.substring(0, 30).c_str());
-
-  // Tenta gerar o QR Code (create() retorna void)
-  qrcode->create(codeToDisplay.c_str());
-
-  Serial.println("[QR] create() chamado para gerar o QR Code");
-
-  // Verifica se o QR Code foi realmente criado (pode falhar silenciosamente)
-  if (qrcode != nullptr) {
-    Serial.println("[QR] QR Code criado com sucesso na tela");
-  } else {
-    Serial.println("[QR] ERRO: QRcode object é null");
-
-    // Fallback visual simples
-    tft.setTextColor(TFT_RED);
+  if (!qrCachedOk) {
+    Serial.printf("[QR] ERRO: texto com %d bytes, maximo %d nesta tela\n", codeToDisplay.length(), qrMaxBytes());
+    tft.setTextColor(TFT_RED, COLOR_BG);
     tft.setTextFont(1);
-    tft.drawString("ERRO QR Code", 120, 100);
-    tft.drawRect(60, 60, 120, 120, TFT_RED);
-    tft.fillRect(80, 80, 80, 80, TFT_BLACK);
+    tft.drawString("Texto longo demais", 120, 100);
+    tft.drawString(String(codeToDisplay.length()) + " de " + String(qrMaxBytes()) + " bytes", 120, 120);
+    return;
   }
+
+  uint32_t t0 = micros();
+  qrDraw(tft, 120, 112);
+  qrDrawMicros = micros() - t0;
 }
 
 
@@ -0,0 +1,184 @@
+#ifndef REMOTE_INPUT_H
+#define REMOTE_INPUT_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "ws_queue.h"
+
+// ==========================================
+// CONTROLE REMOTO - sessão + eventos de tecla compactos
+// ==========================================
+// O relógio autentica uma vez por conexão com um frame de texto:
+//   remote_auth|<id>|<segredo>|<sessão>|<versão>
+// e depois envia frames binários só com eventos:
+//   cabeçalho 8 bytes: 'R' 'K', sessão, quantidade, t0 (uint32 LE, millis)
+//   evento 4 bytes:    código (bits 7-6 tipo, 5-0 tecla), seq (uint8),
+//                      dt (uint16 LE, ms desde o evento anterior / t0)
+// Tipos: 0 = down, 1 = up, 2 = repeat. Segurando uma tecla, repeat sai após
+// REMOTE_REPEAT_DELAY_MS e a cada REMOTE_REPEAT_INTERVAL_MS. O desktop
+// reconstrói o "segurar" com down/up e usa seq para detectar perdas.
+// Eventos de uma mesma passada do loop vão num único frame.
+
+enum RemoteKey : uint8_t {
+  RK_NONE = 0,
+  RK_UP, RK_DOWN, RK_LEFT, RK_RIGHT, RK_ENTER, RK_BACKSPACE,
+  RK_NUM_0, RK_NUM_1, RK_NUM_2, RK_NUM_3, RK_NUM_4,
+  RK_NUM_5, RK_NUM_6, RK_NUM_7, RK_NUM_8, RK_NUM_9
+};
+
+enum RemoteEventType : uint8_t {
+  RK_EV_DOWN = 0,
+  RK_EV_UP = 1,
+  RK_EV_REPEAT = 2
+};
+
+#define REMOTE_PROTO_VERSION 1
+#define REMOTE_HEADER_SIZE 8
+#define REMOTE_EVENT_SIZE 4
+
+extern String randomId;
+extern String remoteSecret;
+
+static bool remoteAuthed = false;
+static uint8_t remoteSession = 0;
+static uint8_t remoteSeq = 0;
+static uint32_t remoteLastEventMs = 0;
+
+// Frame em montagem (eventos desta passada)
+static uint8_t remoteFrame[REMOTE_HEADER_SIZE + REMOTE_MAX_EVENTS * REMOTE_EVENT_SIZE];
+static uint8_t remoteFrameCount = 0;
+
+// Teclas seguradas (índice do botão físico -> tecla remota)
+static uint8_t remoteHeldKey[16] = {0};
+static uint32_t remoteNextRepeat[16] = {0};
+
+// Mapeia botão físico -> tecla conforme a página da tela remota
+// Página 1 (setas): S2=CIMA, S5=ESQ, S6=ENTER, S7=DIR, S10=BAIXO
+// Página 2 (numérico): S1..S3=1..3, S5..S7=4..6, S9..S11=7..9, S12=0,
+//                      S4=ENTER, S8=BACKSPACE
+static uint8_t remoteKeyFor(int page, int index) {
+  if (page == 1) {
+    switch (index) {
+      case 1: return RK_UP;
+      case 4: return RK_LEFT;
+      case 5: return RK_ENTER;
+      case 6: return RK_RIGHT;
+      case 9: return RK_DOWN;
+    }
+  } else if (page == 2) {
+    switch (index) {
+      case 0: return RK_NUM_1;
+      case 1: return RK_NUM_2;
+      case 2: return RK_NUM_3;
+      case 4: return RK_NUM_4;
+      case 5: return RK_NUM_5;
+      case 6: return RK_NUM_6;
+      case 8: return RK_NUM_7;
+      case 9: return RK_NUM_8;
+      case 10: return RK_NUM_9;
+      case 11: return RK_NUM_0;
+      case 3: return RK_ENTER;
+      case 7: return RK_BACKSPACE;
+    }
+  }
+  return RK_NONE;
+}
+
+// Só setas repetem (movimento contínuo do cursor)
+static inline bool remoteKeyRepeats(uint8_t key) {
+  return key >= RK_UP && key <= RK_RIGHT;
+}
+
+// Nova sessão na próxima tecla (chamar ao conectar/desconectar); o que
+// ainda estiver na fila não pode sair sob a sessão seguinte
+void remoteSessionReset() {
+  wsQueueDropInput();
+  remoteAuthed = false;
+  remoteFrameCount = 0;
+  memset(remoteHeldKey, 0, sizeof(remoteHeldKey));
+}
+
+static void remoteAuthenticate() {
+  remoteSession = (uint8_t)(esp_random() & 0xFF);
+  remoteSeq = 0;
+  char msg[64];
+  int n = snprintf(msg, sizeof(msg), "remote_auth|%s|%s|%u|%u", randomId.c_str(),
+                   remoteSecret.c_str(), (unsigned)remoteSession, (unsigned)REMOTE_PROTO_VERSION);
+  wsEnqueue(msg, n, WSQ_PRIO_INPUT);
+  remoteAuthed = true;
+  Serial.printf("Remote: sessão %u autenticada\n", (unsigned)remoteSession);
+}
+
+static void remotePushEvent(uint8_t type, uint8_t key) {
+  if (!remoteAuthed) remoteAuthenticate();
+
+  uint32_t now = millis();
+  if (remoteFrameCount == 0) {
+    remoteFrame[0] = 'R';
+    remoteFrame[1] = 'K';
+    remoteFrame[2] = remoteSession;
+    remoteFrame[4] = (uint8_t)(now & 0xFF);
+    remoteFrame[5] = (uint8_t)((now >> 8) & 0xFF);
+    remoteFrame[6] = (uint8_t)((now >> 16) & 0xFF);
+    remoteFrame[7] = (uint8_t)(now >> 24);
+    remoteLastEventMs = now;
+  }
+
+  uint32_t dt = now - remoteLastEventMs;
+  if (dt > 0xFFFF) dt = 0xFFFF;
+  remoteLastEventMs = now;
+
+  uint8_t *ev = remoteFrame + REMOTE_HEADER_SIZE + remoteFrameCount * REMOTE_EVENT_SIZE;
+  ev[0] = (uint8_t)((type << 6) | (key & 0x3F));
+  ev[1] = remoteSeq++;
+  ev[2] = (uint8_t)(dt & 0xFF);
+  ev[3] = (uint8_t)(dt >> 8);
+  remoteFrameCount++;
+
+  if (remoteFrameCount >= REMOTE_MAX_EVENTS) {
+    remoteFrame[3] = remoteFrameCount;
+    wsSendInputBin(remoteFrame, REMOTE_HEADER_SIZE + remoteFrameCount * REMOTE_EVENT_SIZE);
+    remoteFrameCount = 0;
+  }
+}
+
+// Botão físico pressionado na tela remota
+void remoteKeyDown(int index, int page) {
+  uint8_t key = remoteKeyFor(page, index);
+  if (key == RK_NONE || index < 0 || index >= 16) return;
+  remoteHeldKey[index] = key;
+  remoteNextRepeat[index] = millis() + REMOTE_REPEAT_DELAY_MS;
+  remotePushEvent(RK_EV_DOWN, key);
+}
+
+// Botão físico solto (mesmo que a tela tenha mudado)
+void remoteKeyUp(int index) {
+  if (index < 0 || index >= 16 || remoteHeldKey[index] == RK_NONE) return;
+  remotePushEvent(RK_EV_UP, remoteHeldKey[index]);
+  remoteHeldKey[index] = RK_NONE;
+}
+
+bool remoteKeyHeld(int index) {
+  return index >= 0 && index < 16 && remoteHeldKey[index] != RK_NONE;
+}
+
+// Gera repeats e fecha o frame da passada; chamar a cada loop
+void updateRemoteInput() {
+  uint32_t now = millis();
+  for (int i = 0; i < 16; i++) {
+    uint8_t key = remoteHeldKey[i];
+    if (key == RK_NONE || !remoteKeyRepeats(key)) continue;
+    if ((int32_t)(now - remoteNextRepeat[i]) >= 0) {
+      remotePushEvent(RK_EV_REPEAT, key);
+      remoteNextRepeat[i] = now + REMOTE_REPEAT_INTERVAL_MS;
+    }
+  }
+
+  if (remoteFrameCount > 0) {
+    remoteFrame[3] = remoteFrameCount;
+    wsSendInputBin(remoteFrame, REMOTE_HEADER_SIZE + remoteFrameCount * REMOTE_EVENT_SIZE);
+    remoteFrameCount = 0;
+  }
+}
+
+#endif // REMOTE_INPUT_H
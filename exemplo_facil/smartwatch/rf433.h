@@ -89,6 +89,7 @@ char rfBuffer[RF433_BUFFER_SIZE];
 int rfBufferIndex = 0;
 unsigned long lastRFCommand = 0;
 RFCodeLearnedCallback rfCodeLearnedCallback = nullptr;
+uint32_t rf433Rev = 0; // Incrementa a cada resposta do Arduino (telas RF/IR)
 // Cache de códigos IR (subset de rfCodes com proto >= 100)
 static SavedCode irCodesCache[MAX_RF_CODES];
 static int irCodesCountCache = 0;
@@ -184,6 +185,7 @@ void sendRFCommand(const char* cmd) {
 
 void processRFResponse(const char* response) {
   rf433State = RF433_CONNECTED;
+  rf433Rev++;
 
   if (strncmp(response, "OK:", 3) == 0) {
     // Respostas de sucesso
@@ -8,6 +8,7 @@
 extern TFT_eSPI tft;
 extern String randomId;
 extern String remoteSecret;
+void displayInvalidate();
 
 // Estado da página: 0=Info, 1=Setas, 2=Numeros
 static int remotePage = 0;
@@ -142,13 +143,13 @@ void renderRemoteScreen(bool firstRender) {
 void nextRemotePage() {
   remotePage++;
   if (remotePage > 2) remotePage = 0;
-  renderRemoteScreen(false); // Redesenha conteúdo
+  displayInvalidate(); // Redesenha conteúdo no próximo quadro
 }
 
 void prevRemotePage() {
   remotePage--;
   if (remotePage < 0) remotePage = 2;
-  renderRemoteScreen(false); // Redesenha conteúdo
+  displayInvalidate(); // Redesenha conteúdo no próximo quadro
 }
 
 // Getter para o buttons.h saber qual página está ativa
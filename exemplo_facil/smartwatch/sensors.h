@@ -7,6 +7,8 @@
 #include <Adafruit_Sensor.h>
 #include "MAX30105.h"
 #include "spo2_algorithm.h"
+#include "window_stats.h"
+#include "pedometer.h"
 #include <math.h>
 
 // ==========================================
@@ -23,6 +25,12 @@ SensorData sensorData = {0};
 // Buffers MAX30102
 uint32_t irBuf[MAX30102_BUFFER_SIZE];
 uint32_t redBuf[MAX30102_BUFFER_SIZE];
+int hrBufPos = 0;
+
+// Estatísticas incrementais das mesmas janelas (atualizadas por amostra)
+WindowStats irWin;
+WindowStats redWin;
+int hrStepCount = 0;
 
 // Estados MAX30102
 float bpmEMA = -1;
@@ -33,31 +41,46 @@ static byte ledPresentCurrent = MAX30102_LED_BRIGHT_PRESENT;
 // Controle de tempo
 unsigned long lastMPURead = 0;
 
+// Tamanho máximo do JSON de sensores (writeSensorsJSON)
+#define SENSORS_JSON_MAX 256
+
 // Funções públicas
 void initSensors();
 void updateSensors();
 SensorData getSensorData();
 void toggleHRSensor(bool on);
 String getSensorsJSON();
+size_t writeSensorsJSON(char *buf, size_t cap);
 
 // Funções auxiliares MAX30102
 struct Stats { uint32_t mean, pp; };
 static inline Stats statsOf(const uint32_t *v, int n);
+static inline Stats statsOf(const WindowStats &w);
 static inline bool fingerPresent(const uint32_t *ir, int n, uint32_t &meanOut, uint32_t &ppOut);
+static inline bool fingerPresent(const WindowStats &ir, uint32_t &meanOut, uint32_t &ppOut);
 static inline bool qualityOK(const Stats& ir, const Stats& rd);
+static void pushHrSample(uint32_t red, uint32_t ir);
+static void resetHrWindows();
 static int estimateHrFromIR(const uint32_t *ir, int n, float sampleRate, uint32_t mean, float rms);
 
 // ===== IMPLEMENTAÇÃO =====
 
 Stats statsOf(const uint32_t *v, int n) {
-  uint32_t mn = UINT32_MAX, mx = 0, sum = 0;
+  uint32_t mn = UINT32_MAX, mx = 0;
+  uint64_t sum = 0;
   for (int i = 0; i < n; i++) {
     uint32_t x = v[i];
     if (x < mn) mn = x;
     if (x > mx) mx = x;
     sum += x;
   }
-  Stats s; s.mean = sum / (float)n; s.pp = mx - mn;
+  Stats s; s.mean = (uint32_t)(sum / (uint64_t)n); s.pp = mx - mn;
+  return s;
+}
+
+// Mesma métrica, mas lida da janela incremental em O(1)
+Stats statsOf(const WindowStats &w) {
+  Stats s; s.mean = windowStatsMean(w); s.pp = windowStatsPP(w);
   return s;
 }
 
@@ -68,6 +91,13 @@ bool fingerPresent(const uint32_t *ir, int n, uint32_t &meanOut, uint32_t &ppOut
   return (meanOut > MAX30102_IR_MEAN_MIN) && (ppOut > MAX30102_IR_PP_MIN);
 }
 
+bool fingerPresent(const WindowStats &ir, uint32_t &meanOut, uint32_t &ppOut) {
+  Stats s = statsOf(ir);
+  meanOut = s.mean;
+  ppOut = s.pp;
+  return (meanOut > MAX30102_IR_MEAN_MIN) && (ppOut > MAX30102_IR_PP_MIN);
+}
+
 bool qualityOK(const Stats& ir, const Stats& rd) {
   float rIR = (ir.mean > 0) ? (float)ir.pp / (float)ir.mean : 0.f;
   float rRD = (rd.mean > 0) ? (float)rd.pp / (float)rd.mean : 0.f;
@@ -83,6 +113,45 @@ bool qualityOK(const Stats& ir, const Stats& rd) {
   return irOK && rdOK;
 }
 
+void resetHrWindows() {
+  windowStatsReset(irWin);
+  windowStatsReset(redWin);
+  hrBufPos = 0;
+  hrStepCount = 0;
+}
+
+// Alimenta buffers e janelas com uma amostra; presença/qualidade em O(1)
+void pushHrSample(uint32_t red, uint32_t ir) {
+  irBuf[hrBufPos] = ir;
+  redBuf[hrBufPos] = red;
+  hrBufPos = (hrBufPos + 1) % MAX30102_BUFFER_SIZE;
+  windowStatsPush(irWin, ir);
+  windowStatsPush(redWin, red);
+
+  uint32_t mean, pp;
+  bool present = fingerPresent(irWin, mean, pp);
+  sensorData.irMean = mean;
+  sensorData.irPP = pp;
+  sensorData.acdc = mean > 0 ? (float)pp / (float)mean : 0.f;
+  sensorData.fingerPresent = present && windowStatsFull(irWin) &&
+                             qualityOK(statsOf(irWin), statsOf(redWin));
+
+  // Ausência contada por passo da janela deslizante (~1s)
+  if (++hrStepCount < MAX30102_STEP_SIZE) return;
+  hrStepCount = 0;
+  if (present) {
+    absenceCount = 0;
+  } else if (++absenceCount >= ABSENCE_RESET_WINDOWS) {
+    absenceCount = 0;
+    bpmEMA = -1;
+    spo2EMA = -1;
+    sensorData.bpm = -1;
+    sensorData.spo2 = -1;
+    resetHrWindows();
+  }
+  sensorData.absenceCount = absenceCount;
+}
+
 void initSensors() {
   // Inicializa MPU6050
   Serial.println("Inicializando MPU6050...");
@@ -91,6 +160,7 @@ void initSensors() {
     mpu.setGyroRange(MPU6050_RANGE_500_DEG);
     mpu.setFilterBandwidth(MPU6050_BAND_21_HZ);
     sensorData.mpuAvailable = true;
+    pedometerInit();
     Serial.println("MPU6050 inicializado!");
   } else {
     sensorData.mpuAvailable = false;
@@ -124,12 +194,16 @@ void updateSensors() {
     sensorData.tempMPU = temp.temperature;
     
     lastMPURead = millis();
+    pedometerUpdate(a.acceleration.x, a.acceleration.y, a.acceleration.z, lastMPURead);
   }
 
-  // Atualiza MAX30102 (modo não-bloqueante)
+  // Atualiza MAX30102 (modo não-bloqueante): drena a FIFO sem esperar
   if (sensorData.hrActive) {
-    // TODO: Implementar leitura não-bloqueante com janela deslizante
-    // Por enquanto, apenas placeholder
+    hrSensor.check();
+    while (hrSensor.available()) {
+      pushHrSample(hrSensor.getFIFORed(), hrSensor.getFIFOIR());
+      hrSensor.nextSample();
+    }
   }
 }
 
@@ -139,6 +213,7 @@ SensorData getSensorData() {
 
 void toggleHRSensor(bool on) {
   sensorData.hrActive = on;
+  resetHrWindows();
   if (on) {
     hrSensor.setPulseAmplitudeRed(MAX30102_LED_BRIGHT_PRESENT);
     hrSensor.setPulseAmplitudeIR(MAX30102_LED_BRIGHT_PRESENT);
@@ -150,21 +225,31 @@ void toggleHRSensor(bool on) {
   }
 }
 
+// Escreve o JSON dos sensores direto no buffer do chamador (sem heap).
+// Retorna o tamanho escrito, ou 0 se não coube.
+size_t writeSensorsJSON(char *buf, size_t cap) {
+  const SensorData &d = sensorData;
+  int n = snprintf(buf, cap,
+    "{\"mpu\":{\"available\":%s,"
+    "\"accel\":{\"x\":%.2f,\"y\":%.2f,\"z\":%.2f},"
+    "\"gyro\":{\"x\":%.2f,\"y\":%.2f,\"z\":%.2f},"
+    "\"temp\":%.2f},"
+    "\"steps\":%u,\"kcal\":%d,"
+    "\"hr\":{\"bpm\":%d,\"spo2\":%d,\"finger\":%s}}",
+    d.mpuAvailable ? "true" : "false",
+    d.accelX, d.accelY, d.accelZ,
+    d.gyroX, d.gyroY, d.gyroZ,
+    d.tempMPU,
+    (unsigned)getStepsToday(), getKcalToday(),
+    d.bpm, d.spo2, d.fingerPresent ? "true" : "false");
+  if (n < 0 || (size_t)n >= cap) return 0;
+  return (size_t)n;
+}
+
 String getSensorsJSON() {
-  String json = "{";
-  json += "\"mpu\":{";
-  json += "\"available\":" + String(sensorData.mpuAvailable ? "true" : "false") + ",";
-  json += "\"accel\":{\"x\":" + String(sensorData.accelX) + ",\"y\":" + String(sensorData.accelY) + ",\"z\":" + String(sensorData.accelZ) + "},";
-  json += "\"gyro\":{\"x\":" + String(sensorData.gyroX) + ",\"y\":" + String(sensorData.gyroY) + ",\"z\":" + String(sensorData.gyroZ) + "},";
-  json += "\"temp\":" + String(sensorData.tempMPU);
-  json += "},";
-  json += "\"hr\":{";
-  json += "\"bpm\":" + String(sensorData.bpm) + ",";
-  json += "\"spo2\":" + String(sensorData.spo2) + ",";
-  json += "\"finger\":" + String(sensorData.fingerPresent ? "true" : "false");
-  json += "}";
-  json += "}";
-  return json;
+  char buf[SENSORS_JSON_MAX];
+  size_t n = writeSensorsJSON(buf, sizeof(buf));
+  return n ? String(buf) : String("{}");
 }
 
 #endif // SENSORS_H
@@ -5,6 +5,8 @@
 #include "buttons.h"
 #include "display_tft.h"
 #include "qr_code.h"
+#include "telemetry.h"
+#include "ws_router.h"
 
 // Variáveis globais (definidas em network.h)
 String ssid;
@@ -17,117 +19,250 @@ WebServer server(80);
 WebSocketsClient webSocket;
 DNSServer dnsServer;
 
+// Tempo do boot até o primeiro quadro da tela principal (ms)
+unsigned long firstFrameMs = 0;
+
+// ==========================================
+// HANDLERS DE COMANDOS WEBSOCKET
+// ==========================================
+// Cada handler recebe os argumentos após o separador (view sobre o payload).
+
+static void cmdLimpar(StrView) {
+  // Direto: o reinício abaixo não deixaria a fila esvaziar
+  webSocket.sendTXT("Credenciais Wi-Fi apagadas. Reiniciando...");
+  preferences.remove("ssid");
+  preferences.remove("password");
+  preferences.remove("email");
+  preferences.end();
+  WiFi.disconnect(true, true);
+  delay(1000);
+  ESP.restart();
+}
+
+static void cmdStreamOn(StrView) {
+  startStreaming();
+  wsSendStatus(WSQ_KEY_STREAM, "streaming_on");
+}
+
+static void cmdStreamOff(StrView) {
+  stopStreaming();
+  wsSendStatus(WSQ_KEY_STREAM, "streaming_off");
+}
+
+static void cmdAudioStats(StrView) {
+  char stats[96];
+  snprintf(stats, sizeof(stats), "audio_stats|%u|%u|%u|%s|%u|%u|%u|%u",
+           (unsigned)getAudioSampleRate(), (unsigned)getAudioDroppedBuffers(), (unsigned)streamChunkIdx,
+           audioCodecName(audioCodec), (unsigned)audioEncodeMicros, (unsigned)audioWireRate,
+           (unsigned)audioChunksSent, (unsigned)audioChunksSuppressed);
+  wsSend(stats);
+}
+
+#if AUDIO_RECORD_ENABLED
+// audio|<segundos> - grava clipe e envia em seguida (clip_start/clip/clip_end)
+static void cmdAudio(StrView args) {
+  long secs = args.empty() ? RECORD_SECONDS : args.toInt();
+  if (secs <= 0 || secs > AUDIO_CLIP_FLASH_SECONDS) {
+    wsSend("ERRO: duracao invalida");
+    return;
+  }
+  char msg[48];
+  if (startRecording((uint32_t)secs)) {
+    snprintf(msg, sizeof(msg), "gravando|%u|%s", (unsigned)secs, clipStorageName());
+    wsSend(msg);
+  } else {
+    wsSend("ERRO: gravacao indisponivel");
+  }
+}
+#endif
+
+static void cmdVadOn(StrView) {
+  setAudioVad(true);
+  wsSendStatus(WSQ_KEY_VAD, "vad_on");
+}
+
+static void cmdVadOff(StrView) {
+  setAudioVad(false);
+  wsSendStatus(WSQ_KEY_VAD, "vad_off");
+}
+
+static void cmdAudioCodec(StrView args) {
+  AudioCodec codec;
+  if (args.equals("pcm8")) codec = AUDIO_CODEC_PCM8;
+  else if (args.equals("ulaw")) codec = AUDIO_CODEC_ULAW;
+  else if (args.equals("adpcm")) codec = AUDIO_CODEC_ADPCM;
+  else {
+    wsSend("Codec invalido: " + args.toString());
+    return;
+  }
+  if (!setAudioCodec(codec)) {
+    wsSend("ERRO: codec fixo durante a gravacao");
+    return;
+  }
+  char msg[24];
+  snprintf(msg, sizeof(msg), "audio_codec|%s", audioCodecName(audioCodec));
+  wsSendStatus(WSQ_KEY_CODEC, msg);
+}
+
+static void cmdSensors(StrView) {
+  char json[SENSORS_JSON_MAX];
+  if (writeSensorsJSON(json, sizeof(json))) wsSendStatus(WSQ_KEY_SENSORS, json);
+}
+
+// telemetry_on|<ms> - frames binários com TELEMETRY_BATCH amostras
+static void cmdTelemetryOn(StrView args) {
+  unsigned long interval = args.empty() ? TELEMETRY_INTERVAL_MS : args.toInt();
+  startTelemetry(interval);
+  wsSendStatus(WSQ_KEY_TELEMETRY, "telemetry_on");
+}
+
+static void cmdTelemetryOff(StrView) {
+  stopTelemetry();
+  wsSendStatus(WSQ_KEY_TELEMETRY, "telemetry_off");
+}
+
+// Comando de ping - apenas responde, não adiciona notificação
+static void cmdPing(StrView) {
+  wsSend("pong");
+}
+
+// rf_send:1 - envia código RF #1
+static void cmdRfSend(StrView args) {
+  int index = args.toInt();
+  char msg[40];
+  snprintf(msg, sizeof(msg), sendRFCode(index) ? "RF: Enviando código #%d" : "RF: Código inválido #%d", index);
+  wsSend(msg);
+}
+
+// Lista códigos RF salvos
+static void cmdRfList(StrView) {
+  if (listRFCodes()) {
+    char msg[40];
+    snprintf(msg, sizeof(msg), "RF: Listando códigos (%d)", getRFCodesCount());
+    wsSend(msg);
+  } else {
+    wsSend("RF: Erro ao listar códigos");
+  }
+}
+
+// Limpa lista de códigos RF
+static void cmdRfClear(StrView) {
+  if (clearRFCodes()) {
+    wsSend("RF: Limpando lista de códigos");
+  } else {
+    wsSend("RF: Erro ao limpar lista");
+  }
+}
+
+// Entra em modo aprendizado
+static void cmdRfLearn(StrView) {
+  if (learnRFCode()) {
+    wsSend("RF: Entrando em modo aprendizado");
+  } else {
+    wsSend("RF: Erro ao iniciar aprendizado");
+  }
+}
+
+// Status da comunicação RF433
+static void cmdRfStatus(StrView) {
+  char msg[48];
+  if (isRF433Connected()) {
+    snprintf(msg, sizeof(msg), "RF: Conectado (%d códigos)", getRFCodesCount());
+  } else {
+    snprintf(msg, sizeof(msg), "RF: Desconectado");
+  }
+  wsSendStatus(WSQ_KEY_RF_STATUS, msg);
+}
+
+// watchface|1 (passos/kcal) ou watchface|3 (barras curvas)
+static void cmdWatchface(StrView args) {
+  int wf = args.toInt();
+  if (wf == 1 || wf == 3) {
+    currentWatchFace = wf;
+    firstRender = true;
+    char msg[24];
+    snprintf(msg, sizeof(msg), "Watchface: V%d", wf);
+    wsSendStatus(WSQ_KEY_WATCHFACE, msg);
+  } else {
+    wsSend("Watchface invalida: " + args.toString());
+  }
+}
+
+// Define texto do QR Code: qrcode|texto_aqui
+static void cmdQrcode(StrView args) {
+  StrView qr = args.trimmed(); // remove CR/LF e espaços indesejados nas bordas
+
+  // Limite da maior versão de QR que a tela resolve (qr_code.h)
+  const size_t QR_MAX_LEN = qrMaxBytes();
+  if (qr.n > QR_MAX_LEN) {
+    char err[96];
+    snprintf(err, sizeof(err), "ERRO: QR Code muito longo (len=%u, max=%u) - não exibido",
+             (unsigned)qr.n, (unsigned)QR_MAX_LEN);
+    wsSend(err);
+  } else {
+    String qrText = qr.toString();
+    setQrcodeText(qrText);
+    wsSendStatus(WSQ_KEY_QRCODE, "QR Code atualizado: " + qrText);
+  }
+}
+
+// Ordenada por nome (busca binária); a ordem é verificada em compilação.
+static constexpr WsCommand WS_COMMANDS[] = {
+#if AUDIO_RECORD_ENABLED
+  { "audio",         '|', WS_ARGS_OPTIONAL, cmdAudio },
+#endif
+  { "audio_codec",   '|', WS_ARGS_REQUIRED, cmdAudioCodec },
+  { "audio_stats",   '|', WS_ARGS_NONE,     cmdAudioStats },
+  { "limpar",        '|', WS_ARGS_NONE,     cmdLimpar },
+  { "ping",          '|', WS_ARGS_NONE,     cmdPing },
+  { "qrcode",        '|', WS_ARGS_REQUIRED, cmdQrcode },
+  { "rf_clear",      '|', WS_ARGS_NONE,     cmdRfClear },
+  { "rf_learn",      '|', WS_ARGS_NONE,     cmdRfLearn },
+  { "rf_list",       '|', WS_ARGS_NONE,     cmdRfList },
+  { "rf_send",       ':', WS_ARGS_REQUIRED, cmdRfSend },
+  { "rf_status",     '|', WS_ARGS_NONE,     cmdRfStatus },
+  { "sensors",       '|', WS_ARGS_NONE,     cmdSensors },
+  { "stream_off",    '|', WS_ARGS_NONE,     cmdStreamOff },
+  { "stream_on",     '|', WS_ARGS_NONE,     cmdStreamOn },
+  { "telemetry_off", '|', WS_ARGS_NONE,     cmdTelemetryOff },
+  { "telemetry_on",  '|', WS_ARGS_OPTIONAL, cmdTelemetryOn },
+  { "vad_off",       '|', WS_ARGS_NONE,     cmdVadOff },
+  { "vad_on",        '|', WS_ARGS_NONE,     cmdVadOn },
+  { "watchface",     '|', WS_ARGS_REQUIRED, cmdWatchface },
+};
+#define WS_COMMAND_COUNT (sizeof(WS_COMMANDS) / sizeof(WS_COMMANDS[0]))
+static_assert(wsTableSorted(WS_COMMANDS, WS_COMMAND_COUNT), "WS_COMMANDS deve estar em ordem alfabetica");
+
 void handleWebSocketEvent(WStype_t type, uint8_t * payload, size_t length) {
   switch (type) {
     case WStype_DISCONNECTED:
       Serial.println("Desconectado do servidor WebSocket");
+      wsQueueDropStale();
+      remoteSessionReset();
       break;
     case WStype_CONNECTED:
-      Serial.println("Conectado ao servidor WebSocket");
+      Serial.printf("Conectado ao servidor WebSocket (%lums após boot)\n", millis());
+      remoteSessionReset();
       {
         String identificador = ssid + "|" + password + "|" + emailLogin + "|" + randomId;
         webSocket.sendTXT(identificador);
       }
       break;
-    case WStype_TEXT:
-      Serial.printf("Comando WS recebido (bytes=%u)\n", (unsigned)length);
-      // Cria String com tamanho conhecido para preservar qualquer byte (sem truncar em NULs)
-      String cmd = String((char*)payload, length);
-      Serial.printf("Cmd (len=%d): '%s'\n", cmd.length(), cmd.c_str());
-      // Loga últimos bytes em hex para diagnosticar truncamento/bytes invisíveis
-      {
-        int startIdx = (int)length - 16;
-        if (startIdx < 0) startIdx = 0;
-        Serial.print("Últimos bytes (hex): ");
-        for (size_t i = startIdx; i < length; ++i) {
-          Serial.printf("%02X ", (unsigned)payload[i]);
-        }
-        Serial.println();
-      }
-
-      // Filtra comandos conhecidos vs mensagens
-      if (cmd == "limpar") {
-        webSocket.sendTXT("Credenciais Wi-Fi apagadas. Reiniciando...");
-        preferences.remove("ssid");
-        preferences.remove("password");
-        preferences.remove("email");
-        preferences.end();
-        WiFi.disconnect(true, true);
-        delay(1000);
-        ESP.restart();
-      } else if (cmd == "stream_on") {
-        startStreaming();
-        webSocket.sendTXT("streaming_on");
-      } else if (cmd == "stream_off") {
-        stopStreaming();
-        webSocket.sendTXT("streaming_off");
-      } else if (cmd == "ping") {
-        // Comando de ping - apenas responde, não adiciona notificação
-        webSocket.sendTXT("pong");
-      } else if (cmd.startsWith("rf_send:")) {
-        // rf_send:1 - envia código RF #1
-        int index = cmd.substring(8).toInt();
-        if (sendRFCode(index)) {
-          webSocket.sendTXT("RF: Enviando código #" + String(index));
-        } else {
-          webSocket.sendTXT("RF: Código inválido #" + String(index));
-        }
-      } else if (cmd == "rf_list") {
-        // Lista códigos RF salvos
-        if (listRFCodes()) {
-          String response = "RF: Listando códigos (";
-          response += String(getRFCodesCount()) + ")";
-          webSocket.sendTXT(response);
-        } else {
-          webSocket.sendTXT("RF: Erro ao listar códigos");
-        }
-      } else if (cmd == "rf_clear") {
-        // Limpa lista de códigos RF
-        if (clearRFCodes()) {
-          webSocket.sendTXT("RF: Limpando lista de códigos");
-        } else {
-          webSocket.sendTXT("RF: Erro ao limpar lista");
-        }
-      } else if (cmd == "rf_learn") {
-        // Entra em modo aprendizado
-        if (learnRFCode()) {
-          webSocket.sendTXT("RF: Entrando em modo aprendizado");
-        } else {
-          webSocket.sendTXT("RF: Erro ao iniciar aprendizado");
-        }
-      } else if (cmd == "rf_status") {
-        // Status da comunicação RF433
-        String status = "RF: ";
-        if (isRF433Connected()) {
-          status += "Conectado (" + String(getRFCodesCount()) + " códigos)";
-        } else {
-          status += "Desconectado";
-        }
-        webSocket.sendTXT(status);
-      } else if (cmd.startsWith("qrcode|")) {
-        // Comando para definir texto do QR Code: qrcode|texto_aqui
-        String qrText = cmd.substring(7); // Remove "qrcode|"
-        qrText.trim(); // remove CR/LF e espaços indesejados nas bordas
-        Serial.printf("QR recebido após trim (len=%d): '%s'\n", qrText.length(), qrText.c_str());
-
-        // Limite conhecido do renderer (testado): 154 caracteres
-        const int QR_MAX_LEN = 154;
-        if (qrText.length() > QR_MAX_LEN) {
-          String err = "ERRO: QR Code muito longo (len=" + String(qrText.length()) + ", max=" + String(QR_MAX_LEN) + ") - não exibido";
-          webSocket.sendTXT(err);
-          Serial.println(err);
-        } else {
-          setQrcodeText(qrText);
-          webSocket.sendTXT("QR Code atualizado: " + qrText);
-          Serial.println("QR Code definido via WebSocket: " + qrText);
-        }
-      } else {
+    case WStype_TEXT: {
+      uint32_t receivedUs = micros(); // Início da latência do toast
+      wsLogFrame(payload, length);
+      if (!wsDispatch(WS_COMMANDS, WS_COMMAND_COUNT, (const char *)payload, length)) {
         // Se não é um comando conhecido, trata como mensagem/notificação
-        addNotification(cmd);
-        webSocket.sendTXT("Mensagem recebida: " + cmd);
-        Serial.println("Mensagem adicionada às notificações: " + cmd);
+        // (String com tamanho conhecido para preservar qualquer byte)
+        String msg = String((const char *)payload, length);
+        addNotification(msg, receivedUs);
+        wsSendStatus(WSQ_KEY_ECHO, "Mensagem recebida: " + msg);
+        Serial.println("Mensagem adicionada às notificações: " + msg);
       }
       break;
+    }
+    default:
+      break;
   }
 }
 
@@ -150,10 +285,8 @@ void setup() {
   initNetwork();
   initRF433();
   
-  showMessage("Sistema pronto!");
-  delay(1000);
-  
-  Serial.println("Sistema inicializado!");
+  // Rede continua em segundo plano (updateNetwork); a UI já pode rodar
+  Serial.printf("Sistema inicializado! (%lums após boot)\n", millis());
 }
 
 void loop() {
@@ -161,8 +294,16 @@ void loop() {
   updateSensors();
   updateButtons();
   updateAudio();
+  updateTelemetry();
+  updateClock();
   updateDisplay();
   updateRF433();
 
-  delay(10);
+  if (firstFrameMs == 0) {
+    firstFrameMs = millis();
+    Serial.printf("Primeiro quadro em %lums após boot\n", firstFrameMs);
+  }
+
+  // Dorme até o próximo quadro (no máximo DISPLAY_MAX_SLEEP_MS)
+  delay(displaySleepMs(DISPLAY_MAX_SLEEP_MS));
 }
@@ -0,0 +1,133 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "config.h"
+#include <Arduino.h>
+#include <WebSocketsClient.h>
+#include "sensors.h"
+
+extern WebSocketsClient webSocket;
+
+// ==========================================
+// MÓDULO DE TELEMETRIA - Stream binário de sensores
+// ==========================================
+// Amostra SensorData a uma taxa configurável, empacota cada amostra num
+// registro binário fixo (little-endian) e envia TELEMETRY_BATCH registros
+// por frame binário WebSocket. Substitui getSensorsJSON() no envio contínuo:
+// 30 bytes por amostra contra ~230 do JSON, sem String temporária.
+//
+// Frame: [TelemetryHeader][TelemetryRecord x count]
+
+#define TELEMETRY_MAGIC 0x4D4C4554UL  // "TELM"
+#define TELEMETRY_VERSION 1
+
+// Flags do registro
+#define TLM_FLAG_MPU    0x01
+#define TLM_FLAG_FINGER 0x02
+#define TLM_FLAG_HR     0x04
+
+struct __attribute__((packed)) TelemetryHeader {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t recordSize;
+  uint16_t count;
+  uint32_t seq;        // número do frame
+};
+
+struct __attribute__((packed)) TelemetryRecord {
+  uint32_t tMs;        // millis() da amostra
+  int16_t accel[3];    // m/s² x100
+  int16_t gyro[3];     // rad/s x1000
+  int16_t tempC;       // °C x100
+  int16_t bpm;         // -1 se inválido
+  int8_t spo2;         // -1 se inválido
+  uint8_t flags;       // TLM_FLAG_*
+  uint32_t irMean;
+  uint32_t steps;
+};
+
+// Estado
+static uint8_t tlmFrame[sizeof(TelemetryHeader) + TELEMETRY_BATCH * sizeof(TelemetryRecord)];
+static int tlmCount = 0;
+static uint32_t tlmSeq = 0;
+static bool tlmActive = false;
+static unsigned long tlmIntervalMs = TELEMETRY_INTERVAL_MS;
+static unsigned long tlmLastSample = 0;
+
+// Funções públicas
+void startTelemetry(unsigned long intervalMs);
+void stopTelemetry();
+bool isTelemetryActive();
+void updateTelemetry();
+
+// ===== IMPLEMENTAÇÃO =====
+
+static inline int16_t tlmClamp16(float v) {
+  if (v > 32767.0f) return 32767;
+  if (v < -32768.0f) return -32768;
+  return (int16_t)lroundf(v);
+}
+
+static void tlmPack(TelemetryRecord &r, const SensorData &d, unsigned long nowMs) {
+  r.tMs = nowMs;
+  r.accel[0] = tlmClamp16(d.accelX * 100.0f);
+  r.accel[1] = tlmClamp16(d.accelY * 100.0f);
+  r.accel[2] = tlmClamp16(d.accelZ * 100.0f);
+  r.gyro[0] = tlmClamp16(d.gyroX * 1000.0f);
+  r.gyro[1] = tlmClamp16(d.gyroY * 1000.0f);
+  r.gyro[2] = tlmClamp16(d.gyroZ * 1000.0f);
+  r.tempC = tlmClamp16(d.tempMPU * 100.0f);
+  r.bpm = (int16_t)d.bpm;
+  r.spo2 = (int8_t)d.spo2;
+  r.flags = (d.mpuAvailable ? TLM_FLAG_MPU : 0) |
+            (d.fingerPresent ? TLM_FLAG_FINGER : 0) |
+            (d.hrActive ? TLM_FLAG_HR : 0);
+  r.irMean = d.irMean;
+  r.steps = getStepsToday();
+}
+
+static void tlmFlush() {
+  if (tlmCount == 0) return;
+  TelemetryHeader *h = (TelemetryHeader *)tlmFrame;
+  h->magic = TELEMETRY_MAGIC;
+  h->version = TELEMETRY_VERSION;
+  h->recordSize = sizeof(TelemetryRecord);
+  h->count = tlmCount;
+  h->seq = tlmSeq++;
+  webSocket.sendBIN(tlmFrame, sizeof(TelemetryHeader) + tlmCount * sizeof(TelemetryRecord));
+  tlmCount = 0;
+}
+
+void startTelemetry(unsigned long intervalMs) {
+  if (intervalMs < TELEMETRY_MIN_INTERVAL_MS) intervalMs = TELEMETRY_MIN_INTERVAL_MS;
+  tlmIntervalMs = intervalMs;
+  tlmCount = 0;
+  tlmActive = true;
+  tlmLastSample = millis();
+  Serial.printf("Telemetria iniciada (%lums, %d amostras/frame)\n", tlmIntervalMs, TELEMETRY_BATCH);
+}
+
+void stopTelemetry() {
+  tlmFlush();
+  tlmActive = false;
+  Serial.println("Telemetria parada");
+}
+
+bool isTelemetryActive() {
+  return tlmActive;
+}
+
+void updateTelemetry() {
+  if (!tlmActive) return;
+  unsigned long now = millis();
+  if (now - tlmLastSample < tlmIntervalMs) return;
+  tlmLastSample = now;
+
+  TelemetryRecord *recs = (TelemetryRecord *)(tlmFrame + sizeof(TelemetryHeader));
+  tlmPack(recs[tlmCount++], sensorData, now);
+  if (tlmCount >= TELEMETRY_BATCH) {
+    tlmFlush();
+  }
+}
+
+#endif // TELEMETRY_H
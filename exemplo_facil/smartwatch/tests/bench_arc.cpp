@@ -0,0 +1,197 @@
+// Arcos por linhas: forma, emenda de trechos, delta == desenho inteiro e custo
+// contra o carimbo de círculos anterior
+#include "test_util.h"
+#include "WatchFace.h"
+#include "widgets.h"
+
+// drawThickArc anterior: um fillCircle por grau inteiro
+static void legacyThickArc(TFT_eSPI &tft, int cx, int cy, int r, int thickness,
+                           float a0_deg, float a1_deg, uint16_t color) {
+  if (a1_deg < a0_deg) { float t = a0_deg; a0_deg = a1_deg; a1_deg = t; }
+  int rad = thickness / 2;
+  for (int a = (int)a0_deg; a <= (int)a1_deg; a++) {
+    float ar = a * (PI / 180.0f);
+    int x = cx + (int)roundf(cosf(ar) * r);
+    int y = cy + (int)roundf(sinf(ar) * r);
+    tft.fillCircle(x, y, rad, color);
+  }
+}
+
+static void legacyArcProgress(TFT_eSPI &tft, int cx, int cy, int r, int thickness,
+                              float start_deg, float end_deg, float progress01,
+                              uint16_t bg, uint16_t fg) {
+  legacyThickArc(tft, cx, cy, r, thickness, start_deg, end_deg, bg);
+  legacyThickArc(tft, cx, cy, r, thickness, start_deg, start_deg + (end_deg - start_deg) * progress01, fg);
+}
+
+static const int CX = 120, CY = 120;
+static const uint16_t BG = 0x1111, TRACK = 0x4208, FG = 0x07FF;
+
+// Ângulo de (dx, dy) em graus, levado para perto de ref
+static float pixelAngle(int dx, int dy, float ref) {
+  float a = atan2f((float)dy, (float)dx) * (180.0f / (float)PI);
+  while (a < ref - 180.0f) a += 360.0f;
+  while (a >= ref + 180.0f) a -= 360.0f;
+  return a;
+}
+
+// Sem pontas, todo pixel fica no anel e no setor; o miolo do setor é coberto
+static void checkShape() {
+  TFT_eSPI tft;
+  const int radii[] = { 40, 96, 110 };
+  const int thick[] = { 6, 14, 16 };
+  for (int k = 0; k < 60; k++) {
+    int r = radii[k % 3], t = thick[(k / 3) % 3];
+    float a0 = (float)(testRand() % 7200) / 10.0f - 360.0f;
+    float a1 = a0 + (float)(testRand() % 3500) / 10.0f + 1.0f;
+    tft.fillScreen(BG);
+    drawThickArc(tft, CX, CY, r, t, a0, a1, FG, 0);
+    float ri = r - t / 2, ro = r + t / 2;
+    int outside = 0, missing = 0;
+    for (int y = 0; y < tft.height(); y++) {
+      for (int x = 0; x < tft.width(); x++) {
+        int dx = x - CX, dy = y - CY;
+        float d = sqrtf((float)(dx * dx + dy * dy));
+        float a = pixelAngle(dx, dy, (a0 + a1) / 2);
+        float tol = 180.0f / ((float)PI * (d > 1 ? d : 1));   // ~1 px em graus
+        bool lit = tft.readPixel(x, y) == FG;
+        bool inRing = d >= ri - 0.5f - 0.01f && d <= ro + 0.5f + 0.01f;
+        bool inSector = a >= a0 - tol && a <= a1 + tol;
+        if (lit && !(inRing && inSector)) outside++;
+        bool core = d >= ri + 1 && d <= ro - 1 && a >= a0 + tol && a <= a1 - tol;
+        if (core && !lit) missing++;
+      }
+    }
+    CHECK_EQ(outside, 0);
+    CHECK_EQ(missing, 0);
+  }
+}
+
+// [a, b) + [b, c) == [a, c): os mesmos pixels, nenhum escrito duas vezes
+static void checkTiling() {
+  TFT_eSPI ab, whole;
+  for (int k = 0; k < 200; k++) {
+    uint8_t flags = (k & 1) ? ARC_AA : 0;
+    float a = (float)(testRand() % 3600) / 10.0f;
+    float b = a + (float)(testRand() % 1800) / 10.0f;
+    float c = b + (float)(testRand() % 1800) / 10.0f;
+    ab.fillScreen(0); whole.fillScreen(0);
+    ab.resetCounters(); whole.resetCounters();
+    drawThickArc(ab, CX, CY, 96, 14, a, b, 0xFFFF, flags, 0);
+    drawThickArc(ab, CX, CY, 96, 14, b, c, 0xFFFF, flags, 0);
+    drawThickArc(whole, CX, CY, 96, 14, a, c, 0xFFFF, flags, 0);
+    CHECK_EQ(ab.pixelsDrawn, whole.pixelsDrawn);
+    CHECK(ab.frame() == whole.frame());
+  }
+}
+
+// Passos de drawArcDelta terminam na mesma imagem que drawArcProgress
+static void checkDelta() {
+  TFT_eSPI inc, full;
+  // Barras da V3: subindo (300 -> 420) e descendo (240 -> 120)
+  const float bars[2][2] = { { 300.0f, 420.0f }, { 240.0f, 120.0f } };
+  for (int bar = 0; bar < 2; bar++) {
+    for (int aa = 0; aa < 2; aa++) {
+      float s0 = bars[bar][0], s1 = bars[bar][1];
+      uint8_t flags = aa ? ARC_AA : 0;
+      float p = 0.5f;
+      inc.fillScreen(BG);
+      drawArcProgress(inc, CX, CY, 96, 14, s0, s1, p, TRACK, FG, flags, BG);
+      int bad = 0;
+      for (int step = 0; step < 300; step++) {
+        // Passos pequenos (menores que a ponta), grandes e até os extremos
+        uint32_t kind = testRand() % 4;
+        float q;
+        if (kind == 0) q = p + ((float)(testRand() % 21) - 10.0f) / 1000.0f;
+        else if (kind == 1) q = p + ((float)(testRand() % 401) - 200.0f) / 1000.0f;
+        else if (kind == 2) q = (testRand() & 1) ? 0.0f : 1.0f;
+        else q = (float)(testRand() % 1001) / 1000.0f;
+        if (q < 0) q = 0;
+        if (q > 1) q = 1;
+        drawArcDelta(inc, CX, CY, 96, 14, s0, s1, s0 + (s1 - s0) * p, s0 + (s1 - s0) * q,
+                     FG, TRACK, flags, BG);
+        full.fillScreen(BG);
+        drawArcProgress(full, CX, CY, 96, 14, s0, s1, q, TRACK, FG, flags, BG);
+        if (inc.frame() != full.frame()) bad++;
+        p = q;
+      }
+      CHECK_EQ(bad, 0);
+    }
+  }
+}
+
+// Widget de arco: repintura por delta == widget novo desenhado do zero
+static void checkWidget() {
+  TFT_eSPI inc, full;
+  Widget w = widgetArc(CX, CY, 110, 8, 135, 45, FG, TRACK, BG);
+  inc.fillScreen(BG);
+  int bad = 0;
+  for (int step = 0; step < 200; step++) {
+    float q = (testRand() % 4 == 0) ? (float)(testRand() & 1) : (float)(testRand() % 1001) / 1000.0f;
+    widgetSetProgress(w, q);
+    bool dirty = w.dirty;
+    inc.resetCounters();
+    CHECK_EQ(widgetsFlush(inc, &w, 1), dirty ? 1 : 0);
+    if (!dirty) CHECK_EQ(inc.pixelsDrawn, 0u);
+    Widget f = widgetArc(CX, CY, 110, 8, 135, 45, FG, TRACK, BG);
+    widgetSetProgress(f, q);
+    full.fillScreen(BG);
+    widgetsFlush(full, &f, 1);
+    if (inc.frame() != full.frame()) bad++;
+  }
+  CHECK_EQ(bad, 0);
+}
+
+static void bench() {
+  TFT_eSPI tft;
+  tft.fillScreen(BG);
+
+  // Arco de 120° do mostrador V1 (r 96, espessura 16)
+  tft.resetCounters();
+  legacyThickArc(tft, CX, CY, 96, 16, 210, 330, FG);
+  uint32_t legacyPx = tft.pixelsDrawn;
+  tft.resetCounters();
+  drawThickArc(tft, CX, CY, 96, 16, 210, 330, FG);
+  uint32_t spanPx = tft.pixelsDrawn;
+  tft.resetCounters();
+  drawThickArc(tft, CX, CY, 96, 16, 210, 330, FG, ARC_CAPS | ARC_AA, BG);
+  uint32_t aaPx = tft.pixelsDrawn;
+  double legacyUs = benchUs(2000, [&] { legacyThickArc(tft, CX, CY, 96, 16, 210, 330, FG); });
+  double spanUs = benchUs(2000, [&] { drawThickArc(tft, CX, CY, 96, 16, 210, 330, FG); });
+  double aaUs = benchUs(2000, [&] { drawThickArc(tft, CX, CY, 96, 16, 210, 330, FG, ARC_CAPS | ARC_AA, BG); });
+  // O carimbo escreve cada pixel muitas vezes; as linhas, uma
+  CHECK(spanPx * 4 < legacyPx);
+  printf("arco 120 graus: carimbo %u pixels %.1f us; linhas %u pixels %.1f us; com AA %u pixels %.1f us\n",
+         (unsigned)legacyPx, legacyUs, (unsigned)spanPx, spanUs, (unsigned)aaPx, aaUs);
+
+  // Barra de progresso: desenho inteiro antigo e novo, e um passo de 1%
+  tft.resetCounters();
+  legacyArcProgress(tft, CX, CY, 96, 14, 300, 420, 0.5f, TRACK, FG);
+  uint32_t legacyProgPx = tft.pixelsDrawn;
+  tft.resetCounters();
+  drawArcProgress(tft, CX, CY, 96, 14, 300, 420, 0.5f, TRACK, FG, ARC_AA, BG);
+  uint32_t progPx = tft.pixelsDrawn;
+  tft.resetCounters();
+  drawArcDelta(tft, CX, CY, 96, 14, 300, 420, 360.0f, 361.2f, FG, TRACK, ARC_AA, BG);
+  uint32_t deltaPx = tft.pixelsDrawn;
+  double legacyProgUs = benchUs(2000, [&] { legacyArcProgress(tft, CX, CY, 96, 14, 300, 420, 0.5f, TRACK, FG); });
+  double progUs = benchUs(2000, [&] { drawArcProgress(tft, CX, CY, 96, 14, 300, 420, 0.5f, TRACK, FG, ARC_AA, BG); });
+  int flip = 0;
+  double deltaUs = benchUs(2000, [&] {
+    flip ^= 1;
+    drawArcDelta(tft, CX, CY, 96, 14, 300, 420, flip ? 360.0f : 361.2f, flip ? 361.2f : 360.0f,
+                 FG, TRACK, ARC_AA, BG);
+  });
+  CHECK(deltaPx < progPx);
+  printf("barra: carimbo %u pixels %.1f us; inteira %u pixels %.1f us; passo de 1%% %u pixels %.1f us\n",
+         (unsigned)legacyProgPx, legacyProgUs, (unsigned)progPx, progUs, (unsigned)deltaPx, deltaUs);
+}
+
+int main() {
+  checkShape();
+  checkTiling();
+  checkDelta();
+  checkWidget();
+  bench();
+  return testDone("arc");
+}
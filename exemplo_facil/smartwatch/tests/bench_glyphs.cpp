@@ -0,0 +1,168 @@
+// Atlas de glifos: células == alfa misturado, relógio incremental == desenho
+// inteiro e custo contra repintar a hora com drawString (fonte 7). O tempo de
+// CPU é o do PC; o de SPI é estimado pelos bytes no barramento a 27 MHz.
+#include "test_util.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "glyph_atlas.h"
+
+static const uint16_t FG = 0xE73C, BG = 0x0861;
+
+// Mistura de referência, em ponto flutuante
+static uint16_t refBlend(uint8_t a, uint16_t fg, uint16_t bg) {
+  int r = (int)lroundf(((fg >> 11) * a + (bg >> 11) * (15 - a)) / 15.0f);
+  int g = (int)lroundf((((fg >> 5) & 63) * a + ((bg >> 5) & 63) * (15 - a)) / 15.0f);
+  int b = (int)lroundf(((fg & 31) * a + (bg & 31) * (15 - a)) / 15.0f);
+  return (r << 11) | (g << 5) | b;
+}
+
+static uint8_t alphaAt(const GlyphInfo &g, int x, int y) {
+  uint32_t i = (uint32_t)y * g.w + x;
+  uint8_t b = GLYPH_TIME48.alpha[g.offset + (i >> 1)];
+  return (i & 1) ? (b & 0x0F) : (b >> 4);
+}
+
+// Cada glifo sai na célula inteira, com o alfa misturado entre frente e fundo
+static void checkCells() {
+  TFT_eSPI tft;
+  const GlyphLut &lut = glyphLut(FG, BG);
+  CHECK_EQ(lut.c[0], BG);
+  CHECK_EQ(lut.c[15], FG);
+  for (int i = 0; i < GLYPH_TIME48.count; i++) {
+    GlyphInfo g = GLYPH_TIME48.glyphs[i];
+    CHECK_EQ(g.w % 2, 0);
+    for (int pass = 0; pass < 2; pass++) {   // falta no cache e acerto
+      tft.fillScreen(0x1234);
+      int16_t adv = glyphDraw(tft, GLYPH_TIME48, g.ch, 30, 40, FG, BG);
+      CHECK_EQ(adv, g.w);
+      int bad = 0, outside = 0;
+      for (int y = 0; y < tft.height(); y++) {
+        for (int x = 0; x < tft.width(); x++) {
+          uint16_t c = tft.readPixel(x, y);
+          bool in = x >= 30 && y >= 40 && x < 30 + g.w && y < 40 + GLYPH_TIME48.height;
+          if (!in) { if (c != 0x1234) outside++; continue; }
+          if (c != refBlend(alphaAt(g, x - 30, y - 40), FG, BG)) bad++;
+        }
+      }
+      CHECK_EQ(bad, 0);
+      CHECK_EQ(outside, 0);
+    }
+  }
+  // Caractere fora do atlas vira espaço
+  CHECK_EQ(glyphTextWidth(GLYPH_TIME48, "1x"), 2 * 28);
+}
+
+static void formatTime(char *buf, size_t n, int minutes, bool padHour) {
+  int h = minutes / 60 % 24, m = minutes % 60;
+  if (padHour) snprintf(buf, n, "%02d:%02d", h, m);
+  else snprintf(buf, n, "%d:%02d", h, m);
+}
+
+// Relógio incremental (só as posições que mudaram) termina igual a um
+// desenho inteiro sobre a tela limpa: um dia de minutos, com e sem zero à
+// esquerda (a largura muda em 9:59 -> 10:00) e "--:--" sem hora
+static void checkIncremental() {
+  TFT_eSPI inc, full;
+  GlyphLine li, lf;
+  for (int pad = 0; pad < 2; pad++) {
+    glyphLineInit(li, GLYPH_TIME48, FG, BG);
+    inc.fillScreen(BG);
+    int bad = 0;
+    for (int t = 0; t <= 24 * 60; t++) {
+      char buf[GLYPH_LINE_MAX];
+      if (t % 97 == 0) snprintf(buf, sizeof(buf), "--:--");
+      else formatTime(buf, sizeof(buf), t, pad);
+      glyphLineDraw(inc, li, 40, 90, buf, false);
+      glyphLineInit(lf, GLYPH_TIME48, FG, BG);
+      full.fillScreen(BG);
+      glyphLineDraw(full, lf, 40, 90, buf, true);
+      if (inc.frame() != full.frame()) bad++;
+    }
+    CHECK_EQ(bad, 0);
+  }
+
+  // Glifos enviados: 12:59 -> 13:00 reenvia 3; 13:00 -> 13:01, 1
+  TFT_eSPI tft;
+  glyphLineInit(li, GLYPH_TIME48, FG, BG);
+  CHECK_EQ(glyphLineDraw(tft, li, 40, 90, "12:59", false), 5);
+  CHECK_EQ(glyphLineDraw(tft, li, 40, 90, "13:00", false), 3);
+  CHECK_EQ(glyphLineDraw(tft, li, 40, 90, "13:01", false), 1);
+  CHECK_EQ(glyphLineDraw(tft, li, 40, 90, "13:01", false), 0);
+  CHECK_EQ(glyphLineDraw(tft, li, 41, 90, "13:01", false), 5);   // mudou de lugar
+}
+
+// glyphs_time.h do sketch é o que glyph_pack.py gera hoje
+static void checkPackedInSync() {
+  std::ifstream a("build/glyphs_time_default.h"), b("../glyphs_time.h");
+  std::stringstream sa, sb;
+  sa << a.rdbuf();
+  sb << b.rdbuf();
+  CHECK(!sa.str().empty());
+  CHECK(sa.str() == sb.str());
+}
+
+// Modelo do barramento (o mesmo de glyph_pack.py --stats)
+static const double SPI_US_PER_BYTE = 8.0 / 27.0;
+static const int WINDOW_BYTES = 11;
+static const int DRAWSTRING_RUN_BYTES = 13;
+
+// Fonte 7 transparente: pixels acesos (alfa >= 8) e trechos por linha
+static uint32_t drawStringBytes(const char *text) {
+  uint32_t bytes = 0;
+  for (const char *p = text; *p; p++) {
+    GlyphInfo g;
+    if (!glyphFindOrSpace(GLYPH_TIME48, *p, g)) continue;
+    for (int y = 0; y < GLYPH_TIME48.height; y++) {
+      bool prev = false;
+      for (int x = 0; x < g.w; x++) {
+        bool lit = alphaAt(g, x, y) >= 8;
+        if (lit) bytes += 2;
+        if (lit && !prev) bytes += DRAWSTRING_RUN_BYTES;
+        prev = lit;
+      }
+    }
+  }
+  return bytes;
+}
+
+static void bench() {
+  TFT_eSPI tft;
+  GlyphLine l;
+  glyphLineInit(l, GLYPH_TIME48, FG, BG);
+
+  // Um dia de atualizações por minuto
+  uint64_t atlasBytes = 0, legacyBytes = 0;
+  uint32_t sent = 0, ticks = 0;
+  for (int t = 0; t < 24 * 60; t++, ticks++) {
+    char buf[GLYPH_LINE_MAX];
+    formatTime(buf, sizeof(buf), t, true);
+    tft.resetCounters();
+    sent += glyphLineDraw(tft, l, 40, 90, buf, false);
+    atlasBytes += (uint64_t)tft.bursts * WINDOW_BYTES + 2ull * tft.pixelsPushed;
+    // Antes: limpa a caixa da hora e repinta a string inteira
+    uint32_t box = (uint32_t)glyphTextWidth(GLYPH_TIME48, buf) * GLYPH_TIME48.height;
+    legacyBytes += WINDOW_BYTES + 2ull * box + drawStringBytes(buf);
+  }
+  double atlasMs = atlasBytes * SPI_US_PER_BYTE / ticks / 1000.0;
+  double legacyMs = legacyBytes * SPI_US_PER_BYTE / ticks / 1000.0;
+  CHECK(atlasBytes < legacyBytes);
+  printf("relógio por minuto: %.2f glifos, SPI %.2f ms; drawString com limpeza %.2f ms\n",
+         (double)sent / ticks, atlasMs, legacyMs);
+
+  // CPU por glifo: do cache (acerto) e misturando de novo (falta)
+  int k = 0;
+  double hitUs = benchUs(20000, [&] { glyphDraw(tft, GLYPH_TIME48, '0' + (k++ % 10), 40, 90, FG, BG); });
+  uint16_t fg = 1;
+  double missUs = benchUs(20000, [&] { glyphDraw(tft, GLYPH_TIME48, '8', 40, 90, fg++, BG); });
+  printf("glifo 28x48: cache %.2f us (%.0f glifos/s), sem cache %.2f us; acertos %u, faltas %u\n",
+         hitUs, 1e6 / hitUs, missUs, (unsigned)glyphCacheHits, (unsigned)glyphCacheMisses);
+}
+
+int main() {
+  checkCells();
+  checkIncremental();
+  checkPackedInSync();
+  bench();
+  return testDone("glyphs");
+}
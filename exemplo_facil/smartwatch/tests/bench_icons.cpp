@@ -0,0 +1,156 @@
+// Ícones RLE: decodificação == bitmap de tools/icons_src.h, recorte e custo
+// contra um drawPixel por pixel (o drawBitmap anterior). O tempo de CPU é o
+// do PC; o de SPI é estimado pelos bytes no barramento a 27 MHz.
+#include "test_util.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "icon_rle.h"          // cópia em build/icons: pacote com todos os ícones
+#include "tools/icons_src.h"
+
+struct SourceIcon {
+  const char *name;
+  const unsigned char *bits;
+  int w, h;
+};
+
+// Mesma ordem de icons_src.h (icon_pack.py --all)
+static const SourceIcon SOURCES[] = {
+  { "wifi_icon_bits", wifi_icon_bits, 8, 8 },
+  { "mic", mic, 8, 8 },
+  { "coffe", coffe, 32, 32 },
+  { "apple", apple, 32, 32 },
+  { "android", android, 32, 32 },
+  { "whatts", whatts, 32, 32 },
+  { "amor", amor, 200, 200 },
+  { "giroscopico", giroscopico, 32, 32 },
+};
+static const int SOURCE_COUNT = sizeof(SOURCES) / sizeof(SOURCES[0]);
+
+static const uint16_t FG = 0xF81F, BG = 0x0841, SCREEN = 0x1234;
+
+// Pixel (x, y) do XBM: bit menos significativo = pixel da esquerda
+static bool xbmBit(const SourceIcon &s, int x, int y) {
+  int stride = (s.w + 7) / 8;
+  return (s.bits[y * stride + (x >> 3)] >> (x & 7)) & 1;
+}
+
+// Desenho anterior: um drawPixel (uma transação) por pixel
+static void legacyDrawIcon(TFT_eSPI &tft, const SourceIcon &s, int x, int y, uint16_t fg, uint16_t bg) {
+  for (int j = 0; j < s.h; j++)
+    for (int i = 0; i < s.w; i++)
+      tft.drawPixel(x + i, y + j, xbmBit(s, i, j) ? fg : bg);
+}
+
+// O pacote gerado confere com a fonte em tamanho e pixels
+static void checkDecode() {
+  CHECK_EQ(ICON_RLE_COUNT, SOURCE_COUNT);
+  TFT_eSPI tft;
+  displayClipInit(tft);
+  for (int k = 0; k < SOURCE_COUNT && k < ICON_RLE_COUNT; k++) {
+    const SourceIcon &s = SOURCES[k];
+    int16_t w, h;
+    iconRleSize((IconId)k, w, h);
+    CHECK_EQ(w, s.w);
+    CHECK_EQ(h, s.h);
+    int x = s.w < 200 ? 17 : 20, y = s.h < 200 ? 23 : 20;
+    tft.fillScreen(SCREEN);
+    drawIconRle(tft, (IconId)k, x, y, FG, BG);
+    int bad = 0, outside = 0;
+    for (int py = 0; py < tft.height(); py++) {
+      for (int px = 0; px < tft.width(); px++) {
+        uint16_t c = tft.readPixel(px, py);
+        bool in = px >= x && py >= y && px < x + s.w && py < y + s.h;
+        if (!in) { if (c != SCREEN) outside++; continue; }
+        if (c != (xbmBit(s, px - x, py - y) ? FG : BG)) bad++;
+      }
+    }
+    if (bad || outside) printf("  %s: %d pixels errados, %d fora do ícone\n", s.name, bad, outside);
+    CHECK_EQ(bad, 0);
+    CHECK_EQ(outside, 0);
+
+    // Cores da paleta gravada: 0 = fundo, 1 = frente
+    tft.fillScreen(SCREEN);
+    drawIconRle(tft, (IconId)k, x, y);
+    CHECK_EQ(tft.readPixel(x, y), xbmBit(s, 0, 0) ? 0xFFFF : 0x0000);
+  }
+}
+
+// Parcialmente fora da tela ou do recorte: linhas recortadas, mesmo resultado
+static void checkClipped() {
+  TFT_eSPI tft, ref;
+  displayClipInit(tft);
+  const int spots[][2] = { { -5, 10 }, { 220, -9 }, { 100, 230 }, { 60, 60 } };
+  for (int k = 0; k < SOURCE_COUNT && k < ICON_RLE_COUNT; k++) {
+    const SourceIcon &s = SOURCES[k];
+    for (int i = 0; i < 4; i++) {
+      int x = spots[i][0], y = spots[i][1];
+      bool clip = i == 3;
+      tft.fillScreen(SCREEN);
+      ref.fillScreen(SCREEN);
+      if (clip) {
+        displayClipPush(tft, x + 3, y + 2, s.w / 2, s.h / 2);
+        ref.setViewport(x + 3, y + 2, s.w / 2, s.h / 2, false);
+      }
+      drawIconRle(tft, (IconId)k, x, y, FG, BG);
+      legacyDrawIcon(ref, s, x, y, FG, BG);
+      if (clip) {
+        displayClipPop(tft);
+        ref.resetViewport();
+      }
+      CHECK(tft.frame() == ref.frame());
+    }
+  }
+}
+
+// icons_rle.h do sketch é o que icon_pack.py gera hoje (não ficou velho)
+static void checkPackedInSync() {
+  std::ifstream a("build/icons_rle_default.h"), b("../icons_rle.h");
+  std::stringstream sa, sb;
+  sa << a.rdbuf();
+  sb << b.rdbuf();
+  CHECK(!sa.str().empty());
+  CHECK(sa.str() == sb.str());
+}
+
+// Barramento SPI do display (User_Setup.h): bytes por transação
+// drawPixel = janela (CASET/RASET com 4 bytes cada, RAMWR) + 2 bytes de cor
+static const double SPI_US_PER_BYTE = 8.0 / 27.0;
+static const int SPI_PIXEL_BYTES = 13;
+static const int SPI_WINDOW_BYTES = 11;
+
+static void bench() {
+  TFT_eSPI tft;
+  displayClipInit(tft);
+  for (int k = 0; k < SOURCE_COUNT && k < ICON_RLE_COUNT; k++) {
+    const SourceIcon &s = SOURCES[k];
+    IconRle ic;
+    iconRleInfo((IconId)k, ic);
+    tft.resetCounters();
+    drawIconRle(tft, (IconId)k, 20, 20, FG, BG);
+    uint32_t rleBursts = tft.bursts;
+    tft.resetCounters();
+    legacyDrawIcon(tft, s, 20, 20, FG, BG);
+    uint32_t pixelWrites = tft.pixelsDrawn;
+    int reps = s.w * s.h > 10000 ? 200 : 5000;
+    double rleUs = benchUs(reps, [&] { drawIconRle(tft, (IconId)k, 20, 20, FG, BG); });
+    double pixelUs = benchUs(reps, [&] { legacyDrawIcon(tft, s, 20, 20, FG, BG); });
+    // Uma transação por pixel antes; agora rajadas
+    CHECK(rleBursts < pixelWrites);
+    int raw = (s.w + 7) / 8 * s.h;
+    double rleBusMs = (SPI_WINDOW_BYTES + 2.0 * s.w * s.h) * SPI_US_PER_BYTE / 1000.0;
+    double pixelBusMs = (double)pixelWrites * SPI_PIXEL_BYTES * SPI_US_PER_BYTE / 1000.0;
+    printf("%-15s %3dx%-3d %4d -> %4u bytes; RLE %5u rajadas, SPI %6.2f ms, CPU %6.2f us;"
+           " por pixel %5u transações, SPI %6.2f ms, CPU %6.2f us\n",
+           s.name, s.w, s.h, raw, (unsigned)ic.bytes, (unsigned)rleBursts, rleBusMs, rleUs,
+           (unsigned)pixelWrites, pixelBusMs, pixelUs);
+  }
+}
+
+int main() {
+  checkDecode();
+  checkClipped();
+  checkPackedInSync();
+  bench();
+  return testDone("icons");
+}
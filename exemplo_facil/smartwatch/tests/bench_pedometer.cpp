@@ -0,0 +1,108 @@
+// Pedômetro sobre traços de caminhada sintéticos: precisão, gravações e custo
+#include "test_util.h"
+#include "config.h"
+#include "pedometer.h"
+
+#define SAMPLE_MS (MPU_READ_INTERVAL_MS + 1)  // o loop lê quando passa de 20 ms
+
+struct Trace {
+  const char *name;
+  float stepHz;      // 0 = sem passos
+  float amp;         // amplitude vertical do passo (m/s²)
+  float noise;       // ruído uniforme (m/s²)
+  float vibHz, vib;  // vibração fora da banda (carro, ônibus)
+  float jitter;      // variação da cadência a cada passo (fração)
+  int seconds;
+};
+
+static void pedoResetState() {
+  pedoGravity = GRAVITY_MS2;
+  pedoFiltered = pedoPrev = 0.0f;
+  pedoRising = false;
+  pedoEnvelope = PEDO_MIN_THRESHOLD * 2.0f;
+  pedoLastStep = 0;
+  pedoStepsToday = pedoStepsSaved = 0;
+}
+
+static float noise(float a) {
+  return a * ((float)(testRand() % 2001) / 1000.0f - 1.0f);
+}
+
+// Aceleração no pulso: passo vertical com harmônica, balanço do braço em x
+// (metade da cadência) e o relógio inclinado, para a gravidade cair em dois
+// eixos. ph = fase do passo (2π por passo), acumulada com a cadência do momento
+static void sample(const Trace &t, float s, float ph, float &ax, float &ay, float &az) {
+  float step = t.amp * (sinf(ph) + 0.3f * sinf(2.0f * ph + 0.7f));
+  float swing = 0.6f * t.amp * sinf(0.5f * ph);
+  float vib = t.vib * sinf(2.0f * (float)PI * t.vibHz * s);
+  float vert = GRAVITY_MS2 + step + vib;
+  ax = swing + noise(t.noise);
+  ay = 0.5f * vert + noise(t.noise);
+  az = 0.866f * vert + noise(t.noise);
+}
+
+// Roda o traço; devolve os passos contados e, em steps, os gerados. O relógio
+// fica parado em nowMs: o tempo por amostra vem do cronômetro do teste
+static uint32_t run(const Trace &t, unsigned long &nowMs, double &usPerSample, uint32_t &steps) {
+  pedoResetState();
+  uint32_t n = (uint32_t)t.seconds * 1000 / SAMPLE_MS;
+  static float buf[3 * 200000];
+  double ph = 0.0, hz = t.stepHz;
+  for (uint32_t i = 0; i < n; i++) {
+    sample(t, i * SAMPLE_MS / 1000.0f, (float)ph, buf[3 * i], buf[3 * i + 1], buf[3 * i + 2]);
+    double next = ph + 2.0 * PI * hz * SAMPLE_MS / 1000.0;
+    if (floor(next / (2.0 * PI)) != floor(ph / (2.0 * PI))) hz = t.stepHz * (1.0f + noise(t.jitter));
+    ph = next;
+  }
+  steps = (uint32_t)(ph / (2.0 * PI));
+  uint32_t i = 0;
+  usPerSample = benchUs((int)n, [&] {
+    nowMs += SAMPLE_MS;
+    hostClockSet((uint32_t)nowMs);
+    pedometerUpdate(buf[3 * i], buf[3 * i + 1], buf[3 * i + 2], nowMs);
+    i++;
+  });
+  return pedoStepsToday;
+}
+
+int main() {
+  static const Trace traces[] = {
+    { "caminhada",        1.8f, 2.5f, 0.3f,  0.0f, 0.0f, 0.00f, 600 },
+    { "caminhada lenta",  1.3f, 1.8f, 0.3f,  0.0f, 0.0f, 0.00f, 600 },
+    { "passo irregular",  1.7f, 2.2f, 0.4f,  0.0f, 0.0f, 0.15f, 600 },
+    { "corrida",          2.8f, 6.0f, 0.6f,  0.0f, 0.0f, 0.05f, 600 },
+    { "parado",           0.0f, 0.0f, 0.3f,  0.0f, 0.0f, 0.00f, 600 },
+    { "onibus",           0.0f, 0.0f, 0.3f, 14.0f, 1.5f, 0.00f, 600 },
+  };
+
+  unsigned long nowMs = 1000;
+  hostPrefsWrites = 0;
+  uint32_t totalSteps = 0;
+  uint64_t totalSamples = 0;
+  for (const Trace &t : traces) {
+    double us;
+    uint32_t expected;
+    uint32_t steps = run(t, nowMs, us, expected);
+    totalSteps += steps;
+    totalSamples += (uint64_t)t.seconds * 1000 / SAMPLE_MS;
+    printf("%-16s %5u passos (esperado %5u)  %.3f us/amostra (orcamento %d us)\n",
+           t.name, (unsigned)steps, (unsigned)expected, us, PEDO_BUDGET_US);
+    if (expected) {
+      CHECK(steps >= expected * 95 / 100);
+      CHECK(steps <= expected * 105 / 100);
+    } else {
+      CHECK(steps <= 5);  // sem passos: no máximo algum pico isolado
+    }
+    CHECK(us < PEDO_BUDGET_US);
+  }
+
+  // Flash em lote: uma gravação (2 chaves) a cada PEDO_SAVE_STEPS passos ou
+  // PEDO_SAVE_INTERVAL_MS, mais a do dia novo; nunca por passo
+  uint32_t minutes = (uint32_t)(totalSamples * SAMPLE_MS / 60000);
+  uint32_t maxFlushes = totalSteps / PEDO_SAVE_STEPS + minutes * 60000 / PEDO_SAVE_INTERVAL_MS + 2;
+  printf("gravacoes no flash: %u chaves para %u passos em %u min\n",
+         (unsigned)hostPrefsWrites, (unsigned)totalSteps, (unsigned)minutes);
+  CHECK(hostPrefsWrites <= 2 * maxFlushes);
+
+  return testDone("pedometer");
+}
@@ -0,0 +1,149 @@
+// Telemetria binária contra o JSON: conteúdo dos frames, bytes e custo por amostra
+#include "test_util.h"
+#include "config.h"
+#include "telemetry.h"
+
+WebSocketsClient webSocket;
+
+// getSensorsJSON() anterior ao stream binário: ~20 String temporárias por chamada
+static String legacySensorsJSON() {
+  String json = "{";
+  json += "\"mpu\":{";
+  json += "\"available\":" + String(sensorData.mpuAvailable ? "true" : "false") + ",";
+  json += "\"accel\":{\"x\":" + String(sensorData.accelX) + ",\"y\":" + String(sensorData.accelY) + ",\"z\":" + String(sensorData.accelZ) + "},";
+  json += "\"gyro\":{\"x\":" + String(sensorData.gyroX) + ",\"y\":" + String(sensorData.gyroY) + ",\"z\":" + String(sensorData.gyroZ) + "},";
+  json += "\"temp\":" + String(sensorData.tempMPU);
+  json += "},";
+  json += "\"hr\":{";
+  json += "\"bpm\":" + String(sensorData.bpm) + ",";
+  json += "\"spo2\":" + String(sensorData.spo2) + ",";
+  json += "\"finger\":" + String(sensorData.fingerPresent ? "true" : "false");
+  json += "}";
+  json += "}";
+  return json;
+}
+
+static float frand(float a) {
+  return a * ((float)(testRand() % 20001) / 10000.0f - 1.0f);
+}
+
+static void randomSample(SensorData &d) {
+  d.accelX = frand(78.0f); d.accelY = frand(78.0f); d.accelZ = frand(78.0f);
+  d.gyroX = frand(8.7f); d.gyroY = frand(8.7f); d.gyroZ = frand(8.7f);
+  d.tempMPU = 20.0f + frand(15.0f);
+  d.mpuAvailable = true;
+  d.hrActive = testRand() & 1;
+  d.fingerPresent = d.hrActive && (testRand() & 1);
+  d.bpm = d.fingerPresent ? 50 + (int)(testRand() % 120) : -1;
+  d.spo2 = d.fingerPresent ? 90 + (int)(testRand() % 10) : -1;
+  d.irMean = testRand() % 250000;
+}
+
+static bool near(int16_t packed, float v, float scale) {
+  return fabsf(packed / scale - v) <= 0.5f / scale + 1e-4f;
+}
+
+// Amostras passam por updateTelemetry(); cada frame é decodificado e comparado
+static void checkFrames() {
+  const int samples = 7 * TELEMETRY_BATCH + 3;
+  static SensorData in[samples];
+  webSocket.sent.clear();
+  hostClockSet(5000);
+  startTelemetry(TELEMETRY_INTERVAL_MS);
+  for (int i = 0; i < samples; i++) {
+    hostClockAdvance(TELEMETRY_INTERVAL_MS);
+    randomSample(sensorData);
+    in[i] = sensorData;
+    updateTelemetry();
+  }
+  CHECK_EQ(webSocket.sent.size(), samples / TELEMETRY_BATCH);
+  stopTelemetry();  // envia o lote parcial
+  CHECK_EQ(webSocket.sent.size(), samples / TELEMETRY_BATCH + 1);
+
+  int k = 0;
+  for (size_t f = 0; f < webSocket.sent.size(); f++) {
+    const HostWsFrame &fr = webSocket.sent[f];
+    CHECK(fr.binary);
+    TelemetryHeader h;
+    memcpy(&h, fr.data.data(), sizeof(h));
+    CHECK_EQ(h.magic, TELEMETRY_MAGIC);
+    CHECK_EQ(h.version, TELEMETRY_VERSION);
+    CHECK_EQ(h.recordSize, sizeof(TelemetryRecord));
+    CHECK_EQ(fr.data.size(), sizeof(h) + h.count * sizeof(TelemetryRecord));
+    CHECK_EQ(h.count, f + 1 < webSocket.sent.size() ? TELEMETRY_BATCH : samples % TELEMETRY_BATCH);
+    for (int r = 0; r < h.count; r++, k++) {
+      TelemetryRecord rec;
+      memcpy(&rec, fr.data.data() + sizeof(h) + r * sizeof(rec), sizeof(rec));
+      const SensorData &d = in[k];
+      CHECK_EQ(rec.tMs, 5000 + (k + 1) * TELEMETRY_INTERVAL_MS);
+      CHECK(near(rec.accel[0], d.accelX, 100) && near(rec.accel[1], d.accelY, 100) && near(rec.accel[2], d.accelZ, 100));
+      CHECK(near(rec.gyro[0], d.gyroX, 1000) && near(rec.gyro[1], d.gyroY, 1000) && near(rec.gyro[2], d.gyroZ, 1000));
+      CHECK(near(rec.tempC, d.tempMPU, 100));
+      CHECK_EQ(rec.bpm, d.bpm);
+      CHECK_EQ(rec.spo2, d.spo2);
+      CHECK_EQ(rec.flags, TLM_FLAG_MPU | (d.fingerPresent ? TLM_FLAG_FINGER : 0) | (d.hrActive ? TLM_FLAG_HR : 0));
+      CHECK_EQ(rec.irMean, d.irMean);
+    }
+  }
+  CHECK_EQ(k, samples);
+
+  // Fora da faixa de int16 satura em vez de dar a volta
+  TelemetryRecord rec;
+  sensorData.gyroX = 40.0f;
+  sensorData.gyroY = -40.0f;
+  tlmPack(rec, sensorData, 0);
+  CHECK_EQ(rec.gyro[0], 32767);
+  CHECK_EQ(rec.gyro[1], -32768);
+}
+
+// O JSON de depuração cabe no buffer no pior caso e recusa buffer curto
+static void checkJson() {
+  char buf[SENSORS_JSON_MAX];
+  sensorData.accelX = sensorData.accelY = sensorData.accelZ = -78.45f;
+  sensorData.gyroX = sensorData.gyroY = sensorData.gyroZ = -8.73f;
+  sensorData.tempMPU = -40.0f;
+  sensorData.mpuAvailable = false;
+  sensorData.bpm = sensorData.spo2 = -1;
+  sensorData.fingerPresent = false;
+  pedoStepsToday = 4000000000u;
+  size_t n = writeSensorsJSON(buf, sizeof(buf));
+  CHECK(n > 0 && n == strlen(buf));
+  CHECK(strstr(buf, "\"steps\":4000000000,") != nullptr);
+  CHECK_EQ(writeSensorsJSON(buf, n), 0);
+  pedoStepsToday = 0;
+}
+
+int main() {
+  checkFrames();
+  checkJson();
+
+  // Custo e bytes por amostra, com dados variando a cada chamada
+  static SensorData pool[256];
+  for (SensorData &d : pool) randomSample(d);
+  int i = 0;
+  size_t legacyBytes = 0, jsonBytes = 0;
+  double legacyUs = benchUs(100000, [&] {
+    sensorData = pool[i++ & 255];
+    String s = legacySensorsJSON();
+    legacyBytes += s.length();
+  });
+  char buf[SENSORS_JSON_MAX];
+  double jsonUs = benchUs(100000, [&] {
+    sensorData = pool[i++ & 255];
+    jsonBytes += writeSensorsJSON(buf, sizeof(buf));
+  });
+  TelemetryRecord rec;
+  double binUs = benchUs(100000, [&] {
+    tlmPack(rec, pool[i & 255], i);
+    i++;
+    benchSink = rec.accel[0];
+  });
+  double binBytes = sizeof(TelemetryRecord) + (double)sizeof(TelemetryHeader) / TELEMETRY_BATCH;
+
+  printf("JSON com String:    %6.1f bytes  %.3f us/amostra\n", legacyBytes / 100000.0, legacyUs);
+  printf("JSON no buffer:     %6.1f bytes  %.3f us/amostra\n", jsonBytes / 100000.0, jsonUs);
+  printf("registro binario:   %6.1f bytes  %.3f us/amostra (lote de %d)\n", binBytes, binUs, TELEMETRY_BATCH);
+  CHECK(binBytes * 5 < legacyBytes / 100000.0);
+
+  return testDone("telemetry");
+}
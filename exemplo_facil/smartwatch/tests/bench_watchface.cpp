@@ -0,0 +1,84 @@
+// Watchface V3: quadro de segundo (só ponteiros) == mostrador refeito do zero
+// e custo por quadro antes (mostrador + hora em texto a cada segundo) e depois
+// (refeitos só na virada do minuto)
+#include "test_util.h"
+#include "WatchFace.h"
+
+static char dateBuf[6];
+
+static void setTime(WatchFaceV3Data &d, int t) {
+  d.hour = t / 3600 % 24;
+  d.minute = t / 60 % 60;
+  d.second = t % 60;
+  snprintf(dateBuf, sizeof(dateBuf), "%02d/%02d", 1 + t / 86400 % 28, 7);
+  d.date = dateBuf;
+}
+
+static WatchFaceV3Data sample() {
+  WatchFaceV3Data d = {};
+  d.heart = 72;
+  d.heartProgress = 72 / 200.0f;
+  d.sys = 120;
+  d.dia = 80;
+  d.battery = 85;
+  d.year = 2025;
+  return d;
+}
+
+// Três minutos (09:58:00 -> 10:01:00): a ponta do segundo passa por todas as
+// marcas, e a hora muda de largura em 10:00
+static void checkSeconds(TFT_eSPI &tft) {
+  WatchFaceV3Data d = sample();
+  int start = 9 * 3600 + 58 * 60;
+  setTime(d, start);
+  d.minuteChanged = true;
+  drawWatchFaceV3Static(tft, d, true);
+  drawWatchFaceV3Update(tft, d);
+  int bad = 0;
+  for (int t = start + 1; t <= start + 180; t++) {
+    setTime(d, t);
+    d.minuteChanged = d.second == 0;
+    drawWatchFaceV3Update(tft, d);
+    std::vector<uint16_t> inc = tft.frame();
+    // Mesmo instante com o mostrador refeito (estado final idêntico)
+    d.minuteChanged = true;
+    drawWatchFaceV3Update(tft, d);
+    if (inc != tft.frame()) bad++;
+  }
+  CHECK_EQ(bad, 0);
+
+  // BPM muda no meio do segundo: ponteiros no mesmo lugar
+  d.minuteChanged = false;
+  d.heart = 95;
+  d.heartProgress = 95 / 200.0f;
+  drawWatchFaceV3Update(tft, d);
+  std::vector<uint16_t> inc = tft.frame();
+  d.minuteChanged = true;
+  drawWatchFaceV3Update(tft, d);
+  CHECK(inc == tft.frame());
+}
+
+static void bench(TFT_eSPI &tft) {
+  WatchFaceV3Data d = sample();
+  int t = 12 * 3600;
+  double secondUs = benchUs(3000, [&] {
+    setTime(d, t++);
+    d.minuteChanged = d.second == 0;
+    drawWatchFaceV3Update(tft, d);
+  });
+  double rebuildUs = benchUs(3000, [&] {
+    setTime(d, t++);
+    d.minuteChanged = true;
+    drawWatchFaceV3Update(tft, d);
+  });
+  printf("V3 por segundo: antes (mostrador e hora a cada segundo) %.1f us; depois %.1f us\n",
+         rebuildUs, secondUs);
+  CHECK(secondUs < rebuildUs);
+}
+
+int main() {
+  TFT_eSPI tft;     // os sprites da V3 ficam presos ao primeiro display
+  checkSeconds(tft);
+  bench(tft);
+  return testDone("watchface");
+}
@@ -0,0 +1,25 @@
+#ifndef HOST_ADAFRUIT_MPU6050_H
+#define HOST_ADAFRUIT_MPU6050_H
+
+// MPU6050 de mentira: getEvent() devolve hostMpuEvent, preenchido pelo teste
+
+#include <Wire.h>
+#include <Adafruit_Sensor.h>
+
+enum { MPU6050_RANGE_8_G, MPU6050_RANGE_500_DEG, MPU6050_BAND_21_HZ };
+
+inline sensors_event_t hostMpuEvent = {};
+
+class Adafruit_MPU6050 {
+public:
+  bool begin(uint8_t addr, TwoWire *wire) { (void)addr; (void)wire; return true; }
+  void setAccelerometerRange(int) {}
+  void setGyroRange(int) {}
+  void setFilterBandwidth(int) {}
+  bool getEvent(sensors_event_t *a, sensors_event_t *g, sensors_event_t *t) {
+    *a = *g = *t = hostMpuEvent;
+    return true;
+  }
+};
+
+#endif // HOST_ADAFRUIT_MPU6050_H
@@ -0,0 +1,16 @@
+#ifndef HOST_ADAFRUIT_SENSOR_H
+#define HOST_ADAFRUIT_SENSOR_H
+
+#include <Arduino.h>
+
+struct sensors_vec_t {
+  float x, y, z;
+};
+
+struct sensors_event_t {
+  sensors_vec_t acceleration;
+  sensors_vec_t gyro;
+  float temperature;
+};
+
+#endif // HOST_ADAFRUIT_SENSOR_H
@@ -0,0 +1,186 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// ==========================================
+// ARDUINO NO PC - só o que os headers testados usam
+// ==========================================
+// String, Serial, relógio, PROGMEM e PSRAM em cima da biblioteca padrão.
+// millis()/micros() seguem o relógio real; um teste pode congelá-los com
+// hostClockSet() para controlar tempos de tela e fila.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+
+// ---------- tempo ----------
+inline bool hostClockFrozen = false;
+inline uint64_t hostClockUs = 0;
+
+inline uint64_t hostNowUs() {
+  using namespace std::chrono;
+  static const steady_clock::time_point t0 = steady_clock::now();
+  return duration_cast<microseconds>(steady_clock::now() - t0).count();
+}
+
+inline void hostClockSet(uint32_t ms) {
+  hostClockFrozen = true;
+  hostClockUs = (uint64_t)ms * 1000;
+}
+
+inline void hostClockAdvance(uint32_t ms) {
+  hostClockUs += (uint64_t)ms * 1000;
+}
+
+inline uint32_t micros() { return (uint32_t)(hostClockFrozen ? hostClockUs : hostNowUs()); }
+inline uint32_t millis() { return (uint32_t)((hostClockFrozen ? hostClockUs : hostNowUs()) / 1000); }
+inline void delay(uint32_t ms) { if (hostClockFrozen) hostClockAdvance(ms); }
+inline void yield() {}
+
+// ---------- memória ----------
+inline bool hostPsram = false;
+inline bool psramFound() { return hostPsram; }
+inline void *ps_malloc(size_t n) { return malloc(n); }
+inline uint32_t esp_random() { return (uint32_t)rand() * 2654435761u; }
+
+#define PROGMEM
+#define F(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define pgm_read_ptr(p) (*(void * const *)(p))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+struct HostEsp {
+  uint32_t getFreeHeap() { return 200000; }
+  uint32_t getMinFreeHeap() { return 150000; }
+  uint32_t getMaxAllocHeap() { return 100000; }
+  uint32_t getFreePsram() { return hostPsram ? 4000000 : 0; }
+};
+inline HostEsp ESP;
+
+// ---------- String ----------
+class String : public std::string {
+public:
+  String(const char *s = "") : std::string(s ? s : "") {}
+  String(const std::string &s) : std::string(s) {}
+  String(const char *s, size_t n) : std::string(s, n) {}
+  explicit String(char c) : std::string(1, c) {}
+  String(int v) : std::string(std::to_string(v)) {}
+  String(unsigned v) : std::string(std::to_string(v)) {}
+  String(long v) : std::string(std::to_string(v)) {}
+  String(unsigned long v) : std::string(std::to_string(v)) {}
+  String(float v, int decimals = 2) : String((double)v, decimals) {}
+  String(double v, int decimals = 2) {
+    char b[32];
+    snprintf(b, sizeof(b), "%.*f", decimals, v);
+    assign(b);
+  }
+
+  unsigned length() const { return (unsigned)size(); }
+  bool isEmpty() const { return empty(); }
+  char charAt(unsigned i) const { return i < size() ? (*this)[i] : 0; }
+  String substring(unsigned from) const { return from < size() ? String(substr(from)) : String(); }
+  String substring(unsigned from, unsigned to) const {
+    if (to > size()) to = size();
+    return from < to ? String(substr(from, to - from)) : String();
+  }
+  int indexOf(char c, unsigned from = 0) const {
+    size_t i = find(c, from);
+    return i == npos ? -1 : (int)i;
+  }
+  int indexOf(const char *s, unsigned from = 0) const {
+    size_t i = find(s, from);
+    return i == npos ? -1 : (int)i;
+  }
+  int lastIndexOf(char c) const {
+    size_t i = rfind(c);
+    return i == npos ? -1 : (int)i;
+  }
+  bool startsWith(const char *s) const { return compare(0, strlen(s), s) == 0; }
+  bool endsWith(const char *s) const {
+    size_t n = strlen(s);
+    return n <= size() && compare(size() - n, n, s) == 0;
+  }
+  bool equals(const char *s) const { return *this == s; }
+  bool equalsIgnoreCase(const char *s) const { return strcasecmp(c_str(), s) == 0; }
+  long toInt() const { return strtol(c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(c_str(), nullptr); }
+  void trim() {
+    size_t a = find_first_not_of(" \t\r\n");
+    size_t b = find_last_not_of(" \t\r\n");
+    if (a == npos) clear();
+    else assign(substr(a, b - a + 1));
+  }
+  void toLowerCase() { for (char &c : *this) c = (char)tolower((unsigned char)c); }
+  void toUpperCase() { for (char &c : *this) c = (char)toupper((unsigned char)c); }
+  void replace(const char *from, const char *to) {
+    std::string a(from), b(to);
+    if (a.empty()) return;
+    for (size_t i = 0; (i = find(a, i)) != npos; i += b.size()) std::string::replace(i, a.size(), b);
+  }
+  bool reserve(unsigned n) { std::string::reserve(n); return true; }
+  void getBytes(uint8_t *out, unsigned n) const {
+    if (!n) return;
+    size_t k = std::min((size_t)n - 1, size());
+    memcpy(out, data(), k);
+    out[k] = 0;
+  }
+
+  String &operator+=(const String &s) { append(s); return *this; }
+  String &operator+=(const char *s) { append(s); return *this; }
+  String &operator+=(char c) { push_back(c); return *this; }
+  String &operator+=(int v) { append(std::to_string(v)); return *this; }
+  String &operator+=(unsigned v) { append(std::to_string(v)); return *this; }
+  String &operator+=(long v) { append(std::to_string(v)); return *this; }
+  String &operator+=(unsigned long v) { append(std::to_string(v)); return *this; }
+};
+
+inline String operator+(const String &a, const String &b) { String r(a); r += b; return r; }
+inline String operator+(const String &a, const char *b) { String r(a); r += b; return r; }
+inline String operator+(const char *a, const String &b) { String r(a); r += b; return r; }
+inline String operator+(const String &a, char c) { String r(a); r += c; return r; }
+
+// ---------- Serial ----------
+// Silencioso por padrão: os testes imprimem só os próprios resultados.
+// HOST_SERIAL=1 no ambiente mostra os logs dos módulos.
+struct HostSerial {
+  bool on = getenv("HOST_SERIAL") != nullptr;
+  void begin(unsigned long) {}
+  int available() { return 0; }
+  int read() { return -1; }
+  size_t printf(const char *fmt, ...) {
+    if (!on) return 0;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vprintf(fmt, ap);
+    va_end(ap);
+    return n > 0 ? (size_t)n : 0;
+  }
+  size_t print(const char *s) { return on ? (size_t)fputs(s, stdout) : 0; }
+  size_t print(const String &s) { return print(s.c_str()); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t println(const char *s = "") { return on ? (size_t)::printf("%s\n", s) : 0; }
+  size_t println(const String &s) { return println(s.c_str()); }
+  size_t println(long v) { return printf("%ld\n", v); }
+  void flush() { fflush(stdout); }
+};
+inline HostSerial Serial;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,95 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+// ==========================================
+// SISTEMA DE ARQUIVOS EM MEMÓRIA - File/FS do core ESP32
+// ==========================================
+// Cada arquivo é um std::string num mapa; File guarda o nome e a posição.
+// Só o subconjunto usado pelos headers do sketch.
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+typedef std::map<std::string, std::shared_ptr<std::string>> HostFiles;
+
+class File {
+public:
+  File() {}
+  File(std::shared_ptr<std::string> data, size_t pos) : data(data), pos(pos) {}
+
+  explicit operator bool() const { return data != nullptr; }
+  size_t write(const uint8_t *buf, size_t n) {
+    if (!data) return 0;
+    if (pos + n > data->size()) data->resize(pos + n);
+    memcpy(&(*data)[pos], buf, n);
+    pos += n;
+    return n;
+  }
+  size_t write(uint8_t b) { return write(&b, 1); }
+  size_t read(uint8_t *buf, size_t n) {
+    if (!data) return 0;
+    n = std::min(n, data->size() - pos);
+    memcpy(buf, data->data() + pos, n);
+    pos += n;
+    return n;
+  }
+  int read() {
+    uint8_t b;
+    return read(&b, 1) ? b : -1;
+  }
+  bool seek(size_t p) {
+    if (!data || p > data->size()) return false;
+    pos = p;
+    return true;
+  }
+  size_t position() const { return pos; }
+  size_t size() const { return data ? data->size() : 0; }
+  int available() const { return data ? (int)(data->size() - pos) : 0; }
+  void flush() {}
+  void close() { data = nullptr; pos = 0; }
+
+private:
+  std::shared_ptr<std::string> data;
+  size_t pos = 0;
+};
+
+class FS {
+public:
+  File open(const char *path, const char *mode) {
+    auto it = files.find(path);
+    if (mode[0] == 'r') {
+      if (it == files.end()) return File();
+      return File(it->second, 0);
+    }
+    if (it == files.end() || mode[0] == 'w') {
+      files[path] = std::make_shared<std::string>();
+      it = files.find(path);
+    }
+    return File(it->second, mode[0] == 'a' ? it->second->size() : 0);
+  }
+  bool exists(const char *path) { return files.count(path) != 0; }
+  bool remove(const char *path) { return files.erase(path) != 0; }
+  bool rename(const char *from, const char *to) {
+    auto it = files.find(from);
+    if (it == files.end()) return false;
+    files[to] = it->second;
+    files.erase(from);
+    return true;
+  }
+
+  HostFiles files;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif // HOST_FS_H
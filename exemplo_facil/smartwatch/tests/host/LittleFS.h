@@ -0,0 +1,27 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+// LittleFS em memória; hostLittleFsMounts conta as montagens (flash_fs.h monta uma vez)
+
+#include <FS.h>
+
+inline int hostLittleFsMounts = 0;
+
+class LittleFSFS : public fs::FS {
+public:
+  bool begin(bool formatOnFail = false) {
+    (void)formatOnFail;
+    hostLittleFsMounts++;
+    return true;
+  }
+  size_t totalBytes() { return 1408 * 1024; }
+  size_t usedBytes() {
+    size_t n = 0;
+    for (auto &f : files) n += f.second->size();
+    return n;
+  }
+};
+
+inline LittleFSFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
@@ -0,0 +1,23 @@
+#ifndef HOST_MAX30105_H
+#define HOST_MAX30105_H
+
+// MAX30102 sem FIFO: o teste chama pushHrSample() direto
+
+#include <Wire.h>
+
+#define I2C_SPEED_FAST 400000
+
+class MAX30105 {
+public:
+  bool begin(TwoWire &wire, uint32_t speed) { (void)wire; (void)speed; return true; }
+  void setup(uint8_t, uint8_t, uint8_t, int, int, int) {}
+  uint16_t check() { return 0; }
+  int available() { return 0; }
+  uint32_t getFIFORed() { return 0; }
+  uint32_t getFIFOIR() { return 0; }
+  void nextSample() {}
+  void setPulseAmplitudeRed(uint8_t) {}
+  void setPulseAmplitudeIR(uint8_t) {}
+};
+
+#endif // HOST_MAX30105_H
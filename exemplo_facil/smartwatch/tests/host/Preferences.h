@@ -0,0 +1,35 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+// Preferences em memória; hostPrefsWrites conta as gravações (desgaste do flash)
+
+#include <Arduino.h>
+#include <map>
+
+inline std::map<std::string, uint32_t> hostPrefsStore;
+inline uint32_t hostPrefsWrites = 0;
+
+class Preferences {
+public:
+  bool begin(const char *ns, bool readOnly = false) {
+    prefix = std::string(ns) + "/";
+    (void)readOnly;
+    return true;
+  }
+  void end() {}
+  uint32_t getUInt(const char *key, uint32_t def = 0) {
+    auto it = hostPrefsStore.find(prefix + key);
+    return it == hostPrefsStore.end() ? def : it->second;
+  }
+  size_t putUInt(const char *key, uint32_t v) {
+    hostPrefsStore[prefix + key] = v;
+    hostPrefsWrites++;
+    return sizeof(v);
+  }
+  bool clear() { return true; }
+
+private:
+  std::string prefix;
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,412 @@
+#ifndef HOST_TFT_ESPI_H
+#define HOST_TFT_ESPI_H
+
+// ==========================================
+// TFT_eSPI NO PC - framebuffer com contadores
+// ==========================================
+// O display vira um framebuffer RGB565 com as regras do TFT_eSPI que os
+// módulos usam: viewport (recorte + origem opcional), janela de endereços
+// sem recorte para pushBlock/pushColors, troca de bytes e sprites que guardam
+// os pixels na ordem de bytes do display (getPointer()).
+// Contadores: pixels escritos, pixels enviados por janela e rajadas
+// (setAddrWindow, pushBlock, pushColors, pushImage): o custo do SPI no relógio
+// é dominado por essas transações.
+// Texto: fonte sintética e determinística (largura/altura por fonte), para
+// comparar desenhos entre si, não com o display real.
+
+#include <Arduino.h>
+#include <vector>
+
+#define TFT_BLACK       0x0000
+#define TFT_WHITE       0xFFFF
+#define TFT_RED         0xF800
+#define TFT_GREEN       0x07E0
+#define TFT_BLUE        0x001F
+#define TFT_CYAN        0x07FF
+#define TFT_YELLOW      0xFFE0
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_DARKGREY    0x7BEF
+#define TFT_TRANSPARENT 0x0120
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define MC_DATUM 4
+#define MR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+
+#define CP437_SWITCH 1
+#define UTF8_SWITCH 2
+
+static inline uint16_t hostBswap16(uint16_t c) { return (uint16_t)((c >> 8) | (c << 8)); }
+
+class TFT_eSPI {
+public:
+  // Contadores (zerados pelo teste)
+  uint32_t pixelsDrawn = 0;    // pixels escritos por primitivas
+  uint32_t pixelsPushed = 0;   // pixels enviados por janela/imagem
+  uint32_t bursts = 0;         // transações de envio
+  uint32_t textDraws = 0;
+
+  uint8_t textsize = 1;
+
+  TFT_eSPI(int16_t w = 240, int16_t h = 240) { allocate(w, h); }
+  virtual ~TFT_eSPI() {}
+
+  void init() {}
+  void setRotation(uint8_t) {}
+  void resetCounters() { pixelsDrawn = pixelsPushed = bursts = textDraws = 0; }
+
+  int16_t width() const { return vpDatum ? vpW : W; }
+  int16_t height() const { return vpDatum ? vpH : H; }
+
+  // Cor lógica do pixel (x, y) em coordenadas absolutas
+  uint16_t readPixelRaw(int x, int y) const {
+    uint16_t c = fb[(size_t)y * W + x];
+    return swappedStore ? hostBswap16(c) : c;
+  }
+  const std::vector<uint16_t> &frame() const { return fb; }
+
+  // ---------- viewport ----------
+  void setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool datum = true) {
+    clipX0 = std::max<int32_t>(x, 0);
+    clipY0 = std::max<int32_t>(y, 0);
+    clipX1 = std::min<int32_t>(x + w, W);
+    clipY1 = std::min<int32_t>(y + h, H);
+    if (clipX1 < clipX0) clipX1 = clipX0;
+    if (clipY1 < clipY0) clipY1 = clipY0;
+    vpDatum = datum;
+    if (datum) {
+      ox = x; oy = y; vpW = w; vpH = h;
+    } else {
+      ox = oy = 0; vpW = W; vpH = H;
+    }
+  }
+  void resetViewport() {
+    clipX0 = clipY0 = 0;
+    clipX1 = W;
+    clipY1 = H;
+    ox = oy = 0;
+    vpW = W;
+    vpH = H;
+    vpDatum = false;
+  }
+  // Como no TFT_eSPI: sem origem deslocada, os getters dão a tela inteira
+  int32_t getViewportX() const { return vpDatum ? ox : 0; }
+  int32_t getViewportY() const { return vpDatum ? oy : 0; }
+  int32_t getViewportWidth() const { return vpDatum ? vpW : W; }
+  int32_t getViewportHeight() const { return vpDatum ? vpH : H; }
+
+  // ---------- primitivas ----------
+  void drawPixel(int32_t x, int32_t y, uint32_t c) {
+    x += ox;
+    y += oy;
+    if (x < clipX0 || y < clipY0 || x >= clipX1 || y >= clipY1) return;
+    store(x, y, (uint16_t)c);
+    pixelsDrawn++;
+  }
+  uint16_t readPixel(int32_t x, int32_t y) const {
+    x += ox;
+    y += oy;
+    if (x < 0 || y < 0 || x >= W || y >= H) return 0;
+    return readPixelRaw(x, y);
+  }
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t c) {
+    for (int32_t i = 0; i < w; i++) drawPixel(x + i, y, c);
+  }
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t c) {
+    for (int32_t i = 0; i < h; i++) drawPixel(x, y + i, c);
+  }
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c) {
+    for (int32_t j = 0; j < h; j++) drawFastHLine(x, y + j, w, c);
+  }
+  void fillScreen(uint32_t c) { fillRect(0, 0, width(), height(), c); }
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c) {
+    drawFastHLine(x, y, w, c);
+    drawFastHLine(x, y + h - 1, w, c);
+    drawFastVLine(x, y + 1, h - 2, c);
+    drawFastVLine(x + w - 1, y + 1, h - 2, c);
+  }
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t c) {
+    int32_t dx = abs(x1 - x0), dy = -abs(y1 - y0);
+    int32_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1, err = dx + dy;
+    for (;;) {
+      drawPixel(x0, y0, c);
+      if (x0 == x1 && y0 == y1) break;
+      int32_t e2 = 2 * err;
+      if (e2 >= dy) { err += dy; x0 += sx; }
+      if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+  }
+  // Mesmo algoritmo do TFT_eSPI (linhas horizontais por octante)
+  void fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t c) {
+    int32_t x = 0, dx = 1, dy = r + r, p = -(r >> 1);
+    drawFastHLine(x0 - r, y0, dy + 1, c);
+    while (x < r) {
+      if (p >= 0) {
+        drawFastHLine(x0 - x, y0 + r, dx, c);
+        drawFastHLine(x0 - x, y0 - r, dx, c);
+        dy -= 2;
+        p -= dy;
+        r--;
+      }
+      dx += 2;
+      p += dx;
+      x++;
+      drawFastHLine(x0 - r, y0 + x, dy + 1, c);
+      drawFastHLine(x0 - r, y0 - x, dy + 1, c);
+    }
+  }
+  void drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t c) {
+    int32_t f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r;
+    drawPixel(x0, y0 + r, c);
+    drawPixel(x0, y0 - r, c);
+    drawPixel(x0 + r, y0, c);
+    drawPixel(x0 - r, y0, c);
+    while (x < y) {
+      if (f >= 0) { y--; ddy += 2; f += ddy; }
+      x++;
+      ddx += 2;
+      f += ddx;
+      drawPixel(x0 + x, y0 + y, c); drawPixel(x0 - x, y0 + y, c);
+      drawPixel(x0 + x, y0 - y, c); drawPixel(x0 - x, y0 - y, c);
+      drawPixel(x0 + y, y0 + x, c); drawPixel(x0 - y, y0 + x, c);
+      drawPixel(x0 + y, y0 - x, c); drawPixel(x0 - y, y0 - x, c);
+    }
+  }
+  void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t c) {
+    int32_t minX = std::min({ x0, x1, x2 }), maxX = std::max({ x0, x1, x2 });
+    int32_t minY = std::min({ y0, y1, y2 }), maxY = std::max({ y0, y1, y2 });
+    for (int32_t y = minY; y <= maxY; y++) {
+      for (int32_t x = minX; x <= maxX; x++) {
+        int64_t d1 = (int64_t)(x1 - x0) * (y - y0) - (int64_t)(y1 - y0) * (x - x0);
+        int64_t d2 = (int64_t)(x2 - x1) * (y - y1) - (int64_t)(y2 - y1) * (x - x1);
+        int64_t d3 = (int64_t)(x0 - x2) * (y - y2) - (int64_t)(y0 - y2) * (x - x2);
+        bool neg = d1 < 0 || d2 < 0 || d3 < 0, pos = d1 > 0 || d2 > 0 || d3 > 0;
+        if (!(neg && pos)) drawPixel(x, y, c);
+      }
+    }
+  }
+  void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t c) {
+    fillRect(x, y + r, w, h - 2 * r, c);
+    for (int32_t j = 0; j < r; j++) {
+      int32_t dy = r - j;
+      int32_t dx = r - (int32_t)sqrtf((float)(r * r - dy * dy));
+      drawFastHLine(x + dx, y + j, w - 2 * dx, c);
+      drawFastHLine(x + dx, y + h - 1 - j, w - 2 * dx, c);
+    }
+  }
+  void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t c) {
+    drawFastHLine(x + r, y, w - 2 * r, c);
+    drawFastHLine(x + r, y + h - 1, w - 2 * r, c);
+    drawFastVLine(x, y + r, h - 2 * r, c);
+    drawFastVLine(x + w - 1, y + r, h - 2 * r, c);
+  }
+  // Mesma mistura do TFT_eSPI (canais 5/6/5 separados)
+  uint16_t alphaBlend(uint8_t alpha, uint16_t fgc, uint16_t bgc) {
+    uint32_t rxb = bgc & 0xF81F;
+    rxb += ((fgc & 0xF81F) - rxb) * (alpha >> 2) >> 6;
+    uint32_t xgx = bgc & 0x07E0;
+    xgx += ((fgc & 0x07E0) - xgx) * alpha >> 8;
+    return (uint16_t)((rxb & 0xF81F) | (xgx & 0x07E0));
+  }
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+  }
+
+  // ---------- envio direto (janela de endereços, sem recorte) ----------
+  void startWrite() {}
+  void endWrite() {}
+  bool initDMA() { return true; }
+  void dmaWait() {}
+  void setSwapBytes(bool s) { swapBytes = s; }
+  bool getSwapBytes() const { return swapBytes; }
+
+  void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+    winX = x; winY = y; winW = w; winH = h; winPos = 0;
+    bursts++;
+  }
+  void pushBlock(uint16_t c, uint32_t n) {
+    bursts++;
+    while (n--) windowPixel(c);
+  }
+  void pushColors(uint16_t *data, uint32_t n, bool swap = true) {
+    bursts++;
+    for (uint32_t i = 0; i < n; i++) windowPixel(swap ? data[i] : hostBswap16(data[i]));
+  }
+  void pushPixels(const void *data, uint32_t n) {
+    pushColors((uint16_t *)data, n, swapBytes);
+  }
+
+  // Imagem recortada pelo viewport; sem troca de bytes a cor chega invertida
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data) {
+    bursts++;
+    for (int32_t j = 0; j < h; j++) {
+      for (int32_t i = 0; i < w; i++) {
+        int32_t px = x + i + ox, py = y + j + oy;
+        if (px < clipX0 || py < clipY0 || px >= clipX1 || py >= clipY1) continue;
+        uint16_t c = data[(size_t)j * w + i];
+        store(px, py, swapBytes ? c : hostBswap16(c));
+        pixelsPushed++;
+      }
+    }
+  }
+  void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data) {
+    pushImage(x, y, w, h, data);
+  }
+
+  // ---------- texto sintético ----------
+  void setTextFont(uint8_t f) { font = f; }
+  void setTextSize(uint8_t s) { textsize = s ? s : 1; }
+  void setTextDatum(uint8_t d) { datum = d; }
+  uint8_t getTextDatum() const { return datum; }
+  void setTextColor(uint16_t c) { textFg = textBg = c; }
+  void setTextColor(uint16_t c, uint16_t b, bool = false) { textFg = c; textBg = b; }
+  void setTextWrap(bool, bool = false) {}
+  void setAttribute(uint8_t a, uint8_t v) { if (a < 8) attrs[a] = v; }
+  uint8_t getAttribute(uint8_t a) const { return a < 8 ? attrs[a] : 0; }
+
+  static int charWidth(uint8_t f, char c) {
+    switch (f) {
+      case 2: return (c == 'i' || c == 'l' || c == '.' || c == ' ' || c == '|') ? 4
+                   : (c == 'm' || c == 'w' || c == 'M' || c == 'W') ? 11 : 7;
+      case 4: return 14;
+      case 6: return 26;
+      case 7: return 32;
+      case 8: return 55;
+      default: return 6;
+    }
+  }
+  int16_t textWidth(const char *s, uint8_t f) const {
+    int w = 0;
+    for (; *s; s++) w += charWidth(f, *s);
+    return (int16_t)(w * textsize);
+  }
+  int16_t textWidth(const char *s) const { return textWidth(s, font); }
+  int16_t textWidth(const String &s, uint8_t f) const { return textWidth(s.c_str(), f); }
+  int16_t textWidth(const String &s) const { return textWidth(s.c_str(), font); }
+  int16_t fontHeight(int16_t f) const {
+    int h = f == 2 ? 16 : f == 4 ? 26 : f == 6 ? 48 : f == 7 ? 48 : f == 8 ? 75 : 8;
+    return (int16_t)(h * textsize);
+  }
+  int16_t fontHeight() const { return fontHeight(font); }
+
+  int16_t drawString(const char *s, int32_t x, int32_t y, uint8_t f) {
+    uint8_t old = font;
+    font = f;
+    int16_t w = drawString(s, x, y);
+    font = old;
+    return w;
+  }
+  int16_t drawString(const char *s, int32_t x, int32_t y) {
+    textDraws++;
+    int32_t w = textWidth(s, font), h = fontHeight(font);
+    int hx = datum % 3, vy = datum / 3;
+    int32_t bx = x - (hx == 1 ? w / 2 : hx == 2 ? w : 0);
+    int32_t by = y - (vy == 1 ? h / 2 : vy == 2 ? h : 0);
+    int32_t cx = bx;
+    for (const char *p = s; *p; p++) {
+      int32_t cw = charWidth(font, *p) * textsize;
+      for (int32_t j = 0; j < h; j++) {
+        for (int32_t i = 0; i < cw; i++) {
+          bool on = ((i / textsize) * 5 + (j / textsize) * 3 + (uint8_t)*p) % 4 == 0 && i < cw - textsize;
+          if (on) drawPixel(cx + i, by + j, textFg);
+          else if (textFg != textBg) drawPixel(cx + i, by + j, textBg);
+        }
+      }
+      cx += cw;
+    }
+    return (int16_t)w;
+  }
+  int16_t drawString(const String &s, int32_t x, int32_t y) { return drawString(s.c_str(), x, y); }
+  int16_t drawString(const String &s, int32_t x, int32_t y, uint8_t f) { return drawString(s.c_str(), x, y, f); }
+  int16_t drawCentreString(const char *s, int32_t x, int32_t y, uint8_t f) {
+    uint8_t d = datum;
+    datum = TC_DATUM;
+    int16_t w = drawString(s, x, y, f);
+    datum = d;
+    return w;
+  }
+
+protected:
+  void allocate(int16_t w, int16_t h) {
+    W = w;
+    H = h;
+    fb.assign((size_t)w * h, 0);
+    resetViewport();
+  }
+  void store(int32_t x, int32_t y, uint16_t c) {
+    fb[(size_t)y * W + x] = swappedStore ? hostBswap16(c) : c;
+  }
+  void windowPixel(uint16_t c) {
+    if (winW <= 0) return;
+    int32_t px = winX + winPos % winW, py = winY + winPos / winW;
+    winPos++;
+    if (px >= 0 && py >= 0 && px < W && py < H) store(px, py, c);
+    pixelsPushed++;
+  }
+
+  int16_t W = 0, H = 0;
+  std::vector<uint16_t> fb;
+  bool swappedStore = false;   // sprites: pixels na ordem de bytes do display
+  int32_t clipX0 = 0, clipY0 = 0, clipX1 = 0, clipY1 = 0;
+  int32_t ox = 0, oy = 0, vpW = 0, vpH = 0;
+  bool vpDatum = false;
+  bool swapBytes = false;
+  int32_t winX = 0, winY = 0, winW = 0, winH = 0, winPos = 0;
+  uint8_t font = 1, datum = TL_DATUM;
+  uint16_t textFg = TFT_WHITE, textBg = TFT_WHITE;
+  uint8_t attrs[8] = { 0, 1, 1, 0, 0, 0, 0, 0 };
+};
+
+// Sprite: mesmo desenho, buffer próprio; pushSprite copia para o display pai
+class TFT_eSprite : public TFT_eSPI {
+public:
+  explicit TFT_eSprite(TFT_eSPI *parent) : TFT_eSPI(0, 0), parent(parent) { swappedStore = true; }
+
+  inline static size_t hostLimitBytes = SIZE_MAX;   // simula falta de memória
+  inline static int hostLive = 0;                   // sprites alocados agora
+
+  void setColorDepth(int8_t) {}
+  void *createSprite(int16_t w, int16_t h, uint8_t = 1) {
+    if (made) return fb.data();
+    if ((size_t)w * h * 2 > hostLimitBytes) return nullptr;
+    allocate(w, h);
+    made = true;
+    hostLive++;
+    return fb.data();
+  }
+  void deleteSprite() {
+    if (!made) return;
+    made = false;
+    hostLive--;
+    allocate(0, 0);
+  }
+  bool created() const { return made; }
+  void *getPointer() { return made ? fb.data() : nullptr; }
+  void fillSprite(uint32_t c) { fillRect(0, 0, width(), height(), c); }
+
+  void pushSprite(int32_t x, int32_t y) { copyTo(x, y, false, 0); }
+  void pushSprite(int32_t x, int32_t y, uint16_t transp) { copyTo(x, y, true, transp); }
+
+private:
+  void copyTo(int32_t x, int32_t y, bool useTransp, uint16_t transp) {
+    if (!made) return;
+    parent->bursts++;
+    for (int32_t j = 0; j < H; j++) {
+      for (int32_t i = 0; i < W; i++) {
+        uint16_t c = readPixelRaw(i, j);
+        if (useTransp && c == transp) continue;
+        parent->drawPixel(x + i, y + j, c);
+      }
+    }
+  }
+
+  TFT_eSPI *parent;
+  bool made = false;
+};
+
+#endif // HOST_TFT_ESPI_H
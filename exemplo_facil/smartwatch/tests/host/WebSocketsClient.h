@@ -0,0 +1,43 @@
+#ifndef HOST_WEBSOCKETSCLIENT_H
+#define HOST_WEBSOCKETSCLIENT_H
+
+// Cliente WebSocket que só guarda os frames enviados, para o teste conferir
+
+#include <Arduino.h>
+#include <vector>
+
+enum WStype_t {
+  WStype_ERROR,
+  WStype_DISCONNECTED,
+  WStype_CONNECTED,
+  WStype_TEXT,
+  WStype_BIN
+};
+
+struct HostWsFrame {
+  bool binary;
+  std::string data;
+};
+
+class WebSocketsClient {
+public:
+  std::vector<HostWsFrame> sent;
+  bool connected = true;
+
+  bool sendTXT(const char *p, size_t n) { return record(false, p, n); }
+  bool sendTXT(const char *p) { return record(false, p, strlen(p)); }
+  bool sendTXT(String &s) { return record(false, s.c_str(), s.length()); }
+  bool sendTXT(uint8_t *p, size_t n) { return record(false, (const char *)p, n); }
+  bool sendBIN(const uint8_t *p, size_t n) { return record(true, (const char *)p, n); }
+  bool isConnected() { return connected; }
+  void loop() {}
+
+private:
+  bool record(bool bin, const char *p, size_t n) {
+    if (!connected) return false;
+    sent.push_back({ bin, std::string(p, n) });
+    return true;
+  }
+};
+
+#endif // HOST_WEBSOCKETSCLIENT_H
@@ -0,0 +1,29 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+// WiFi do ESP32 no host: só o IP do ponto de acesso (hostSoftApIp)
+
+#include <Arduino.h>
+
+class IPAddress {
+public:
+  IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : o{ a, b, c, d } {}
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", o[0], o[1], o[2], o[3]);
+    return String(buf);
+  }
+private:
+  uint8_t o[4];
+};
+
+inline IPAddress hostSoftApIp(192, 168, 4, 1);
+
+class WiFiClass {
+public:
+  IPAddress softAPIP() { return hostSoftApIp; }
+};
+
+inline WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
@@ -0,0 +1,13 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+// I2C sem barramento: os sensores dos testes são alimentados direto
+
+#include <Arduino.h>
+
+struct TwoWire {
+  bool begin(int sda = -1, int scl = -1) { (void)sda; (void)scl; return true; }
+};
+inline TwoWire Wire;
+
+#endif // HOST_WIRE_H
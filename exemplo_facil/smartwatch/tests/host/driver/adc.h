@@ -0,0 +1,15 @@
+#ifndef HOST_DRIVER_ADC_H
+#define HOST_DRIVER_ADC_H
+
+#include <driver/i2s.h>
+
+enum adc_unit_t { ADC_UNIT_1 };
+enum adc_bits_width_t { ADC_WIDTH_BIT_12 = 3 };
+enum adc_atten_t { ADC_ATTEN_DB_11 = 3 };
+enum adc1_channel_t { ADC1_CHANNEL_7 = 7 };
+
+inline esp_err_t adc1_config_width(adc_bits_width_t) { return ESP_OK; }
+inline esp_err_t adc1_config_channel_atten(adc1_channel_t, adc_atten_t) { return ESP_OK; }
+inline esp_err_t i2s_set_adc_mode(adc_unit_t, adc1_channel_t) { return ESP_OK; }
+
+#endif // HOST_DRIVER_ADC_H
@@ -0,0 +1,122 @@
+#ifndef HOST_DRIVER_I2S_H
+#define HOST_DRIVER_I2S_H
+
+// ==========================================
+// I2S-ADC DE MENTIRA - DMA alimentado pelo teste
+// ==========================================
+// hostI2sDma(n) completa n buffers DMA: as palavras vão para a FIFO do driver
+// e um I2S_EVENT_RX_DONE por buffer entra na fila de eventos. i2s_read()
+// entrega no máximo hostI2sMaxRead bytes por chamada (pode ser ímpar), como
+// o driver real ao devolver o que já há no DMA. A fila do FreeRTOS fica aqui
+// porque só a captura de áudio a usa.
+
+#include <Arduino.h>
+#include <deque>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_INTR_FLAG_LEVEL1 (1 << 1)
+
+// ---------- fila do FreeRTOS ----------
+#define pdTRUE 1
+#define pdFALSE 0
+typedef int BaseType_t;
+
+enum i2s_event_type_t { I2S_EVENT_DMA_ERROR, I2S_EVENT_TX_DONE, I2S_EVENT_RX_DONE };
+struct i2s_event_t {
+  i2s_event_type_t type;
+  size_t size;
+};
+
+struct HostQueue {
+  std::deque<i2s_event_t> items;
+};
+typedef HostQueue *QueueHandle_t;
+
+inline BaseType_t xQueueReset(QueueHandle_t q) {
+  if (q) q->items.clear();
+  return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t q, void *out, uint32_t ticks) {
+  (void)ticks;
+  if (!q || q->items.empty()) return pdFALSE;
+  *(i2s_event_t *)out = q->items.front();
+  q->items.pop_front();
+  return pdTRUE;
+}
+
+// ---------- driver ----------
+enum i2s_port_t { I2S_NUM_0 };
+enum i2s_mode_t { I2S_MODE_MASTER = 1, I2S_MODE_RX = 4, I2S_MODE_ADC_BUILT_IN = 32 };
+enum i2s_bits_per_sample_t { I2S_BITS_PER_SAMPLE_16BIT = 16 };
+enum i2s_channel_fmt_t { I2S_CHANNEL_FMT_ONLY_LEFT = 4 };
+enum i2s_comm_format_t { I2S_COMM_FORMAT_STAND_I2S = 1 };
+
+struct i2s_config_t {
+  i2s_mode_t mode;
+  uint32_t sample_rate;
+  i2s_bits_per_sample_t bits_per_sample;
+  i2s_channel_fmt_t channel_format;
+  i2s_comm_format_t communication_format;
+  int intr_alloc_flags;
+  int dma_buf_count;
+  int dma_buf_len;
+  bool use_apll;
+};
+
+inline HostQueue hostI2sQueue;
+inline std::deque<uint8_t> hostI2sFifo;    // bytes prontos para i2s_read()
+inline size_t hostI2sMaxRead = SIZE_MAX;   // limite por chamada de i2s_read()
+inline int hostI2sBufLen = 0;              // amostras por buffer DMA
+inline bool hostI2sEnabled = false;
+inline uint32_t hostI2sSample = 0;         // contador da amostra gerada
+
+// Completa n buffers; gen(i) dá os 12 bits da i-ésima amostra desde o início
+template <typename Gen>
+inline void hostI2sDma(int n, Gen gen) {
+  if (!hostI2sEnabled) return;
+  for (int b = 0; b < n; b++) {
+    for (int i = 0; i < hostI2sBufLen; i++) {
+      uint16_t word = (uint16_t)((7 << 12) | (gen(hostI2sSample++) & 0x0FFF));  // canal 7 no topo
+      hostI2sFifo.push_back(word & 0xFF);
+      hostI2sFifo.push_back(word >> 8);
+    }
+    hostI2sQueue.items.push_back({ I2S_EVENT_RX_DONE, (size_t)hostI2sBufLen * 2 });
+  }
+}
+
+inline esp_err_t i2s_driver_install(i2s_port_t, const i2s_config_t *cfg, int, QueueHandle_t *q) {
+  hostI2sBufLen = cfg->dma_buf_len;
+  *q = &hostI2sQueue;
+  return ESP_OK;
+}
+
+inline esp_err_t i2s_read(i2s_port_t, void *dst, size_t size, size_t *bytesRead, uint32_t ticks) {
+  (void)ticks;
+  size_t n = std::min(std::min(size, hostI2sMaxRead), hostI2sFifo.size());
+  for (size_t i = 0; i < n; i++) {
+    ((uint8_t *)dst)[i] = hostI2sFifo.front();
+    hostI2sFifo.pop_front();
+  }
+  *bytesRead = n;
+  return ESP_OK;
+}
+
+inline esp_err_t i2s_zero_dma_buffer(i2s_port_t) {
+  hostI2sFifo.clear();
+  return ESP_OK;
+}
+
+inline esp_err_t i2s_adc_enable(i2s_port_t) {
+  hostI2sEnabled = true;
+  return ESP_OK;
+}
+
+inline esp_err_t i2s_adc_disable(i2s_port_t) {
+  hostI2sEnabled = false;
+  return ESP_OK;
+}
+
+#endif // HOST_DRIVER_I2S_H
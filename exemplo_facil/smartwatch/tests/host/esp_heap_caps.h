@@ -0,0 +1,18 @@
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+// Heap com capacidades: no PC toda memória serve para DMA
+
+#include <Arduino.h>
+
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+
+inline void *heap_caps_malloc(size_t n, uint32_t caps) { (void)caps; return malloc(n); }
+inline void heap_caps_free(void *p) { free(p); }
+inline size_t heap_caps_get_free_size(uint32_t caps) { (void)caps; return 200000; }
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) { (void)caps; return 100000; }
+
+#endif // HOST_ESP_HEAP_CAPS_H
@@ -0,0 +1,6 @@
+#ifndef HOST_SPO2_ALGORITHM_H
+#define HOST_SPO2_ALGORITHM_H
+
+// Nenhuma função da biblioteca é usada pelos headers testados
+
+#endif // HOST_SPO2_ALGORITHM_H
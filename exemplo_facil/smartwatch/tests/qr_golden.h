@@ -0,0 +1,195 @@
+#ifndef QR_GOLDEN_H
+#define QR_GOLDEN_H
+
+// Matrizes de referência para test_qr.cpp, geradas uma vez com a
+// implementação QR de Kazuhiko Arase (vendor/QRCode do qrcode-terminal),
+// forçando versão, nível e máscara: QRCode(versão, nível), addData(texto),
+// makeImpl(false, máscara). Versão e nível são os que a referência aceita
+// como menor versão e maior nível. "HELLO" e o texto de 18 bytes têm as 8
+// máscaras; os demais, a máscara que o codificador escolheu.
+// Linhas de (tamanho + 7) / 8 bytes em hexadecimal, bit 7 = coluna da esquerda.
+
+struct QrGolden {
+  const char *text;
+  uint8_t version;
+  uint8_t ecc;
+  uint8_t mask;
+  const char *rows;
+};
+
+static const QrGolden QR_GOLDEN[] = {
+  { "HELLO",
+    1, QR_ECC_H, 0,
+    "FEEBF8823A08BA02E8BAD2E8BA4AE8823A08FEABF80048002EEC480D1C107BB2"
+    "F83D9E10BAD4A000BB30FE553882D380BAB538BA0930BA8EA8823290FE7D38" },
+  { "HELLO",
+    1, QR_ECC_H, 1,
+    "FE3BF882EA08BAD2E8BA82E8BA9AE882EA08FEABF800180027BDF05849402EE7"
+    "A868CB40EF81F000EE60FE80688286D0BA6068BA5C60BADBF88267C0FE2868" },
+  { "HELLO",
+    1, QR_ECC_H, 2,
+    "FE8BF882A208BAE2E8BA4AE8BA2AE882A208FEABF800D0003A8F38C800604351"
+    "70F8826082372800A740FE36B0824FF0BAD6B0BA9540BAED20822EE0FE1EB0" },
+  { "HELLO",
+    1, QR_ECC_H, 3,
+    "FE0BF8827A08BA0AE8BA4AE8BAF2E8824A08FEABF800880033E680C80060F78A"
+    "1821EFD082372800FC28FEDB00824FF0BA0DD8BAF8F0BAED20827588FE7300" },
+  { "HELLO",
+    1, QR_ECC_H, 4,
+    "FE4BF882E208BA5AE8BA72E8BA6AE882E208FEABF800E8000F4B10B9C778CF69"
+    "9074BA80F3F03000E058FE8E5082F710BA91A8BA5258BA55C0821600FE59A8" },
+  { "HELLO",
+    1, QR_ECC_H, 5,
+    "FEBBF8826208BAE2E8BA2AE8BAAAE8826208FEABF8009000060AA8F0E3E84351"
+    "70E8C360EF81F000E640FE36B082AC78BA56B0BA5440BA5BF8826FE0FE1EB0" },
+  { "HELLO",
+    1, QR_ECC_H, 6,
+    "FE3BF8826208BAC2E8BAAAE8BA3AE8825208FEABF80010001B2860F0E3E867C3"
+    "38E4F3A0EF81F000E058FE9220822C78BAC4F8BAE480BA5BF88269F8FE3A20" },
+  { "HELLO",
+    1, QR_ECC_H, 7,
+    "FEEBF8829A08BA12E8BAD2E8BAEAE882AA08FEABF80068001279D80D1C103296"
+    "68190C58BAD4A0009FA0FE4770825380BA11A8BA9B78BA0EA8821600FE6F70" },
+  { "lsz6/GNU",
+    1, QR_ECC_Q, 5,
+    "FEA3F882AA08BA62E8BA62E8BA52E8823A08FEABF800180043E418415FB0A22C"
+    "507438E0FFA60000BE08FED210820D28BA7848BA6860BA02D882A1A0FE1490" },
+  { "Wdkry6/FMTbi",
+    1, QR_ECC_M, 2,
+    "FE1BF8820A08BAA2E8BAD2E8BAFAE882CA08FEABF800D800BE6BE0D9ED68BE92"
+    "309C04F823B09000CF90FE6D5082FDE0BA8458BAA4A0BAF900822460FEABD0" },
+  { "9BIPWelsz6-GNUb",
+    1, QR_ECC_L, 4,
+    "FEEBF882AA08BA9AE8BAF2E8BA02E882DA08FEABF8006000CE5978A11FB816E6"
+    "F0A09D909AB1B000CC80FE228082A898BAF960BA0AB8BA22C082A000FE9568" },
+  { "hov29CJQXemt07-HOV",
+    2, QR_ECC_Q, 0,
+    "FEA03F8082F3A080BAF32E80BA9C2E80BADE2E80821B2080FEAABF8000A10000"
+    "6B19AF8060DDE0804B926980916F9C808B13FD00515E65808B24598078B29500"
+    "8376FC0000BE8F80FE9BAF8082558980BABCFA80BA7B0400BAB2DC8082DC9900"
+    "FE36A380" },
+  { "hov29CJQXemt07-HOV",
+    2, QR_ECC_Q, 1,
+    "FE753F808226A080BA262E80BAC92E80BA0B2E8082CE2080FEAABF8000F40000"
+    "624CB4003588B5801EC73C80C43AC980DE46A800040B3080DE710C802DE7C000"
+    "D623F90000EB8A80FE4EAA8082008C80BA69FF80BA2E5100BAE789808289CC00"
+    "FE63F680" },
+  { "hov29CJQXemt07-HOV",
+    2, QR_ECC_Q, 2,
+    "FEC3BF80826FA080BA10AE80BA002E80BABDAE8082872080FEAABF80003D0000"
+    "7F7A1880A5C191007371E7805473ED00B3F0730094421400B3C7D780BDAEE480"
+    "BB95FA0000A28E00FEF8A98082C98800BADFFC80BAE77580BAD1528082C0E880"
+    "FE552D80" },
+  { "hov29CJQXemt07-HOV",
+    2, QR_ECC_Q, 3,
+    "FE43BF8082B4A080BAFD2E80BA002E80BA66AE80826AA080FEAABF8000660000"
+    "76178300A5C19100C7AA8A008D1E5B80B3F07300209979806AAA6100BDAEE480"
+    "0F4EFF8000CF8880FE78A98082928D80BA32FA00BAE77580BA8A3F0082AD5E00"
+    "FE552D80" },
+  { "hov29CJQXemt07-HOV",
+    2, QR_ECC_Q, 4,
+    "FE04BF808228A080BAA82E80BA38AE80BAFAAE8082C02080FEAABF8000058000"
+    "4ABD5A00D4068D00FF490400D84B0E80C2376F00E58508003FFF340031960700"
+    "CA52FE0000E58A00FE40AA0082718B80BA98F880BA206980BA69B10082F80B00"
+    "FE123180" },
+  { "hov29CJQXemt07-HOV",
+    2, QR_ECC_Q, 5,
+    "FEF53F8082AEA080BA10AE80BA63AE80BA3DAE8082462080FEAABF80007C0000"
+    "43FA41809D221F007371E7804432E900DE46A80084031000B3C7D780854D6A80"
+    "BB95FA0000E38A00FECEAA8082088C00BA5FFC80BA04FB80BA5152808281EC80"
+    "FE63F680" },
+  { "hov29CJQXemt07-HOV",
+    2, QR_ECC_Q, 6,
+    "FE753F8082A8A080BA342E80BAE3AE80BAAFAE808276A080FEAABF8000FA0000"
+    "5EDEED009D221F0057E3AE8048022A00DE46A800E5850800FAE34580854D6A80"
+    "9F07FB0000D38900FE4EAA80828E8C00BAFBFE80BA84FB80BA431B8082B12F80"
+    "FE63F680" },
+  { "hov29CJQXemt07-HOV",
+    2, QR_ECC_Q, 7,
+    "FEA03F8082572080BAE12E80BA9C2E80BA7AAE8082892080FEAABF8000858000"
+    "578BF68060DDE08002B6FB80B5FDD5808B13FD00187AF780AFB6108078B29500"
+    "CA52FE0000AC8E80FE9BAF8082F18B80BA2EFB80BAFB0400BA164E8082CED000"
+    "FE36A380" },
+  { "https://neurelix.com.br",
+    2, QR_ECC_M, 1,
+    "FEDE3F80827C2080BAE42E80BA372E80BA3AAE8082862080FEAABF8000620000"
+    "A30012806CB5B5803A2D3680112A5C009B2AB080110DF180CF49A68030F8DC00"
+    "CE20F90000808880FED2A88082618980BA19F880BA2B4B00BA8A9D8082589800"
+    "FECEC480" },
+  { "bipw3.DKRYgnu18BIPWdlsz6/GNUbiqx4",
+    3, QR_ECC_M, 3,
+    "FEA1DBF882F30208BA7702E8BA90EAE8BA2C72E8824A7208FEAAABF800BE4000"
+    "B756C2581C71FBC8A27B2DD0A5EF3FC8EB8804707124563806F2FBB8BC959980"
+    "CFE8E18838CDDD20A75947A0049049E85A753FC8009698D8FEC4EAB08288A898"
+    "BA03CF90BAEFDC08BA885B2882332450FEBB3B70" },
+  { "gnu18BIPWdlsz6/GNUbiqx4.DLSZgnv29BIQXels07-GNVcjqx5:EL",
+    4, QR_ECC_M, 5,
+    "FE2A40BF80829E8EA080BAB485AE80BAA009AE80BA256E2E808266A62080FEAA"
+    "AABF8000B0310000828F7867006001537C802FC10A61007CAB218F00A216E1B1"
+    "007466B47280E2BA0A01004897203F006EACE7530075BEF95780FA171BF380B8"
+    "73726280C38B8B9C00B412FBD800ABCBC25700A576236E80D7DF4DFA8000E4BC"
+    "8B80FE1D29AE008216038A00BA122AFD00BA689EC380BA7AD0CB808263A10600"
+    "FEB20E9F00" },
+  { "WIFI:S:Smartwatch Config;T:nopass;;\nRede: Smartwatch Config\nConfig: http://192.168.4.1",
+    5, QR_ECC_L, 2,
+    "FE2D7D2BF882A7A0DA08BA0D2622E8BAEBC25AE8BA40116AE882D9045A08FEAA"
+    "AAABF80072B4B000FBD058D550E52E156B58DB270C5238956DBD3440122BC61E"
+    "A02CA01D48703E7928DC68C072A60C98131072268018EE5929481E2762D5B83D"
+    "6D3F88002A0AE266F8C9007909289A59423618ADD29CA118BAD1F2EFE0AC8E7D"
+    "01488B67CA31188C6D1C1E109A4BF3FFB800801908D8FEF92C3AF8827297A880"
+    "BA90625FB8BAEE4C6E98BAE722D958828C168F88FEABF4D538" },
+  { "NUbipx4.DKSZgnu29BIPXelsz7-GNUcjqx4:ELSZhov29CJQXemt07-HOVcjry5:EMTahow3 CJRYfmt18AHOWdkry6/FMTbipw3.DKRYgnu18BIPWdlsz6/GNUbiqx4.DLSZgn",
+    7, QR_ECC_L, 2,
+    "FE00A65E8BF88293EDBFD208BA489CACD2E8BACDF2211AE8BA721F8FBAE882B0"
+    "48F54208FEAAAAAAABF8001D18A66800FBE85F870D50D57D394F9CA8025E29B1"
+    "057004AF51CEE8A81655FEA7024061E611931C982E0F25ACAFE0058275E25A60"
+    "964726E54A5084A8EB571C8896A589E99BB0C5CE91FB43F0AFA06FE75FB04886"
+    "58D288B8BAC04A843AB0A8D498D0E8F0AFC84FA05FD8B8352A07843026802BE5"
+    "7170D1970FD91E682FD978632D38243A4C4FDE0837A62802AD30A90A75938228"
+    "D33F24260DD00DC8F29E92000BD988FCE0B079A8FDE25A789BDD2FA12FB000B8"
+    "58D658E8FEC1CAD36AB0826598A9B8B0BAC84FD34F88BAF521538F40BAC07C84"
+    "3A4882D77C4035E0FEECA5C776F0" },
+  { "3 CJQYfmt08AHOVdkry5/FMTaipw3 DKRYfnu18AIPWdksz6/FNUbipx4.DKSZgnu29BIPXelsz7-GNUcjqx4:ELSZhov29CJQXemt07-HOVcjry5:EMTahow3 CJRYfmt18AHOWdkry6/FMTbipw3.DKRYgnu18BIPWdlsz6/GNUbiqx4.DLSZgnv29BIQXels07-GNVcjqx5:ELSahov2 CJQXfmt07AHOVck",
+    10, QR_ECC_L, 3,
+    "FE9F31D799EF3F80824B43B125452080BA91ABD3140B2E80BA8461D77A112E80"
+    "BADA133E8F052E808229FB63CCD62080FEAAAAAAAAAABF800078532392918000"
+    "F2C9DBBF7B834E80956252A745B1CB80A3BCDFCAC931C2803C4F4107BEA3A100"
+    "2F0732617C70E0809D4B18624E547600133CDF19627A4400CCA7A89220F81F80"
+    "A3878559C10DF180348F9125655615006BF9820AA6B63300384F9E6150F16800"
+    "5B64C61B11C2EB001134837F4D79DF80E276DB9EA7679080D89D77B1579A7080"
+    "CE052907EE32A5002035382863C42500FFC772BEA563F80078840962F0E78F00"
+    "7AF1A9ABC218AC8058DA8722619688009F981CFF7715FB0031422A42C0B05900"
+    "E69E4E0031941C80981A67875D60A000D7958C9D7283F380B503BDDCC5DF4C00"
+    "9ED665C03852A480D9C47701D708B600765D9B7C21240A80F9A53EB74F6F2E00"
+    "B3D65DACC93B5C80BDC3E36E2AD68880AE5C331611A8C5005C278A57DFAFC800"
+    "4345151212E48180DDE9758288686000A6984A6D2554B580F8C3F7E7B4097D00"
+    "020DF87E5E56F88000871F231E9D8D00FE1272AA4C54AB008209E3A3854D8E80"
+    "BA36197FF57FFA80BAB571DFF85BBD00BAA9F621CA57C600828DAC82E258E880"
+    "FEFA068881C78000" },
+  { "fmt07AHOVckry5:FMTahpw3 CKRYfmu18AHPWdkrz6/FMUbipw4.DKRZgnu19BIPWelsz6-GNUbjqx4.ELSZgov29BJQXelt07-GOVcjqy5:ELTahov3 CJQYfmt08AHOVdkry5/FMTaipw3 DKRYfnu18AIPWdksz6/FNUbipx4.DKSZgnu29BIPXelsz7-GNUcjqx4:ELSZhov29CJQXemt07-HOVcjry5:EMTahow3 CJRYfmt18AHOWdkry6/FMTbipw3.DKRYgnu18BIPWdlsz6/GNUbiqx4.DLSZgnv29BIQXels07-GNVcjqx5:ELSahov2 CJQXfmt07AHOVckry5:FMTahpw3 CKRYfmu18AHPWdkrz6/FMUbipw4.DKRZgnu19BIPWelsz6-GNUbjqx4.ELSZgov29B",
+    13, QR_ECC_L, 4,
+    "FE9AEBD4C3FC727BF882C9E3371D5E818208BAFF234BEFE448E2E8BA955B5846"
+    "900F0AE8BA3819F2FBED376AE882BF998D8FFC58A208FEAAAAAAAAAAAAABF800"
+    "47E5878F5C84C000CE496C2EFD2BA3A978BDFB0B94D3E8665B90EAD31E4A96A9"
+    "6C7C70A0D7240F2D67493C10A7AB25263C2BF2A428ED7118F6DAED365ED82E09"
+    "65F0608327D6908892E501771CA5BC88D3656C2A2D4DE3B55019F60F94532936"
+    "4BF0EF742662B7298D6210A4B79C0F35471D00088ABBE52E242BB4C1282C3038"
+    "A6FAFCAE5FC052347D98408A2F8200B908C569350AA5BD90BE126DAA8B4BF5D5"
+    "4819980F9456B1364A705E3F25F8E725856310FD7B9C9136451E0000B2CDE52F"
+    "2C2DB4DD30F5573CA17AFCAFDFE012F1079CC50D2A824021B3326E248B8591D0"
+    "AFF07DB3FB2BB4DFC808BF0F948EB0B658D09AC01599AFE405BAD0F88DB2F88E"
+    "1D3E3890EFA7E53FFA5DB49FF0A5572CA002ECAF8960F38527BC0D65728DC064"
+    "513A3160C9979B40A2327CF2CB4FB4C6D06CB54F94EEBCAFCF483E14969C27F6"
+    "083DD0C9D7327FE41BBC21104364E53F5B5AF0867814512DA102ED3E89207F8E"
+    "25BE0BE5620CC04417BEB160A9B6BA502AD278F75B0FF08ED0C8D54F92E7ED2F"
+    "DF701F3EAEAC375648CDC8F12B3A37641B846910CB32F53E433AE08C1871AB6D"
+    "D10BED36992017A214CEEBF56A1CD0A9C5F6F902B3B5BFD0E6B1B8F75B0BF08E"
+    "D8E5164FD2E3ED37D928AEBF2C2E515E10CCB08179EEB700189669889A54F43E"
+    "FD3AE68F9000B16BD48BED3208E0FE0912CCAB706B0AB082BCF63F8B9214F890"
+    "BAB9B0E7FF2BF0CFB8BA0E5FD2426D36CCB8BA5D0456B0DED0438082B1F6F9F8"
+    "78C64C00FEC2F43EFD4C868908" },
+};
+
+#define QR_GOLDEN_COUNT (sizeof(QR_GOLDEN) / sizeof(QR_GOLDEN[0]))
+
+#endif // QR_GOLDEN_H
@@ -0,0 +1,149 @@
+// Captura I2S-ADC: leituras parciais não desalinham as amostras; perdas, taxa
+// e envio do clipe gravado com a conexão caindo
+#include "test_util.h"
+#include "config.h"
+#include "audio.h"
+
+WebSocketsClient webSocket;
+
+static uint16_t adcAt(uint32_t i) {
+  return (uint16_t)((i * 37 + (i >> 5)) & 0x0FFF);
+}
+
+// Decodifica "audio|<seq>|-1|<base64>" de volta para bytes PCM8
+static std::string framePayload(const std::string &f, uint32_t &seq) {
+  int a = f.find('|'), b = f.find('|', a + 1), c = f.find('|', b + 1);
+  seq = (uint32_t)atol(f.c_str() + a + 1);
+  std::string out;
+  uint32_t acc = 0;
+  int bits = 0;
+  for (size_t i = c + 1; i < f.size() && f[i] != '='; i++) {
+    acc = (acc << 6) | (uint32_t)(strchr(BASE64_TABLE, f[i]) - BASE64_TABLE);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      out.push_back((char)(acc >> bits));
+    }
+  }
+  return out;
+}
+
+// Completa `bufs` buffers DMA e chama o loop até todos virarem chunks
+static void capture(int bufs, size_t maxRead) {
+  hostI2sMaxRead = maxRead;
+  size_t before = webSocket.sent.size();
+  hostI2sDma(bufs, adcAt);
+  for (int guard = 0; webSocket.sent.size() < before + bufs && guard < 100000; guard++) updateAudio();
+  CHECK_EQ(webSocket.sent.size(), before + bufs);
+}
+
+// Ticks do envio cadenciado do clipe
+static void clipTicks(int n) {
+  for (int i = 0; i < n; i++) {
+    hostClockAdvance(AUDIO_CLIP_UPLOAD_INTERVAL_MS);
+    updateAudio();
+  }
+}
+
+// Clipe gravado: sem conexão o envio pausa sem consumir chunks; se a conexão
+// cai depois do clip_start, o clipe inteiro é reenviado na seguinte
+static void checkClipUpload() {
+  stopStreaming();
+  hostI2sQueue.items.clear();
+  hostI2sFifo.clear();
+  webSocket.connected = false;
+  CHECK(startRecording(1));
+  for (int i = 0; i < 5; i++) {
+    hostI2sDma(1, adcAt);
+    updateAudio();
+  }
+  CHECK_EQ(clipWritten, 5);
+  hostClockAdvance(1000);
+  updateAudio();                      // fim da gravação
+  CHECK(clipUploading);
+
+  webSocket.sent.clear();
+  clipTicks(50);
+  CHECK(webSocket.sent.empty());
+  CHECK_EQ(clipReadPos, 0);
+
+  // Conecta, envia clip_start e dois chunks, cai de novo
+  webSocket.connected = true;
+  clipTicks(3);
+  CHECK_EQ(webSocket.sent.size(), 3);
+  CHECK_EQ(clipReadPos, 2);
+  webSocket.connected = false;
+  clipTicks(10);
+  CHECK_EQ(clipReadPos, 0);
+
+  webSocket.sent.clear();
+  webSocket.connected = true;
+  for (int guard = 0; clipUploading && guard < 100; guard++) clipTicks(1);
+  CHECK(!clipUploading);
+  CHECK_EQ(webSocket.sent.size(), 7);
+  if (webSocket.sent.size() != 7) return;
+  CHECK(webSocket.sent[0].data == "clip_start|5|" + std::to_string((int)clipCodec));
+  for (uint32_t i = 0; i < 5; i++) {
+    uint32_t seq;
+    std::string pcm = framePayload(webSocket.sent[1 + i].data, seq);
+    CHECK(webSocket.sent[1 + i].data.compare(0, 5, "clip|") == 0);
+    CHECK_EQ(seq, i);
+    CHECK_EQ(pcm.size(), AUDIO_CHUNK_SIZE);
+  }
+  CHECK(webSocket.sent[6].data == "clip_end|5");
+}
+
+int main() {
+  hostClockSet(1000);
+  initAudio();
+  audioVadEnabled = false;
+  setAudioCodec(AUDIO_CODEC_PCM8);
+  startStreaming();
+
+  // Leituras de 1 byte, ímpares e maiores que o resto do chunk
+  const size_t reads[] = { SIZE_MAX, 1, 3, 333, 1023, 2 * AUDIO_CHUNK_SIZE - 1 };
+  for (size_t r : reads) capture(AUDIO_DMA_BUF_COUNT - 1, r);
+
+  uint32_t sample = 0, expectSeq = 0;
+  for (const HostWsFrame &f : webSocket.sent) {
+    uint32_t seq;
+    std::string pcm = framePayload(f.data, seq);
+    CHECK_EQ(seq, expectSeq++);
+    CHECK_EQ(pcm.size(), AUDIO_CHUNK_SIZE);
+    int bad = 0;
+    for (size_t i = 0; i < pcm.size(); i++, sample++) {
+      int16_t s = (int16_t)(((int)adcAt(sample) - 2048) << 4);
+      if ((uint8_t)pcm[i] != pcm8Encode(s)) bad++;
+    }
+    CHECK_EQ(bad, 0);
+  }
+  CHECK_EQ(audioDroppedBufs, 0);
+
+  // Mais buffers completos do que o anel DMA guarda: o excesso conta como perdido
+  hostI2sMaxRead = SIZE_MAX;
+  hostI2sQueue.items.clear();
+  hostI2sFifo.clear();
+  hostI2sDma(AUDIO_DMA_BUF_COUNT + 3, adcAt);
+  updateAudio();
+  CHECK_EQ(audioDroppedBufs, 3);
+
+  // Taxa medida: um segundo de buffers entregues em dia
+  stopStreaming();
+  startStreaming();
+  hostI2sQueue.items.clear();
+  hostI2sFifo.clear();
+  int perSec = SAMPLE_RATE / AUDIO_CHUNK_SIZE;
+  for (int i = 0; i < perSec; i++) {
+    hostClockAdvance(1000 / perSec);
+    capture(1, SIZE_MAX);
+  }
+  hostClockAdvance(1000 - perSec * (1000 / perSec));
+  updateAudio();
+  printf("captura: %u Hz medidos (%d chunks em 1 s), %u buffers perdidos\n",
+         (unsigned)audioMeasuredRate, perSec, (unsigned)audioDroppedBufs);
+  CHECK_EQ(audioMeasuredRate, perSec * AUDIO_CHUNK_SIZE);
+  CHECK_EQ(audioDroppedBufs, 0);
+
+  checkClipUpload();
+  return testDone("audio_capture");
+}
@@ -0,0 +1,175 @@
+// Codecs de áudio: ida e volta pelos decodificadores, custo por chunk e banda
+#include "test_util.h"
+#include "config.h"
+#include "audio.h"
+
+WebSocketsClient webSocket;
+
+// IMA-ADPCM pela especificação (IMA Digital Audio Focus, 1992), com tabelas
+// próprias: confere também as do módulo
+static const int refStep[89] = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+  11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+  32767
+};
+static const int refIndex[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static size_t refAdpcmDecode(const uint8_t *in, size_t len, int16_t *out) {
+  int valpred = (int16_t)(in[0] | in[1] << 8);
+  int index = in[2];
+  size_t n = 0;
+  // Nibble baixo primeiro
+  for (size_t k = 0; ADPCM_BLOCK_HEADER + k / 2 < len; k++) {
+    uint8_t b = in[ADPCM_BLOCK_HEADER + k / 2];
+    int delta = k & 1 ? b >> 4 : b & 15;
+    int step = refStep[index];
+    int vpdiff = step >> 3;
+    if (delta & 4) vpdiff += step;
+    if (delta & 2) vpdiff += step >> 1;
+    if (delta & 1) vpdiff += step >> 2;
+    valpred += (delta & 8) ? -vpdiff : vpdiff;
+    valpred = valpred > 32767 ? 32767 : valpred < -32768 ? -32768 : valpred;
+    index += refIndex[delta & 7];
+    index = index < 0 ? 0 : index > 88 ? 88 : index;
+    out[n++] = (int16_t)valpred;
+  }
+  return n;
+}
+
+// Relação sinal/ruído da reconstrução, em dB
+static double snrDb(const int16_t *a, const int16_t *b, size_t n) {
+  double sig = 0, err = 0;
+  for (size_t i = 0; i < n; i++) {
+    sig += (double)a[i] * a[i];
+    err += ((double)a[i] - b[i]) * ((double)a[i] - b[i]);
+  }
+  return err ? 10.0 * log10(sig / err) : 99.0;
+}
+
+// Voz sintética: duas formantes moduladas + ruído, como sai do MAX9814
+static void speech(int16_t *pcm, size_t n, uint32_t t0) {
+  for (size_t i = 0; i < n; i++) {
+    double t = (double)(t0 + i) / SAMPLE_RATE;
+    double env = 0.55 + 0.45 * sin(2 * PI * 3.0 * t);
+    double v = env * (9000 * sin(2 * PI * 220 * t) + 4000 * sin(2 * PI * 1300 * t + 0.5));
+    pcm[i] = (int16_t)(v + (int)(testRand() % 601) - 300);
+  }
+}
+
+static void checkPcm8() {
+  for (int x = -32768; x <= 32767; x++) {
+    int16_t y = pcm8Decode(pcm8Encode((int16_t)x));
+    CHECK(y <= x && x - y < 256);
+  }
+}
+
+static void checkUlaw() {
+  // Valores da G.711
+  CHECK_EQ(ulawDecode(0xFF), 0);
+  CHECK_EQ(ulawDecode(0x7F), 0);
+  CHECK_EQ(ulawDecode(0x80), 32124);
+  CHECK_EQ(ulawDecode(0x00), -32124);
+  CHECK_EQ(ulawEncode(0), 0xFF);
+  CHECK_EQ(ulawEncode(32767), 0x80);
+  CHECK_EQ(ulawEncode(-32768), 0x00);
+
+  // Cada código volta a si mesmo (menos o zero negativo)
+  for (int c = 0; c < 256; c++) {
+    if (c == 0x7F) continue;
+    CHECK_EQ(ulawEncode(ulawDecode((uint8_t)c)), c);
+  }
+
+  // Quantização monotônica com erro de meio degrau do segmento
+  int prev = -32768;
+  int fails = 0;
+  for (int x = -32768; x <= 32767; x++) {
+    uint8_t u = ulawEncode((int16_t)x);
+    int y = ulawDecode(u);
+    int exponent = (~u >> 4) & 7;
+    int halfStep = 4 << exponent;
+    int mag = x < 0 ? -x : x;
+    bool ok = y >= prev && (mag > ULAW_CLIP ? abs(y - x) <= 32768 - 32124 : abs(y - x) <= halfStep);
+    if (!ok) fails++;
+    prev = y;
+  }
+  CHECK_EQ(fails, 0);
+}
+
+static void checkAdpcm() {
+  static int16_t pcm[AUDIO_CHUNK_SIZE * 8], dec[AUDIO_CHUNK_SIZE + 2], ref[AUDIO_CHUNK_SIZE + 2];
+  static uint8_t enc[AUDIO_CHUNK_SIZE];
+  for (int i = 0; i < 89; i++) CHECK_EQ(ADPCM_STEP_TABLE[i], refStep[i]);
+
+  // Chunks seguidos com o estado contínuo; cada um decodifica sozinho
+  speech(pcm, AUDIO_CHUNK_SIZE * 8, 0);
+  AdpcmState st = { 0, 0 };
+  double worst = 99;
+  for (int c = 0; c < 8; c++) {
+    const int16_t *in = pcm + c * AUDIO_CHUNK_SIZE;
+    size_t len = audioEncodeChunk(AUDIO_CODEC_ADPCM, st, in, AUDIO_CHUNK_SIZE, enc);
+    CHECK_EQ(len, audioCodecEncodedSize(AUDIO_CODEC_ADPCM, AUDIO_CHUNK_SIZE));
+    size_t n = audioDecodeChunk(AUDIO_CODEC_ADPCM, enc, len, dec, AUDIO_CHUNK_SIZE);
+    CHECK_EQ(n, AUDIO_CHUNK_SIZE);
+    CHECK_EQ(refAdpcmDecode(enc, len, ref), AUDIO_CHUNK_SIZE);
+    CHECK(memcmp(dec, ref, sizeof(int16_t) * AUDIO_CHUNK_SIZE) == 0);
+    // Fora o primeiro chunk (preditor partindo do zero), a reconstrução é boa
+    if (c) worst = std::min(worst, snrDb(in, dec, AUDIO_CHUNK_SIZE));
+  }
+  printf("adpcm: pior SNR por chunk %.1f dB\n", worst);
+  CHECK(worst > 20.0);
+
+  // Número ímpar de amostras: o último nibble alto fica zerado
+  st = { 0, 0 };
+  size_t len = audioEncodeChunk(AUDIO_CODEC_ADPCM, st, pcm, 7, enc);
+  CHECK_EQ(len, audioCodecEncodedSize(AUDIO_CODEC_ADPCM, 7));
+  CHECK_EQ(enc[len - 1] >> 4, 0);
+  CHECK_EQ(audioDecodeChunk(AUDIO_CODEC_ADPCM, enc, len, dec, 7), 7);
+
+  // Sinal no limite não estoura o preditor
+  for (int i = 0; i < AUDIO_CHUNK_SIZE; i++) pcm[i] = (i / 16) % 2 ? 32767 : -32768;
+  st = { 0, 0 };
+  len = audioEncodeChunk(AUDIO_CODEC_ADPCM, st, pcm, AUDIO_CHUNK_SIZE, enc);
+  audioDecodeChunk(AUDIO_CODEC_ADPCM, enc, len, dec, AUDIO_CHUNK_SIZE);
+  CHECK_EQ(dec[AUDIO_CHUNK_SIZE - 1], 32767);
+}
+
+// Custo de codificar um chunk e bytes/s no fio, com o frame realmente enviado
+static void bench() {
+  static int16_t pcm[AUDIO_CHUNK_SIZE];
+  speech(pcm, AUDIO_CHUNK_SIZE, 0);
+  const AudioCodec codecs[] = { AUDIO_CODEC_PCM8, AUDIO_CODEC_ULAW, AUDIO_CODEC_ADPCM };
+  const double chunksPerSec = (double)SAMPLE_RATE / AUDIO_CHUNK_SIZE;
+  for (AudioCodec codec : codecs) {
+    AdpcmState st = { 0, 0 };
+    double us = benchUs(5000, [&] {
+      streamPos = audioEncodeChunk(codec, st, pcm, AUDIO_CHUNK_SIZE, streamChunkBuf);
+    });
+    double snr;
+    {
+      static int16_t dec[AUDIO_CHUNK_SIZE];
+      audioDecodeChunk(codec, streamChunkBuf, streamPos, dec, AUDIO_CHUNK_SIZE);
+      snr = snrDb(pcm, dec, AUDIO_CHUNK_SIZE);
+    }
+    audioCodec = codec;
+    streamSamples = AUDIO_CHUNK_SIZE;
+    webSocket.sent.clear();
+    enviarChunkStreaming();
+    size_t wire = webSocket.sent.back().data.size();
+    printf("%-5s %3zu bytes/chunk, %4zu no fio -> %6.0f bytes/s; %.2f us/chunk; SNR %.1f dB\n",
+           audioCodecName(codec), audioCodecEncodedSize(codec, AUDIO_CHUNK_SIZE), wire,
+           wire * chunksPerSec, us, snr);
+    CHECK(us * chunksPerSec < 1e6 * 0.05);  // menos de 5% de um núcleo no PC
+  }
+}
+
+int main() {
+  checkPcm8();
+  checkUlaw();
+  checkAdpcm();
+  bench();
+  return testDone("audio_codec");
+}
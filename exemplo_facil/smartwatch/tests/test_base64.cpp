@@ -0,0 +1,118 @@
+// base64 sem heap contra a referência e o encodeBase64 anterior; frame de áudio enviado
+#include "test_util.h"
+#include "config.h"
+#include "audio.h"
+
+WebSocketsClient webSocket;
+
+// encodeBase64() anterior: um String de entrada e um caractere por vez na saída
+static String legacyEncodeBase64(const String &input) {
+  const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  String result;
+  int i = 0;
+  int j = 0;
+  unsigned char char_array_3[3];
+  unsigned char char_array_4[4];
+  int in_len = input.length();
+  const char *bytes_to_encode = input.c_str();
+
+  while (in_len--) {
+    char_array_3[i++] = *(bytes_to_encode++);
+    if (i == 3) {
+      char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
+      char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
+      char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
+      char_array_4[3] = char_array_3[2] & 0x3f;
+      for (i = 0; i < 4; i++) result += base64_chars[char_array_4[i]];
+      i = 0;
+    }
+  }
+  if (i) {
+    for (j = i; j < 3; j++) char_array_3[j] = '\0';
+    char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
+    char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
+    char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
+    char_array_4[3] = char_array_3[2] & 0x3f;
+    for (j = 0; j < i + 1; j++) result += base64_chars[char_array_4[j]];
+    while ((i++ < 3)) result += '=';
+  }
+  return result;
+}
+
+// Decodificador de referência (RFC 4648), bit a bit; -1 se inválido
+static int decodeBase64(const char *in, size_t n, uint8_t *out) {
+  if (n % 4) return -1;
+  uint32_t acc = 0;
+  int bits = 0, len = 0;
+  for (size_t i = 0; i < n; i++) {
+    const char *p = strchr(BASE64_TABLE, in[i]);
+    if (in[i] == '=') {
+      if (i + 2 < n) return -1;
+      continue;
+    }
+    if (!p || !in[i]) return -1;
+    acc = (acc << 6) | (uint32_t)(p - BASE64_TABLE);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      out[len++] = (uint8_t)(acc >> bits);
+    }
+  }
+  return len;
+}
+
+static std::string encode(const uint8_t *in, size_t len) {
+  std::string s(((len + 2) / 3) * 4 + 1, '#');
+  size_t n = base64Encode(in, len, &s[0]);
+  CHECK_EQ(n, ((len + 2) / 3) * 4);
+  CHECK_EQ(s[n], '#');  // não escreve além do que devolve
+  s.resize(n);
+  return s;
+}
+
+int main() {
+  // Vetores da RFC 4648
+  static const char *const rfc[][2] = {
+    { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+    { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" },
+  };
+  for (auto &v : rfc) CHECK(encode((const uint8_t *)v[0], strlen(v[0])) == v[1]);
+
+  // Todos os tamanhos até um chunk e pouco (passa pelos laços de 12 e de 3)
+  static uint8_t in[AUDIO_CHUNK_SIZE + 64], back[AUDIO_CHUNK_SIZE + 64];
+  for (size_t len = 0; len <= sizeof(in); len++) {
+    for (size_t i = 0; i < len; i++) in[i] = (uint8_t)testRand();
+    std::string s = encode(in, len);
+    CHECK(s == legacyEncodeBase64(String(std::string((const char *)in, len))));
+    CHECK_EQ(decodeBase64(s.data(), s.size(), back), len);
+    CHECK(memcmp(in, back, len) == 0);
+  }
+
+  // O chunk sai de verdade pelo WebSocket: "audio|<seq>|<codec>|<base64>"
+  for (int i = 0; i < AUDIO_CHUNK_SIZE; i++) streamChunkBuf[i] = (uint8_t)testRand();
+  streamPos = AUDIO_CHUNK_SIZE;
+  streamChunkIdx = 41;
+  audioCodec = AUDIO_CODEC_PCM8;
+  enviarChunkStreaming();
+  CHECK_EQ(webSocket.sent.size(), 1);
+  CHECK_EQ(streamPos, 0);
+  const std::string &frame = webSocket.sent.back().data;
+  std::string expected = "audio|41|-1|" + encode(streamChunkBuf, AUDIO_CHUNK_SIZE);
+  CHECK(!webSocket.sent.back().binary);
+  CHECK(frame == expected);
+  CHECK(frame.size() <= sizeof(audioPacket) - 1);
+
+  // Vazão por chunk de áudio
+  for (int i = 0; i < AUDIO_CHUNK_SIZE; i++) in[i] = (uint8_t)testRand();
+  static char out[AUDIO_BASE64_MAX + 1];
+  double fast = benchUs(20000, [&] { benchSink = base64Encode(in, AUDIO_CHUNK_SIZE, out); });
+  double slow = benchUs(20000, [&] {
+    String raw = "";
+    for (int i = 0; i < AUDIO_CHUNK_SIZE; i++) raw += (char)in[i];
+    benchSink = legacyEncodeBase64(raw).length();
+  });
+  printf("base64 de %d bytes: %.3f us (%.1f MB/s); anterior com String: %.3f us (%.1f MB/s)\n",
+         AUDIO_CHUNK_SIZE, fast, AUDIO_CHUNK_SIZE / fast, slow, AUDIO_CHUNK_SIZE / slow);
+
+  return testDone("base64");
+}
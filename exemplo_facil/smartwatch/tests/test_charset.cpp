@@ -0,0 +1,200 @@
+// textToDisplay: letras acentuadas do português, todos os códigos contra uma
+// referência, UTF-8 inválido, truncamento e vazão contra o asciiOnly anterior
+#include "test_util.h"
+#include <string>
+#include "text_charset.h"
+
+// asciiOnly() de notifyUI.h antes da tabela: ~25 String::replace por texto
+static String asciiOnly(String s){
+  s.replace("á","a"); s.replace("é","e"); s.replace("í","i");
+  s.replace("ó","o"); s.replace("ú","u"); s.replace("ç","c");
+  s.replace("Á","A"); s.replace("É","E"); s.replace("Í","I");
+  s.replace("Ó","O"); s.replace("Ú","U"); s.replace("Ç","C");
+  s.replace("ã","a"); s.replace("õ","o"); s.replace("Ã","A"); s.replace("Õ","O");
+  s.replace("â","a"); s.replace("ê","e"); s.replace("ô","o"); s.replace("Â","A"); s.replace("Ê","E"); s.replace("Ô","O");
+  s.replace("×","x"); s.replace("÷","/"); s.replace("−","-");
+  String out; out.reserve(s.length());
+  for (uint16_t i=0;i<s.length();++i){ char c=s[i]; if ((uint8_t)c>=32 && (uint8_t)c<=126) out+=c; }
+  return out.length()? out : String("?");
+}
+
+static std::string convert(const std::string &in, DisplayCharset cs = CHARSET_ASCII, size_t outSize = 512) {
+  std::string buf(outSize + 8, '\x5A');
+  size_t n = textToDisplay(in.c_str(), &buf[0], outSize, cs);
+  // Nunca escreve além de outSize; o retorno é o tamanho da saída
+  for (size_t i = outSize; i < buf.size(); i++) CHECK(buf[i] == '\x5A');
+  CHECK_EQ(n, strlen(buf.c_str()));
+  return buf.substr(0, n);
+}
+
+static std::string utf8(uint32_t cp) {
+  std::string s;
+  if (cp < 0x80) {
+    s += (char)cp;
+  } else if (cp < 0x800) {
+    s += (char)(0xC0 | (cp >> 6));
+    s += (char)(0x80 | (cp & 0x3F));
+  } else if (cp < 0x10000) {
+    s += (char)(0xE0 | (cp >> 12));
+    s += (char)(0x80 | ((cp >> 6) & 0x3F));
+    s += (char)(0x80 | (cp & 0x3F));
+  } else {
+    s += (char)(0xF0 | (cp >> 18));
+    s += (char)(0x80 | ((cp >> 12) & 0x3F));
+    s += (char)(0x80 | ((cp >> 6) & 0x3F));
+    s += (char)(0x80 | (cp & 0x3F));
+  }
+  return s;
+}
+
+struct Accent {
+  const char *utf8;
+  char ascii;
+  uint8_t cp437;        // 0 = a fonte 1 não tem o glifo
+};
+
+// As letras acentuadas do português (e o ü de textos antigos)
+static const Accent PT[] = {
+  { "á", 'a', 0xA0 }, { "à", 'a', 0x85 }, { "â", 'a', 0x83 }, { "ã", 'a', 0 },
+  { "é", 'e', 0x82 }, { "ê", 'e', 0x88 }, { "í", 'i', 0xA1 }, { "ó", 'o', 0xA2 },
+  { "ô", 'o', 0x93 }, { "õ", 'o', 0 },    { "ú", 'u', 0xA3 }, { "ü", 'u', 0x81 },
+  { "ç", 'c', 0x87 },
+  { "Á", 'A', 0 },    { "À", 'A', 0 },    { "Â", 'A', 0 },    { "Ã", 'A', 0 },
+  { "É", 'E', 0x90 }, { "Ê", 'E', 0 },    { "Í", 'I', 0 },    { "Ó", 'O', 0 },
+  { "Ô", 'O', 0 },    { "Õ", 'O', 0 },    { "Ú", 'U', 0 },    { "Ü", 'U', 0x9A },
+  { "Ç", 'C', 0x80 },
+};
+
+static void checkPortuguese() {
+  for (const Accent &a : PT) {
+    CHECK(convert(a.utf8) == std::string(1, a.ascii));
+    std::string cp = convert(a.utf8, CHARSET_CP437);
+    if (a.cp437) CHECK_EQ((uint8_t)cp[0], a.cp437);
+    else CHECK(cp == std::string(1, a.ascii));   // sem glifo: letra base
+  }
+  CHECK(convert("Ação às três: pão, maçã e café") == "Acao as tres: pao, maca e cafe");
+  CHECK(convert("½ € “aspas” — fim…") == "1/2 EUR \"aspas\" - fim...");
+  CHECK(convert("linha\nnova\tcom\rtab") == "linha nova com tab");
+  CHECK(convert("emoji 😀!") == "emoji !");
+  CHECK(convert("") == "?");
+  CHECK(convert("😀") == "?");
+  char one[1] = { 'x' };
+  CHECK_EQ(textToDisplay("abc", one, 1), 0);
+  CHECK_EQ(one[0], '\0');
+  CHECK_EQ(textToDisplay("abc", one, 0), 0);
+}
+
+// Tabelas: Latin-1 completo, lista larga em ordem crescente (busca binária)
+static void checkTables() {
+  for (int i = 0; i < 96; i++) {
+    CHECK(strlen(CHARMAP_LATIN1[i].ascii) < sizeof(CHARMAP_LATIN1[i].ascii));
+    CHECK(CHARMAP_LATIN1[i].cp437 == 0 || CHARMAP_LATIN1[i].cp437 >= 0x80);
+  }
+  for (size_t i = 1; i < CHARMAP_WIDE_COUNT; i++) CHECK(CHARMAP_WIDE[i - 1].cp < CHARMAP_WIDE[i].cp);
+}
+
+// Referência: busca linear nas tabelas, regras do comentário de textToDisplay
+// ("" = código descartado)
+static std::string reference(uint32_t cp, DisplayCharset cs) {
+  if (cp >= 32 && cp < 127) return std::string(1, (char)cp);
+  if (cp == '\n' || cp == '\t' || cp == '\r') return " ";
+  if (cp < 0x80) return "";
+  const CharMap *m = nullptr;
+  if (cp >= 0xA0 && cp <= 0xFF) m = &CHARMAP_LATIN1[cp - 0xA0];
+  for (size_t i = 0; i < CHARMAP_WIDE_COUNT; i++)
+    if (CHARMAP_WIDE[i].cp == cp) m = &CHARMAP_WIDE[i].map;
+  if (!m) return "";
+  if (cs == CHARSET_CP437 && m->cp437) return std::string(1, (char)m->cp437);
+  return m->ascii;
+}
+
+// Todo código válido (sem surrogates), sozinho e entre letras ASCII
+static void checkAllCodePoints() {
+  int bad = 0;
+  for (uint32_t cp = 1; cp <= 0x10FFFF; cp++) {
+    if (cp >= 0xD800 && cp <= 0xDFFF) continue;
+    for (int cs = 0; cs < 2; cs++) {
+      DisplayCharset c = (DisplayCharset)cs;
+      std::string piece = reference(cp, c);
+      if (convert(utf8(cp), c) != (piece.empty() ? "?" : piece)) bad++;
+      if (cp > 0x2300 && cp % 97) continue;      // acima das tabelas, por amostragem
+      if (convert("a" + utf8(cp) + "b", c) != "a" + piece + "b") bad++;
+    }
+  }
+  CHECK_EQ(bad, 0);
+}
+
+// Sequência inválida: cada byte que não fecha um código vira '?'
+static void checkInvalid() {
+  CHECK(convert("\x80") == "?");                        // continuação solta
+  CHECK(convert("a\xC3") == "a?");                      // truncada no fim
+  CHECK(convert("\xC3" "A") == "?A");                   // continuação faltando
+  CHECK(convert("\xC0\x80") == "??");                   // longa demais (NUL)
+  CHECK(convert("\xE0\x80\x80") == "???");              // longa demais
+  CHECK(convert("\xF0\x80\x80\x80") == "????");         // longa demais
+  CHECK(convert("\xED\xA0\x80") == "???");              // surrogate
+  CHECK(convert("\xF4\x90\x80\x80") == "????");         // acima de U+10FFFF
+  CHECK(convert("\xF8\x88\x80\x80\x80") == "?????");    // 5 bytes não existem
+  CHECK(convert("\xFF\xFE") == "??");
+  CHECK(convert("ol\xC3\xA1\xC3") == "ola?");
+  // Bytes aleatórios: nunca passa do buffer nem devolve byte de controle
+  for (int k = 0; k < 20000; k++) {
+    std::string in;
+    int len = 1 + testRand() % 24;
+    for (int i = 0; i < len; i++) {
+      uint8_t b = (uint8_t)testRand();
+      in += (char)(b ? b : 'z');
+    }
+    std::string out = convert(in, (testRand() & 1) ? CHARSET_CP437 : CHARSET_ASCII, 1 + testRand() % 40);
+    bool ok = true;
+    for (unsigned char c : out) if (c < 32 || c == 127) ok = false;
+    CHECK(ok);
+  }
+}
+
+// Buffer cheio: corta no limite, inclusive no meio de um substituto
+static void checkTruncation() {
+  CHECK(convert("abcdef", CHARSET_ASCII, 4) == "abc");
+  CHECK(convert("a½", CHARSET_ASCII, 3) == "a1");
+  CHECK(convert("a½", CHARSET_ASCII, 5) == "a1/2");
+  CHECK(convert("ação", CHARSET_ASCII, 3) == "ac");
+  CHECK(convert("ação", CHARSET_CP437, 3) == "a\x87");
+}
+
+static void bench() {
+  // Mensagem de ~2 KB em português
+  std::string msg;
+  const char *words[] = { "Você", "tem", "uma", "reunião", "às", "três", "horas;", "não",
+                          "esqueça", "a", "apresentação", "e", "o", "relatório", "da",
+                          "seção", "de", "produção.", "Obrigado!", "Ótimo", "trabalho", "×", "÷" };
+  while (msg.size() < 2048) {
+    msg += words[testRand() % (sizeof(words) / sizeof(words[0]))];
+    msg += ' ';
+  }
+  // Igual ao asciiOnly no que ele conhecia; o à ele descartava
+  std::string noGrave = msg;
+  for (size_t p; (p = noGrave.find("à")) != std::string::npos;) noGrave.replace(p, 2, "a");
+  CHECK(convert(noGrave, CHARSET_ASCII, 4096) == asciiOnly(String(noGrave.c_str())).c_str());
+  CHECK(convert(msg, CHARSET_ASCII, 4096) == convert(noGrave, CHARSET_ASCII, 4096));
+  CHECK(convert("à", CHARSET_ASCII) == "a");
+  CHECK(asciiOnly(String("à")) == "?");
+
+  static char out[4096];
+  double tableUs = benchUs(2000, [&] { benchSink += textToDisplay(msg.c_str(), out, sizeof(out)); });
+  double legacyUs = benchUs(200, [&] { benchSink += asciiOnly(String(msg.c_str())).length(); });
+  std::string ascii(msg.size(), 'x');
+  double asciiUs = benchUs(2000, [&] { benchSink += textToDisplay(ascii.c_str(), out, sizeof(out)); });
+  printf("texto de %u bytes: tabela %.2f us (%.0f MB/s; só ASCII %.0f MB/s), asciiOnly %.2f us (%.0f MB/s)\n",
+         (unsigned)msg.size(), tableUs, msg.size() / tableUs, ascii.size() / asciiUs,
+         legacyUs, msg.size() / legacyUs);
+}
+
+int main() {
+  checkPortuguese();
+  checkTables();
+  checkAllCodePoints();
+  checkInvalid();
+  checkTruncation();
+  bench();
+  return testDone("charset");
+}
@@ -0,0 +1,184 @@
+// Codificador QR: matrizes contra a referência gravada (qr_golden.h), versão
+// mínima e nível máximo, escolha da máscara por uma penalidade de referência,
+// desenho em trechos e custo
+#include "test_util.h"
+#include <WiFi.h>
+#include "qr_code.h"
+#include "qr_golden.h"
+#include <string>
+
+static bool goldenDark(const QrGolden &g, int x, int y) {
+  int size = g.version * 4 + 17, stride = (size + 7) / 8;
+  const char *hex = g.rows + 2 * (y * stride + (x >> 3));
+  char byte[3] = { hex[0], hex[1], '\0' };
+  return (strtoul(byte, nullptr, 16) >> (7 - (x & 7))) & 1;
+}
+
+static bool encode(const std::string &s) {
+  return qrEncode((const uint8_t *)s.data(), s.size());
+}
+
+// Troca a máscara da matriz codificada (como o próprio qrEncode testa cada uma)
+static void remask(int mask) {
+  qrApplyMask(qrMatrix.mask);
+  qrApplyMask(mask);
+  qrDrawFormatBits(qrMatrix.ecc, mask);
+  qrMatrix.mask = mask;
+}
+
+static int diffGolden(const QrGolden &g) {
+  int diff = 0;
+  for (int y = 0; y < qrMatrix.size; y++)
+    for (int x = 0; x < qrMatrix.size; x++)
+      if (qrGet(qrMatrix.dark, x, y) != goldenDark(g, x, y)) diff++;
+  return diff;
+}
+
+// Penalidade da norma (ISO/IEC 18004, 7.8.3), escrita de novo e sem atalhos
+static long refPenalty() {
+  int n = qrMatrix.size;
+  auto dark = [&](int x, int y) {
+    return x >= 0 && y >= 0 && x < n && y < n && qrGet(qrMatrix.dark, x, y);
+  };
+  long p = 0;
+  for (int dir = 0; dir < 2; dir++) {
+    for (int a = 0; a < n; a++) {
+      auto at = [&](int b) { return dir ? dark(a, b) : dark(b, a); };
+      // N1: 5 ou mais iguais seguidos
+      for (int b = 0; b < n;) {
+        int e = b;
+        while (e < n && at(e) == at(b)) e++;
+        if (e - b >= 5) p += 3 + (e - b - 5);
+        b = e;
+      }
+      // N3: 1:1:3:1:1 com 4 claros de um dos lados (fora da matriz é claro)
+      static const bool core[7] = { 1, 0, 1, 1, 1, 0, 1 };
+      for (int b = 0; b + 7 <= n; b++) {
+        bool match = true;
+        for (int k = 0; k < 7; k++) if (at(b + k) != core[k]) match = false;
+        if (!match) continue;
+        bool before = true, after = true;
+        for (int k = 1; k <= 4; k++) {
+          if (at(b - k)) before = false;
+          if (at(b + 6 + k)) after = false;
+        }
+        if (before || after) p += 40;
+      }
+    }
+  }
+  // N2: blocos 2x2 da mesma cor
+  for (int y = 0; y + 1 < n; y++)
+    for (int x = 0; x + 1 < n; x++)
+      if (dark(x, y) == dark(x + 1, y) && dark(x, y) == dark(x, y + 1) && dark(x, y) == dark(x + 1, y + 1)) p += 3;
+  // N4: 10 pontos a cada 5% de desvio de 50% escuros
+  int count = 0;
+  for (int y = 0; y < n; y++)
+    for (int x = 0; x < n; x++) count += dark(x, y);
+  double pct = 100.0 * count / (n * n);
+  p += 10 * (long)(fabs(pct - 50.0) / 5.0);
+  return p;
+}
+
+// Cada matriz da referência, módulo a módulo; a máscara escolhida é a de
+// menor penalidade de referência
+static void checkGolden() {
+  for (size_t i = 0; i < QR_GOLDEN_COUNT; i++) {
+    const QrGolden &g = QR_GOLDEN[i];
+    std::string text = g.text;
+    CHECK(encode(text));
+    CHECK_EQ(qrMatrix.version, g.version);
+    CHECK_EQ(qrMatrix.ecc, g.ecc);
+    CHECK_EQ(qrMatrix.size, g.version * 4 + 17);
+    int chosen = qrMatrix.mask;
+
+    long best = -1;
+    int bestMask = 0;
+    for (int m = 0; m < 8; m++) {
+      remask(m);
+      long p = refPenalty();
+      CHECK_EQ(p, qrPenalty());
+      if (best < 0 || p < best) { best = p; bestMask = m; }
+    }
+    CHECK_EQ(chosen, bestMask);
+
+    remask(g.mask);
+    int diff = diffGolden(g);
+    if (diff) printf("  \"%.20s\" v%d-%c máscara %d: %d módulos diferentes\n",
+                     g.text, g.version, "LMQH"[g.ecc], g.mask, diff);
+    CHECK_EQ(diff, 0);
+  }
+}
+
+// Capacidade da tela: QR_MAX_VERSION (13-L, 425 bytes) e nada além
+static void checkCapacity() {
+  CHECK_EQ(QR_MAX_VERSION, 13);
+  CHECK_EQ(qrMaxBytes(), 425);
+  CHECK(encode(std::string(425, 'x')));
+  CHECK_EQ(qrMatrix.version, 13);
+  CHECK(!encode(std::string(426, 'x')));
+  CHECK_EQ(qrMatrix.version, 0);
+  // Nível: o maior que cabe na menor versão
+  CHECK(encode(""));
+  CHECK_EQ(qrMatrix.version, 1);
+  CHECK_EQ(qrMatrix.ecc, QR_ECC_H);
+}
+
+// Módulos escuros com qrDraw (trechos) == matriz ampliada, zona de silêncio clara
+static void checkDraw() {
+  TFT_eSPI tft;
+  CHECK(encode("https://neurelix.com.br"));
+  tft.fillScreen(TFT_RED);
+  qrDraw(tft, 120, 112);
+  int size = qrMatrix.size;
+  int px = QR_AREA_PX / (size + 2 * QR_QUIET_MODULES);
+  int side = (size + 2 * QR_QUIET_MODULES) * px;
+  int x0 = 120 - side / 2, y0 = 112 - side / 2;
+  int bad = 0;
+  for (int y = 0; y < side; y++) {
+    for (int x = 0; x < side; x++) {
+      int mx = x / px - QR_QUIET_MODULES, my = y / px - QR_QUIET_MODULES;
+      bool dark = mx >= 0 && my >= 0 && mx < size && my < size && qrGet(qrMatrix.dark, mx, my);
+      if (tft.readPixel(x0 + x, y0 + y) != (dark ? TFT_BLACK : TFT_WHITE)) bad++;
+    }
+  }
+  CHECK_EQ(bad, 0);
+  CHECK_EQ(tft.readPixel(x0 - 1, y0 - 1), TFT_RED);
+  CHECK_EQ(tft.readPixel(x0 + side, y0 + side), TFT_RED);
+}
+
+// Trechos escuros por linha (um fillRect cada) e módulos escuros (o desenho
+// anterior, da QRcode_eSPI, fazia um fillRect por módulo)
+static void countRuns(int &runs, int &modules) {
+  runs = modules = 0;
+  for (int y = 0; y < qrMatrix.size; y++) {
+    for (int x = 0; x < qrMatrix.size; x++) {
+      if (!qrGet(qrMatrix.dark, x, y)) continue;
+      modules++;
+      if (x == 0 || !qrGet(qrMatrix.dark, x - 1, y)) runs++;
+    }
+  }
+}
+
+static void bench() {
+  TFT_eSPI tft;
+  const int lengths[] = { 23, 86, 200, 425 };
+  for (int len : lengths) {
+    std::string s;
+    for (int i = 0; i < len; i++) s += (char)('a' + testRand() % 26);
+    double encUs = benchUs(200, [&] { encode(s); });
+    int runs, modules;
+    countRuns(runs, modules);
+    double drawUs = benchUs(200, [&] { qrDraw(tft, 120, 112); });
+    printf("%3d bytes -> v%d-%c: codifica %.0f us; desenho %.1f us, %d fillRect (antes %d, um por módulo)\n",
+           len, qrMatrix.version, "LMQH"[qrMatrix.ecc], encUs, drawUs, runs + 1, modules);
+    CHECK(runs < modules);
+  }
+}
+
+int main() {
+  checkGolden();
+  checkCapacity();
+  checkDraw();
+  bench();
+  return testDone("qr");
+}
@@ -0,0 +1,187 @@
+// Layout de texto na tela redonda: cordas contra a raiz em ponto flutuante,
+// quebras dentro da corda de cada linha sem perder texto, rolagem limitada e
+// corte com "..."
+#include "test_util.h"
+#include <string>
+#include "text_layout.h"
+
+static TFT_eSPI tft;
+static TextCircle circle;
+
+static const char *WORDS[] = {
+  "Reuniao", "as", "tres", "horas", "na", "sala", "de", "producao;", "nao", "esqueca",
+  "o", "relatorio", "e", "a", "apresentacao.", "Obrigado!", "mmmmmmmmmmmmmmmmmmmmmmmmmmmm",
+  "iiii", "WWW", "ok",
+};
+
+static std::string randomText(int words) {
+  std::string s;
+  for (int i = 0; i < words; i++) {
+    if (i) s += (testRand() % 9 == 0) ? "\n" : (testRand() % 7 == 0) ? "  " : " ";
+    s += WORDS[testRand() % (sizeof(WORDS) / sizeof(WORDS[0]))];
+  }
+  return s;
+}
+
+static std::string lineText(const TextLayout &l, const TextLine &ln) {
+  return std::string(l.text + ln.start, ln.len);
+}
+
+static std::string withoutSpaces(const std::string &s) {
+  std::string out;
+  for (char c : s) if (c != ' ' && c != '\n') out += c;
+  return out;
+}
+
+// Meia-corda == raiz em ponto flutuante; a corda de uma faixa é a menor
+static void checkCircle() {
+  const int radii[] = { 60, 110, 120 };
+  for (int r : radii) {
+    textCircleInit(circle, 120, 120, r);
+    int bad = 0;
+    for (int y = 0; y < TEXT_LAYOUT_ROWS; y++) {
+      int dy = y - 120;
+      int h = dy * dy < r * r ? (int)floor(sqrt((double)r * r - dy * dy)) : 0;
+      if (circle.half[y] != h) bad++;
+    }
+    CHECK_EQ(bad, 0);
+    for (int k = 0; k < 500; k++) {
+      int y0 = testRand() % TEXT_LAYOUT_ROWS;
+      int y1 = y0 + testRand() % 40;
+      if (y1 >= TEXT_LAYOUT_ROWS) continue;
+      int narrow = 255;
+      for (int y = y0; y <= y1; y++) if (circle.half[y] < narrow) narrow = circle.half[y];
+      CHECK_EQ(textChordWidth(circle, y0, y1), 2 * narrow);
+    }
+    CHECK_EQ(textChordWidth(circle, -1, 10), 0);
+    CHECK_EQ(textChordWidth(circle, 230, TEXT_LAYOUT_ROWS), 0);
+  }
+  textCircleInit(circle, 120, 120, 120);
+}
+
+// Caixa da tela de notificações: cada linha cabe na corda da sua altura (ou
+// na largura fixa da rolagem), o texto guardado volta inteiro e as linhas
+// ficam centralizadas, em sequência, dentro da faixa
+static void checkBreaks() {
+  TextLayout l;
+  int bad = 0;
+  for (int k = 0; k < 400; k++) {
+    textLayoutInit(l, &circle, 2, 1, TEXT_ALIGN_CENTER, 0, 240, 68, 192);
+    std::string text = randomText(1 + testRand() % 30);
+    textLayoutSet(tft, l, text.c_str());
+    int16_t fixed = textLayoutFixedWidth(l);
+    int16_t y0 = l.lines[0].y;
+    if (l.scrolls ? y0 != l.top : (y0 < l.top || y0 + l.count * l.lineH > l.bottom)) bad++;
+    std::string joined;
+    for (int i = 0; i < l.count; i++) {
+      const TextLine &ln = l.lines[i];
+      std::string s = lineText(l, ln);
+      int16_t avail = l.scrolls ? fixed : textLineWidth(l, ln.y);
+      if (ln.w != tft.textWidth(s.c_str(), 2)) bad++;
+      if (ln.w > avail && ln.len > 1) bad++;
+      if (ln.x != 120 - ln.w / 2) bad++;
+      if (ln.y != y0 + i * l.lineH) bad++;
+      if (!s.empty() && (s.front() == ' ' || s.back() == ' ')) bad++;
+      joined += s;
+    }
+    std::string kept = text.substr(0, TEXT_LAYOUT_CHARS - 1);
+    if (!l.truncated && withoutSpaces(joined) != withoutSpaces(kept)) bad++;
+    if (!l.scrolls && l.count > l.visible) bad++;
+    if (l.scrolls && textLayoutMaxScroll(l) != l.count - l.visible) bad++;
+  }
+  CHECK_EQ(bad, 0);
+
+  // Palavra maior que a corda é cortada no meio, sem linha vazia
+  textLayoutInit(l, &circle, 2, 1, TEXT_ALIGN_CENTER, 0, 240, 68, 192);
+  textLayoutSet(tft, l, "mmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmmm");
+  CHECK(l.count > 1);
+  for (int i = 0; i < l.count; i++) CHECK(l.lines[i].len > 0);
+}
+
+// Rolagem: firstLine além do fim fica no último; nada sai da faixa
+static void checkScroll() {
+  TextLayout l;
+  textLayoutInit(l, &circle, 2, 1, TEXT_ALIGN_CENTER, 0, 240, 68, 192);
+  std::string text;
+  while (text.size() < 200) text += "Reuniao as tres horas na sala de producao. ";
+  textLayoutSet(tft, l, text.c_str());
+  CHECK(l.scrolls);
+  uint8_t maxScroll = textLayoutMaxScroll(l);
+  CHECK(maxScroll > 0);
+
+  TFT_eSPI a, b;
+  displayClipInit(a);
+  a.fillScreen(0x1234);
+  textLayoutDraw(a, l, 0xFFFF, 0x0000, maxScroll);
+  displayClipInit(b);
+  b.fillScreen(0x1234);
+  textLayoutDraw(b, l, 0xFFFF, 0x0000, 200);
+  CHECK(a.frame() == b.frame());
+  int outside = 0;
+  for (int y = 0; y < a.height(); y++)
+    for (int x = 0; x < a.width(); x++)
+      if ((y < l.top || y >= l.bottom) && a.readPixel(x, y) != 0x1234) outside++;
+  CHECK_EQ(outside, 0);
+  // Depois de desenhar, o recorte volta à tela inteira
+  CHECK(displayClipContains(a, 0, 0, a.width(), a.height()));
+}
+
+// Corte: maxLines na caixa do corpo do toast e TEXT_LAYOUT_LINES na rolagem
+static void checkTruncation() {
+  TextLayout l;
+  int16_t lineH = tft.fontHeight(1) + 2;
+  textLayoutInit(l, nullptr, 1, 1, TEXT_ALIGN_LEFT, 10, 100, 20, 20 + 2 * lineH, 0, 2, 2);
+  textLayoutSet(tft, l, "Reuniao as tres horas na sala de producao, nao esqueca o relatorio");
+  CHECK(l.truncated);
+  CHECK(!l.scrolls);
+  CHECK_EQ(l.count, 2);
+  const TextLine &last = l.lines[1];
+  CHECK(last.w + 3 * tft.textWidth(".", 1) <= l.maxW);
+  CHECK(last.len > 0 && l.text[last.start + last.len - 1] != ' ');
+
+  // O desenho é o das duas linhas, a última com "..."
+  TFT_eSPI a, ref;
+  a.fillScreen(0);
+  textLayoutDraw(a, l, 0xFFFF, 0x0000);
+  ref.fillScreen(0);
+  ref.setTextFont(1);
+  ref.setTextColor(0xFFFF, 0x0000);
+  ref.drawString(lineText(l, l.lines[0]).c_str(), l.lines[0].x, l.lines[0].y);
+  ref.drawString((lineText(l, last) + "...").c_str(), last.x, last.y);
+  CHECK(a.frame() == ref.frame());
+
+  // Cabe: sem "..."
+  textLayoutSet(tft, l, "Reuniao as tres");
+  CHECK(!l.truncated);
+  CHECK_EQ(l.count, 1);
+
+  // Mais linhas que TEXT_LAYOUT_LINES: rola e corta a última guardada
+  textLayoutInit(l, &circle, 2, 1, TEXT_ALIGN_CENTER, 0, 240, 20, 100);
+  std::string text;
+  while (text.size() < TEXT_LAYOUT_CHARS) text += "mmmm ";
+  textLayoutSet(tft, l, text.c_str());
+  CHECK(l.scrolls);
+  CHECK(l.truncated);
+  CHECK_EQ(l.count, TEXT_LAYOUT_LINES);
+  CHECK(l.lines[l.count - 1].w + 3 * tft.textWidth(".", 2) <= textLayoutFixedWidth(l));
+}
+
+// Mesmo texto e caixa: a quebra é reaproveitada; caixa nova refaz
+static void checkCache() {
+  TextLayout l;
+  textLayoutInit(l, &circle, 2, 1, TEXT_ALIGN_CENTER, 0, 240, 68, 192);
+  CHECK(textLayoutSet(tft, l, "Reuniao as tres horas"));
+  CHECK(!textLayoutSet(tft, l, "Reuniao as tres horas"));
+  CHECK(textLayoutSet(tft, l, "Reuniao as tres horaz"));
+  textLayoutBox(l, &circle, 2, 1, TEXT_ALIGN_CENTER, 0, 240, 70, 192);
+  CHECK(textLayoutSet(tft, l, "Reuniao as tres horaz"));
+}
+
+int main() {
+  checkCircle();
+  checkBreaks();
+  checkScroll();
+  checkTruncation();
+  checkCache();
+  return testDone("text_layout");
+}
@@ -0,0 +1,62 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+// ==========================================
+// TESTES DE HOST - verificação e cronômetro
+// ==========================================
+// CHECK() conta a falha e segue (mostra todas de uma vez); testDone() vira o
+// código de saída do programa. benchUs() mede com o relógio real do PC: os
+// números servem para comparar variantes entre si, não o tempo no ESP32.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+
+static int testFailures = 0;
+static int testChecks = 0;
+
+#define CHECK(cond) do { \
+    testChecks++; \
+    if (!(cond)) { \
+      testFailures++; \
+      printf("  FALHA %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+  } while (0)
+
+#define CHECK_EQ(a, b) do { \
+    testChecks++; \
+    long long va_ = (long long)(a), vb_ = (long long)(b); \
+    if (va_ != vb_) { \
+      testFailures++; \
+      printf("  FALHA %s:%d: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, va_, vb_); \
+    } \
+  } while (0)
+
+static inline int testDone(const char *name) {
+  printf("%s: %d verificações, %d falhas\n", name, testChecks, testFailures);
+  return testFailures ? 1 : 0;
+}
+
+// Tempo médio por repetição de fn(), em microssegundos
+template <typename Fn>
+static double benchUs(int reps, Fn fn) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / reps;
+}
+
+// Gerador determinístico (xorshift32): mesmas entradas a cada execução
+static uint32_t testRandState = 2463534242u;
+
+static inline uint32_t testRand() {
+  testRandState ^= testRandState << 13;
+  testRandState ^= testRandState >> 17;
+  testRandState ^= testRandState << 5;
+  return testRandState;
+}
+
+// Impede o compilador de descartar o resultado de um benchmark
+static volatile uint32_t benchSink;
+
+#endif // TEST_UTIL_H
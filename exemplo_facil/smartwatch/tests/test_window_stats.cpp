@@ -0,0 +1,90 @@
+// Janela deslizante O(1) contra a força bruta sobre o mesmo ring
+#include "test_util.h"
+#include "window_stats.h"
+
+struct Brute {
+  uint32_t v[WSTATS_CAPACITY];
+  uint32_t total = 0;
+
+  void push(uint32_t x) { v[total++ % WSTATS_CAPACITY] = x; }
+  int count() const { return total < WSTATS_CAPACITY ? (int)total : WSTATS_CAPACITY; }
+  uint32_t min() const {
+    uint32_t m = UINT32_MAX;
+    for (int i = 0; i < count(); i++) m = v[i] < m ? v[i] : m;
+    return count() ? m : 0;
+  }
+  uint32_t max() const {
+    uint32_t m = 0;
+    for (int i = 0; i < count(); i++) m = v[i] > m ? v[i] : m;
+    return m;
+  }
+  uint32_t mean() const {
+    uint64_t s = 0;
+    for (int i = 0; i < count(); i++) s += v[i];
+    return count() ? (uint32_t)(s / count()) : 0;
+  }
+};
+
+static void compare(const WindowStats &w, const Brute &b) {
+  CHECK_EQ(windowStatsCount(w), b.count());
+  CHECK_EQ(windowStatsFull(w), b.count() == WSTATS_CAPACITY);
+  CHECK_EQ(windowStatsMin(w), b.min());
+  CHECK_EQ(windowStatsMax(w), b.max());
+  CHECK_EQ(windowStatsMean(w), b.mean());
+  CHECK_EQ(windowStatsPP(w), b.max() - b.min());
+}
+
+// Fluxo de n amostras; gen(i) dá a i-ésima
+template <typename Gen>
+static void stream(int n, Gen gen) {
+  static WindowStats w;
+  Brute b;
+  windowStatsReset(w);
+  compare(w, b);
+  for (int i = 0; i < n; i++) {
+    uint32_t x = gen(i);
+    windowStatsPush(w, x);
+    b.push(x);
+    compare(w, b);
+  }
+}
+
+int main() {
+  // Aleatório largo, faixa estreita (muitos empates) e IR realista
+  stream(5000, [](int) { return testRand(); });
+  stream(5000, [](int) { return testRand() % 4; });
+  stream(5000, [](int i) { return 120000 + (uint32_t)(8000 * sin(i * 0.21)) + testRand() % 500; });
+  // Monótonas: a deque cresce até a capacidade inteira
+  stream(3 * WSTATS_CAPACITY, [](int i) { return (uint32_t)i; });
+  stream(3 * WSTATS_CAPACITY, [](int i) { return (uint32_t)(100000 - i); });
+  // Soma acima de 32 bits: a média não pode estourar
+  stream(3 * WSTATS_CAPACITY, [](int) { return 0xF0000000u + testRand() % 1000; });
+
+  // Reset no meio de uma janela cheia volta ao estado inicial
+  static WindowStats w;
+  Brute b;
+  windowStatsReset(w);
+  for (int i = 0; i < 250; i++) windowStatsPush(w, testRand());
+  windowStatsReset(w);
+  compare(w, b);
+  for (int i = 0; i < 30; i++) {
+    uint32_t x = testRand() % 1000;
+    windowStatsPush(w, x);
+    b.push(x);
+  }
+  compare(w, b);
+
+  // Custo por amostra: push + consulta completa contra reescanear a janela
+  windowStatsReset(w);
+  double fast = benchUs(200000, [&] {
+    windowStatsPush(w, testRand() % 200000);
+    benchSink = windowStatsMean(w) + windowStatsPP(w);
+  });
+  double slow = benchUs(200000, [&] {
+    b.push(testRand() % 200000);
+    benchSink = b.mean() + b.max() - b.min();
+  });
+  printf("janela de %d: %.3f us/amostra (reescanear: %.3f us)\n", WSTATS_CAPACITY, fast, slow);
+
+  return testDone("window_stats");
+}
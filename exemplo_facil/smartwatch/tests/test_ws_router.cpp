@@ -0,0 +1,185 @@
+// Roteador de comandos: corpus misto contra a cadeia de comparações, µs por despacho
+#include "test_util.h"
+#include "config.h"
+#include "ws_router.h"
+#include <vector>
+
+// Handlers registram o que receberam
+static int lastCmd = -1;
+static StrView lastArgs;
+
+template <int I>
+static void record(StrView args) {
+  lastCmd = I;
+  lastArgs = args;
+}
+
+// Mesma tabela de smartwatch.ino (conferida com o arquivo abaixo)
+static constexpr WsCommand TABLE[] = {
+  { "audio",         '|', WS_ARGS_OPTIONAL, record<0> },
+  { "audio_codec",   '|', WS_ARGS_REQUIRED, record<1> },
+  { "audio_stats",   '|', WS_ARGS_NONE,     record<2> },
+  { "limpar",        '|', WS_ARGS_NONE,     record<3> },
+  { "ping",          '|', WS_ARGS_NONE,     record<4> },
+  { "qrcode",        '|', WS_ARGS_REQUIRED, record<5> },
+  { "rf_clear",      '|', WS_ARGS_NONE,     record<6> },
+  { "rf_learn",      '|', WS_ARGS_NONE,     record<7> },
+  { "rf_list",       '|', WS_ARGS_NONE,     record<8> },
+  { "rf_send",       ':', WS_ARGS_REQUIRED, record<9> },
+  { "rf_status",     '|', WS_ARGS_NONE,     record<10> },
+  { "sensors",       '|', WS_ARGS_NONE,     record<11> },
+  { "stream_off",    '|', WS_ARGS_NONE,     record<12> },
+  { "stream_on",     '|', WS_ARGS_NONE,     record<13> },
+  { "telemetry_off", '|', WS_ARGS_NONE,     record<14> },
+  { "telemetry_on",  '|', WS_ARGS_OPTIONAL, record<15> },
+  { "vad_off",       '|', WS_ARGS_NONE,     record<16> },
+  { "vad_on",        '|', WS_ARGS_NONE,     record<17> },
+  { "watchface",     '|', WS_ARGS_REQUIRED, record<18> },
+};
+#define COUNT (sizeof(TABLE) / sizeof(TABLE[0]))
+static_assert(wsTableSorted(TABLE, COUNT), "tabela fora de ordem");
+
+// Confere nome, separador e argumentos com as linhas de WS_COMMANDS no sketch
+// (o make roda os testes de dentro de tests/)
+static void checkSketchTable() {
+  FILE *f = fopen("../smartwatch.ino", "r");
+  CHECK(f != nullptr);
+  if (!f) return;
+  char line[256];
+  size_t found = 0;
+  bool inTable = false;
+  while (fgets(line, sizeof(line), f)) {
+    if (strstr(line, "WS_COMMANDS[] = {")) inTable = true;
+    else if (inTable && strstr(line, "};")) break;
+    char name[32], sep, args[32];
+    if (!inTable || sscanf(line, " { \"%31[^\"]\", '%c', %31[A-Z_],", name, &sep, args) != 3) continue;
+    bool match = found < COUNT && strcmp(TABLE[found].name, name) == 0 && TABLE[found].sep == sep;
+    if (match) {
+      const char *kinds[] = { "WS_ARGS_NONE", "WS_ARGS_OPTIONAL", "WS_ARGS_REQUIRED" };
+      match = strcmp(kinds[TABLE[found].args], args) == 0;
+    }
+    if (!match) printf("  tabela do teste difere do sketch em \"%s\"\n", name);
+    CHECK(match);
+    found++;
+  }
+  fclose(f);
+  CHECK_EQ(found, COUNT);
+}
+
+// Semântica da cadeia if/else anterior, comando a comando: -1 = notificação
+static int reference(const std::string &s, std::string &args) {
+  for (size_t i = 0; i < COUNT; i++) {
+    const WsCommand &c = TABLE[i];
+    std::string name = c.name;
+    if (c.args != WS_ARGS_REQUIRED && s == name) {
+      args.clear();
+      return (int)i;
+    }
+    if (c.args != WS_ARGS_NONE && s.compare(0, name.size() + 1, name + c.sep) == 0) {
+      args = s.substr(name.size() + 1);
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+static std::vector<std::string> corpus() {
+  std::vector<std::string> v;
+  for (size_t i = 0; i < COUNT; i++) {
+    std::string n = TABLE[i].name;
+    v.push_back(n);
+    v.push_back(n + "|");
+    v.push_back(n + "|arg|com|barras");
+    v.push_back(n + ":");
+    v.push_back(n + ":7");
+    v.push_back(n + "x");
+    v.push_back(n.substr(0, n.size() - 1));
+    v.push_back(" " + n);
+    v.push_back(n + "\r\n");
+  }
+  const char *extra[] = {
+    "", "|", ":", "a", "zzz", "Oi, tudo bem?", "mensagem com | barra", "rf_send:12",
+    "qrcode|https://exemplo.com/a?b=1|2", "audio|5", "telemetry_on|50", "watchface|2",
+    "audio_codec|adpcm", "PING", "ping ", "rf_send|3", "limpar:agora",
+  };
+  for (const char *e : extra) v.push_back(e);
+  // Notificações longas e bytes quaisquer, incluindo NUL
+  for (int i = 0; i < 200; i++) {
+    std::string s;
+    int len = testRand() % 120;
+    for (int k = 0; k < len; k++) s.push_back((char)(testRand() % 7 ? 32 + testRand() % 95 : testRand() % 256));
+    v.push_back(s);
+  }
+  return v;
+}
+
+// Despacho antigo (String do payload e comparações em sequência), estendido
+// aos comandos atuais
+static int legacyDispatch(const char *payload, size_t length) {
+  String cmd = String(payload, length);
+  if (cmd == "limpar") return 3;
+  if (cmd == "stream_on") return 13;
+  if (cmd == "stream_off") return 12;
+  if (cmd == "ping") return 4;
+  if (cmd.startsWith("rf_send:")) return 9;
+  if (cmd == "rf_list") return 8;
+  if (cmd == "rf_clear") return 6;
+  if (cmd == "rf_learn") return 7;
+  if (cmd == "rf_status") return 10;
+  if (cmd.startsWith("qrcode|")) return 5;
+  if (cmd == "sensors") return 11;
+  if (cmd == "telemetry_on" || cmd.startsWith("telemetry_on|")) return 15;
+  if (cmd == "telemetry_off") return 14;
+  if (cmd == "audio" || cmd.startsWith("audio|")) return 0;
+  if (cmd.startsWith("audio_codec|")) return 1;
+  if (cmd == "audio_stats") return 2;
+  if (cmd == "vad_on") return 17;
+  if (cmd == "vad_off") return 16;
+  if (cmd.startsWith("watchface|")) return 18;
+  return -1;
+}
+
+int main() {
+  checkSketchTable();
+
+  std::vector<std::string> v = corpus();
+  for (const std::string &s : v) {
+    std::string refArgs;
+    int ref = reference(s, refArgs);
+    lastCmd = -1;
+    bool hit = wsDispatch(TABLE, COUNT, s.data(), s.size());
+    CHECK_EQ(hit, ref >= 0);
+    CHECK_EQ(lastCmd, ref);
+    CHECK_EQ(legacyDispatch(s.data(), s.size()), ref);
+    if (hit && ref >= 0) {
+      // Argumentos sem cópia: a view aponta para dentro do payload
+      CHECK(std::string(lastArgs.p, lastArgs.n) == refArgs);
+      CHECK(lastArgs.n == 0 || (lastArgs.p >= s.data() && lastArgs.p + lastArgs.n == s.data() + s.size()));
+    }
+  }
+
+  // Utilitários da view
+  StrView a = { "  42\r\n", 6 };
+  CHECK_EQ(a.trimmed().n, 2);
+  CHECK_EQ(a.trimmed().toInt(), 42);
+  CHECK(a.trimmed().equals("42"));
+  CHECK(StrView({ "  \r\n", 4 }).trimmed().empty());
+  CHECK_EQ(StrView({ "-7|x", 2 }).toInt(), -7);
+
+  // µs por despacho no corpus inteiro, tabela contra a cadeia antiga
+  size_t k = 0;
+  int reps = 200000;
+  double table = benchUs(reps, [&] {
+    const std::string &s = v[k++ % v.size()];
+    benchSink = wsDispatch(TABLE, COUNT, s.data(), s.size());
+  });
+  k = 0;
+  double chain = benchUs(reps, [&] {
+    const std::string &s = v[k++ % v.size()];
+    benchSink = legacyDispatch(s.data(), s.size());
+  });
+  printf("despacho (%zu frames no corpus): tabela %.3f us, cadeia com String %.3f us\n",
+         v.size(), table, chain);
+
+  return testDone("ws_router");
+}
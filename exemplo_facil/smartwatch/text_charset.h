@@ -0,0 +1,251 @@
+#ifndef TEXT_CHARSET_H
+#define TEXT_CHARSET_H
+
+#include <TFT_eSPI.h>
+
+// ==========================================
+// UTF-8 -> CHARSET DO DISPLAY
+// ==========================================
+// As fontes do TFT_eSPI só têm ASCII (fontes 2, 4...) ou CP437 (fonte 1,
+// GLCD). textToDisplay() decodifica o UTF-8 numa passada só, sem alocar:
+// cada código passa por uma tabela (Latin-1 direto por índice, o resto por
+// busca binária numa lista curta) e vira o byte CP437 (se o charset for
+// CP437 e o glifo existir) ou 1 a 3 caracteres ASCII ("ç" -> "c",
+// "½" -> "1/2", "€" -> "EUR"). O que não tem mapa (emoji...) é descartado;
+// sequência UTF-8 inválida vira '?'.
+// Para desenhar bytes CP437, envolva o desenho com textCharsetBegin/End
+// (desliga a decodificação UTF-8 da própria biblioteca).
+
+enum DisplayCharset : uint8_t {
+  CHARSET_ASCII,
+  CHARSET_CP437                 // fonte 1 (GLCD) tem os glifos 128..255
+};
+
+struct CharMap {
+  char ascii[4];                // substituto ASCII ("" = descartar)
+  uint8_t cp437;                // 0 = sem glifo CP437
+};
+
+// U+00A0..U+00FF
+static const CharMap CHARMAP_LATIN1[96] PROGMEM = {
+  { " ", 0x00 },      // nbsp U+00A0
+  { "!", 0xAD },      // ¡ U+00A1
+  { "c", 0x9B },      // ¢ U+00A2
+  { "L", 0x9C },      // £ U+00A3
+  { "", 0x00 },       // ¤ U+00A4
+  { "Y", 0x9D },      // ¥ U+00A5
+  { "|", 0x00 },      // ¦ U+00A6
+  { "S", 0x00 },      // § U+00A7
+  { "\"", 0x00 },     // ¨ U+00A8
+  { "(c)", 0x00 },    // © U+00A9
+  { "a", 0xA6 },      // ª U+00AA
+  { "<<", 0xAE },     // « U+00AB
+  { "-", 0xAA },      // ¬ U+00AC
+  { "", 0x00 },       // shy U+00AD
+  { "(R)", 0x00 },    // ® U+00AE
+  { "-", 0x00 },      // ¯ U+00AF
+  { "o", 0xF8 },      // ° U+00B0
+  { "+-", 0xF1 },     // ± U+00B1
+  { "2", 0xFD },      // ² U+00B2
+  { "3", 0x00 },      // ³ U+00B3
+  { "'", 0x00 },      // ´ U+00B4
+  { "u", 0xE6 },      // µ U+00B5
+  { "P", 0x00 },      // ¶ U+00B6
+  { ".", 0xFA },      // · U+00B7
+  { ",", 0x00 },      // ¸ U+00B8
+  { "1", 0x00 },      // ¹ U+00B9
+  { "o", 0xA7 },      // º U+00BA
+  { ">>", 0xAF },     // » U+00BB
+  { "1/4", 0xAC },    // ¼ U+00BC
+  { "1/2", 0xAB },    // ½ U+00BD
+  { "3/4", 0x00 },    // ¾ U+00BE
+  { "?", 0xA8 },      // ¿ U+00BF
+  { "A", 0x00 },      // À U+00C0
+  { "A", 0x00 },      // Á U+00C1
+  { "A", 0x00 },      // Â U+00C2
+  { "A", 0x00 },      // Ã U+00C3
+  { "A", 0x8E },      // Ä U+00C4
+  { "A", 0x8F },      // Å U+00C5
+  { "AE", 0x92 },     // Æ U+00C6
+  { "C", 0x80 },      // Ç U+00C7
+  { "E", 0x00 },      // È U+00C8
+  { "E", 0x90 },      // É U+00C9
+  { "E", 0x00 },      // Ê U+00CA
+  { "E", 0x00 },      // Ë U+00CB
+  { "I", 0x00 },      // Ì U+00CC
+  { "I", 0x00 },      // Í U+00CD
+  { "I", 0x00 },      // Î U+00CE
+  { "I", 0x00 },      // Ï U+00CF
+  { "D", 0x00 },      // Ð U+00D0
+  { "N", 0xA5 },      // Ñ U+00D1
+  { "O", 0x00 },      // Ò U+00D2
+  { "O", 0x00 },      // Ó U+00D3
+  { "O", 0x00 },      // Ô U+00D4
+  { "O", 0x00 },      // Õ U+00D5
+  { "O", 0x99 },      // Ö U+00D6
+  { "x", 0x00 },      // × U+00D7
+  { "O", 0x00 },      // Ø U+00D8
+  { "U", 0x00 },      // Ù U+00D9
+  { "U", 0x00 },      // Ú U+00DA
+  { "U", 0x00 },      // Û U+00DB
+  { "U", 0x9A },      // Ü U+00DC
+  { "Y", 0x00 },      // Ý U+00DD
+  { "Th", 0x00 },     // Þ U+00DE
+  { "ss", 0xE1 },     // ß U+00DF
+  { "a", 0x85 },      // à U+00E0
+  { "a", 0xA0 },      // á U+00E1
+  { "a", 0x83 },      // â U+00E2
+  { "a", 0x00 },      // ã U+00E3
+  { "a", 0x84 },      // ä U+00E4
+  { "a", 0x86 },      // å U+00E5
+  { "ae", 0x91 },     // æ U+00E6
+  { "c", 0x87 },      // ç U+00E7
+  { "e", 0x8A },      // è U+00E8
+  { "e", 0x82 },      // é U+00E9
+  { "e", 0x88 },      // ê U+00EA
+  { "e", 0x89 },      // ë U+00EB
+  { "i", 0x8D },      // ì U+00EC
+  { "i", 0xA1 },      // í U+00ED
+  { "i", 0x8C },      // î U+00EE
+  { "i", 0x8B },      // ï U+00EF
+  { "d", 0x00 },      // ð U+00F0
+  { "n", 0xA4 },      // ñ U+00F1
+  { "o", 0x95 },      // ò U+00F2
+  { "o", 0xA2 },      // ó U+00F3
+  { "o", 0x93 },      // ô U+00F4
+  { "o", 0x00 },      // õ U+00F5
+  { "o", 0x94 },      // ö U+00F6
+  { "/", 0xF6 },      // ÷ U+00F7
+  { "o", 0x00 },      // ø U+00F8
+  { "u", 0x97 },      // ù U+00F9
+  { "u", 0xA3 },      // ú U+00FA
+  { "u", 0x96 },      // û U+00FB
+  { "u", 0x81 },      // ü U+00FC
+  { "y", 0x00 },      // ý U+00FD
+  { "th", 0x00 },     // þ U+00FE
+  { "y", 0x98 },      // ÿ U+00FF
+};
+
+struct CharMapWide {
+  uint16_t cp;
+  CharMap map;
+};
+
+// Fora do Latin-1, em ordem crescente (busca binária)
+static const CharMapWide CHARMAP_WIDE[] PROGMEM = {
+  { 0x0152, { "OE", 0x00 } },   // Œ
+  { 0x0153, { "oe", 0x00 } },   // œ
+  { 0x03C0, { "pi", 0xE3 } },   // π
+  { 0x2013, { "-", 0x00 } },    // –
+  { 0x2014, { "-", 0x00 } },    // —
+  { 0x2018, { "'", 0x00 } },    // ‘
+  { 0x2019, { "'", 0x00 } },    // ’
+  { 0x201A, { ",", 0x00 } },    // ‚
+  { 0x201C, { "\"", 0x00 } },   // “
+  { 0x201D, { "\"", 0x00 } },   // ”
+  { 0x201E, { "\"", 0x00 } },   // „
+  { 0x2022, { "*", 0xF9 } },    // •
+  { 0x2026, { "...", 0x00 } },  // …
+  { 0x2032, { "'", 0x00 } },    // ′
+  { 0x20AC, { "EUR", 0x00 } },  // €
+  { 0x2122, { "TM", 0x00 } },   // ™
+  { 0x2190, { "<-", 0x00 } },   // ←
+  { 0x2192, { "->", 0x00 } },   // →
+  { 0x2212, { "-", 0x00 } },    // −
+  { 0x221A, { "V", 0xFB } },    // √
+  { 0x2248, { "~", 0xF7 } },    // ≈
+  { 0x2264, { "<=", 0xF3 } },   // ≤
+  { 0x2265, { ">=", 0xF2 } },   // ≥
+};
+#define CHARMAP_WIDE_COUNT (sizeof(CHARMAP_WIDE) / sizeof(CHARMAP_WIDE[0]))
+
+// Mapa do código (false = sem mapa)
+static bool textCharMap(uint32_t cp, CharMap &out) {
+  if (cp >= 0xA0 && cp <= 0xFF) {
+    memcpy_P(&out, &CHARMAP_LATIN1[cp - 0xA0], sizeof(out));
+    return true;
+  }
+  int lo = 0, hi = CHARMAP_WIDE_COUNT - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    uint16_t c = pgm_read_word(&CHARMAP_WIDE[mid].cp);
+    if (c == cp) {
+      memcpy_P(&out, &CHARMAP_WIDE[mid].map, sizeof(out));
+      return true;
+    }
+    if (c < cp) lo = mid + 1; else hi = mid - 1;
+  }
+  return false;
+}
+
+// Próximo código de s; avança s. Sequência inválida: 0xFFFD, 1 byte
+static uint32_t textDecodeUtf8(const uint8_t *&s) {
+  uint8_t c = *s++;
+  if (c < 0x80) return c;
+  uint8_t extra;
+  uint32_t cp, min;
+  if ((c & 0xE0) == 0xC0) { extra = 1; cp = c & 0x1F; min = 0x80; }
+  else if ((c & 0xF0) == 0xE0) { extra = 2; cp = c & 0x0F; min = 0x800; }
+  else if ((c & 0xF8) == 0xF0) { extra = 3; cp = c & 0x07; min = 0x10000; }
+  else return 0xFFFD;
+  const uint8_t *p = s;
+  for (uint8_t i = 0; i < extra; i++, p++) {
+    if ((*p & 0xC0) != 0x80) return 0xFFFD;   // inclui o '\0' final
+    cp = (cp << 6) | (*p & 0x3F);
+  }
+  if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return 0xFFFD;
+  s = p;
+  return cp;
+}
+
+// Converte in (UTF-8) para o charset do display em out (sempre terminado
+// em '\0'). Quebras de linha e tabs viram espaço. Retorna o tamanho; texto
+// vazio vira "?".
+static size_t textToDisplay(const char *in, char *out, size_t outSize, DisplayCharset cs = CHARSET_ASCII) {
+  if (!outSize) return 0;
+  size_t n = 0, cap = outSize - 1;
+  const uint8_t *s = (const uint8_t *)(in ? in : "");
+  while (*s && n < cap) {
+    if (*s >= 32 && *s < 127) {     // caminho rápido: ASCII imprimível
+      out[n++] = (char)*s++;
+      continue;
+    }
+    uint32_t cp = textDecodeUtf8(s);
+    if (cp < 0x80) {
+      if (cp == '\n' || cp == '\t' || cp == '\r') out[n++] = ' ';
+      continue;                     // demais controles são descartados
+    }
+    if (cp == 0xFFFD) {
+      out[n++] = '?';
+      continue;
+    }
+    CharMap m;
+    if (!textCharMap(cp, m)) continue;
+    if (cs == CHARSET_CP437 && m.cp437) {
+      out[n++] = (char)m.cp437;
+      continue;
+    }
+    for (uint8_t i = 0; i < sizeof(m.ascii) && m.ascii[i] && n < cap; i++) out[n++] = m.ascii[i];
+  }
+  if (n == 0 && cap) out[n++] = '?';
+  out[n] = '\0';
+  return n;
+}
+
+// Charset que a fonte consegue desenhar
+static inline DisplayCharset textCharsetFor(uint8_t font) {
+  return font == 1 ? CHARSET_CP437 : CHARSET_ASCII;
+}
+
+// Bytes >= 128 chegam à fonte como índice CP437, não como UTF-8
+static void textCharsetBegin(TFT_eSPI &tft, DisplayCharset cs) {
+  if (cs != CHARSET_CP437) return;
+  tft.setAttribute(UTF8_SWITCH, false);
+  tft.setAttribute(CP437_SWITCH, true);
+}
+
+static void textCharsetEnd(TFT_eSPI &tft, DisplayCharset cs) {
+  if (cs == CHARSET_CP437) tft.setAttribute(UTF8_SWITCH, true);
+}
+
+#endif // TEXT_CHARSET_H
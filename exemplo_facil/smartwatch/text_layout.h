@@ -0,0 +1,382 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <TFT_eSPI.h>
+
+// ==========================================
+// LAYOUT DE TEXTO NA TELA REDONDA
+// ==========================================
+// Quebra de linhas feita uma vez por mensagem e guardada em TextLayout:
+//   - TextCircle: meia-corda de cada linha de pixels (tabela de 240 bytes,
+//     raiz inteira, calculada uma vez por raio);
+//   - TextFontMetrics: avanço de cada caractere ASCII por fonte/tamanho, a
+//     quebra soma inteiros em vez de medir substrings com textWidth();
+//   - TextLayout: cópia do texto + linhas prontas (início, tamanho, x, y).
+// textLayoutSet() só refaz a quebra se o texto ou a caixa mudaram (hash,
+// confirmado comparando caixa e bytes do texto).
+// Texto que cabe na faixa [top, bottom) é centralizado e cada linha usa a
+// largura da corda na sua altura; texto maior rola: todas as linhas usam a
+// corda mais estreita da faixa, então a rolagem só desloca as linhas já
+// quebradas (textLayoutDraw(..., firstLine)).
+// Texto que passa de TEXT_LAYOUT_LINES (ou de maxLines) é cortado com "..."
+// no fim da última linha guardada (TextLayout.truncated).
+// O texto deve vir no charset do display (ASCII ou CP437, ver
+// textToDisplay em text_charset.h).
+// O mesmo arquivo existe em exemplo_facil/smartwatch/text_layout.h e em
+// esp32_rom_ble/TextLayout.h (sketches Arduino não compartilham headers entre
+// pastas): edite um e copie para o outro. O make de smartwatch/tests compara
+// os dois (cmp) e test_text_layout.cpp testa a quebra, a rolagem e o corte.
+
+// Recorte da rolagem: pelo display_clip.h quando o sketch tem (respeita o
+// overlay de notificação); senão, viewport comum
+#if __has_include("display_clip.h")
+#include "display_clip.h"
+#define TEXT_LAYOUT_CLIP(tft, x, y, w, h) displayClipPush(tft, x, y, w, h)
+#define TEXT_LAYOUT_UNCLIP(tft) displayClipPop(tft)
+#else
+#define TEXT_LAYOUT_CLIP(tft, x, y, w, h) (tft).setViewport(x, y, w, h, false)
+#define TEXT_LAYOUT_UNCLIP(tft) (tft).resetViewport()
+#endif
+
+#ifndef TEXT_LAYOUT_CHARS
+#define TEXT_LAYOUT_CHARS 256         // Texto guardado por layout
+#endif
+#ifndef TEXT_LAYOUT_LINES
+#define TEXT_LAYOUT_LINES 16          // Linhas guardadas por layout
+#endif
+
+#define TEXT_LAYOUT_ROWS 240
+#define TEXT_LAYOUT_BOX_FIELDS 13
+#define TEXT_FONT_FIRST 32
+#define TEXT_FONT_LAST 126
+#define TEXT_FONT_SLOTS 4
+
+enum TextAlign : uint8_t {
+  TEXT_ALIGN_CENTER,                  // centraliza em cx, largura pela corda
+  TEXT_ALIGN_LEFT                     // a partir de left, largura maxW
+};
+
+// Métricas
+uint32_t textLayoutBuilds = 0;        // quebras calculadas
+uint32_t textLayoutReuses = 0;        // textLayoutSet() sem mudança
+
+// ---------- Cordas do círculo ----------
+struct TextCircle {
+  int16_t cx, cy, r;
+  uint8_t half[TEXT_LAYOUT_ROWS];     // meia-corda por linha (0 = fora)
+};
+
+static int32_t textIsqrt(int32_t v) {
+  if (v <= 0) return 0;
+  int32_t x = v, y = (x + 1) / 2;
+  while (y < x) {
+    x = y;
+    y = (x + v / x) / 2;
+  }
+  return x;
+}
+
+static void textCircleInit(TextCircle &c, int16_t cx, int16_t cy, int16_t r) {
+  c.cx = cx;
+  c.cy = cy;
+  c.r = r;
+  for (int y = 0; y < TEXT_LAYOUT_ROWS; y++) {
+    int32_t dy = y - cy;
+    int32_t h = textIsqrt((int32_t)r * r - dy * dy);
+    c.half[y] = h > 255 ? 255 : (uint8_t)h;
+  }
+}
+
+// Largura útil entre as linhas y0 e y1 (inclusive): a corda mais curta
+static int16_t textChordWidth(const TextCircle &c, int y0, int y1) {
+  if (y0 < 0 || y1 >= TEXT_LAYOUT_ROWS) return 0;
+  // A corda encolhe com a distância ao centro: a menor está numa das pontas
+  uint8_t a = c.half[y0], b = c.half[y1];
+  return 2 * (a < b ? a : b);
+}
+
+// ---------- Métricas de fonte ----------
+struct TextFontMetrics {
+  uint8_t font, size;
+  uint8_t height;
+  uint8_t adv[TEXT_FONT_LAST - TEXT_FONT_FIRST + 1];
+};
+
+static TextFontMetrics textFonts[TEXT_FONT_SLOTS];
+static uint8_t textFontCount = 0;
+
+static const TextFontMetrics &textFontMetrics(TFT_eSPI &tft, uint8_t font, uint8_t size) {
+  for (uint8_t i = 0; i < textFontCount; i++) {
+    if (textFonts[i].font == font && textFonts[i].size == size) return textFonts[i];
+  }
+  // Tabela cheia: reaproveita a última posição
+  TextFontMetrics &m = textFonts[textFontCount < TEXT_FONT_SLOTS ? textFontCount++ : TEXT_FONT_SLOTS - 1];
+  m.font = font;
+  m.size = size;
+  uint8_t oldSize = tft.textsize;
+  tft.setTextSize(size);
+  m.height = tft.fontHeight(font);
+  char s[2] = { 0, 0 };
+  for (int c = TEXT_FONT_FIRST; c <= TEXT_FONT_LAST; c++) {
+    s[0] = (char)c;
+    m.adv[c - TEXT_FONT_FIRST] = tft.textWidth(s, font);
+  }
+  tft.setTextSize(oldSize);
+  return m;
+}
+
+static inline uint8_t textAdvance(const TextFontMetrics &m, char c) {
+  uint8_t u = (uint8_t)c;
+  if (u < TEXT_FONT_FIRST || u > TEXT_FONT_LAST) u = '?';
+  return m.adv[u - TEXT_FONT_FIRST];
+}
+
+// ---------- Layout ----------
+struct TextLine {
+  uint16_t start;       // deslocamento em TextLayout.text
+  uint8_t len;
+  int16_t x, y;         // canto superior esquerdo (y sem rolagem)
+  int16_t w;
+};
+
+struct TextLayout {
+  // Caixa (preenchida por textLayoutInit)
+  const TextCircle *circle;   // nullptr: largura fixa maxW
+  uint8_t font, size;
+  TextAlign align;
+  int16_t left, maxW;         // TEXT_ALIGN_LEFT / limite de largura
+  int16_t top, bottom;        // faixa vertical [top, bottom)
+  int16_t pad;                // folga de cada lado da corda
+  uint8_t lineGap;
+  uint8_t maxLines;           // 0 = quantas couberem na faixa
+
+  // Resultado
+  uint32_t key;
+  int16_t keyBox[TEXT_LAYOUT_BOX_FIELDS];   // caixa usada na quebra
+  uint16_t textLen;
+  char text[TEXT_LAYOUT_CHARS];
+  TextLine lines[TEXT_LAYOUT_LINES];
+  uint8_t count;
+  uint8_t visible;            // linhas que cabem na faixa
+  int16_t lineH;
+  bool scrolls;
+  bool truncated;             // sobrou texto: última linha termina em "..."
+};
+
+// Define a caixa sem descartar a quebra atual: se nada mudou, o próximo
+// textLayoutSet() com o mesmo texto reaproveita as linhas
+static void textLayoutBox(TextLayout &l, const TextCircle *circle, uint8_t font, uint8_t size,
+                          TextAlign align, int16_t left, int16_t maxW,
+                          int16_t top, int16_t bottom, int16_t pad = 4,
+                          uint8_t lineGap = 2, uint8_t maxLines = 0) {
+  l.circle = circle;
+  l.font = font;
+  l.size = size;
+  l.align = align;
+  l.left = left;
+  l.maxW = maxW;
+  l.top = top;
+  l.bottom = bottom;
+  l.pad = pad;
+  l.lineGap = lineGap;
+  l.maxLines = maxLines;
+}
+
+static void textLayoutInit(TextLayout &l, const TextCircle *circle, uint8_t font, uint8_t size,
+                           TextAlign align, int16_t left, int16_t maxW,
+                           int16_t top, int16_t bottom, int16_t pad = 4,
+                           uint8_t lineGap = 2, uint8_t maxLines = 0) {
+  textLayoutBox(l, circle, font, size, align, left, maxW, top, bottom, pad, lineGap, maxLines);
+  l.key = 0;
+  l.textLen = 0;
+  l.text[0] = '\0';
+  l.count = 0;
+  l.visible = 0;
+  l.lineH = 0;
+  l.scrolls = false;
+  l.truncated = false;
+}
+
+static void textLayoutBoxKey(const TextLayout &l, int16_t box[TEXT_LAYOUT_BOX_FIELDS]) {
+  const int16_t b[TEXT_LAYOUT_BOX_FIELDS] = {
+    l.font, l.size, l.align, l.left, l.maxW, l.top, l.bottom, l.pad, l.lineGap, l.maxLines,
+    (int16_t)(l.circle ? l.circle->r : -1), (int16_t)(l.circle ? l.circle->cx : 0),
+    (int16_t)(l.circle ? l.circle->cy : 0) };
+  memcpy(box, b, sizeof(b));
+}
+
+// Texto (até len bytes) + caixa
+static uint32_t textLayoutHash(const int16_t box[TEXT_LAYOUT_BOX_FIELDS], const char *text, size_t len) {
+  uint32_t h = 2166136261u;   // FNV-1a
+  for (size_t i = 0; i < len; i++) h = (h ^ (uint8_t)text[i]) * 16777619u;
+  for (size_t i = 0; i < TEXT_LAYOUT_BOX_FIELDS; i++) h = (h ^ (uint16_t)box[i]) * 16777619u;
+  return h | 1;               // 0 = layout vazio
+}
+
+// Largura disponível para uma linha com topo em y
+static int16_t textLineWidth(const TextLayout &l, int16_t y) {
+  int16_t w = l.maxW;
+  if (l.circle) {
+    int16_t chord = textChordWidth(*l.circle, y, y + l.lineH - l.lineGap - 1) - 2 * l.pad;
+    if (chord < w) w = chord;
+  }
+  return w > 0 ? w : 0;
+}
+
+// Quebra a partir de text[i] na largura avail; devolve o fim da linha e o
+// início da próxima
+static uint16_t textBreakLine(const TextFontMetrics &m, const char *text, uint16_t i, int16_t avail,
+                              uint16_t &next, int16_t &lineW) {
+  int16_t w = 0, wSpace = 0;
+  int32_t space = -1;
+  uint16_t j = i;
+  for (; text[j] && text[j] != '\n'; j++) {
+    uint8_t cw = textAdvance(m, text[j]);
+    if (w + cw > avail && j > i) break;
+    if (text[j] == ' ') {
+      space = j;
+      wSpace = w;
+    }
+    w += cw;
+  }
+  uint16_t end = j;
+  if (!text[j] || text[j] == '\n') {
+    next = text[j] ? j + 1 : j;
+  } else if (space > i) {
+    end = space;
+    w = wSpace;
+    next = space + 1;
+  } else {
+    next = j;                 // palavra maior que a linha: corta no meio
+  }
+  while (end > i && text[end - 1] == ' ') w -= textAdvance(m, text[--end]);
+  lineW = w;
+  return end;
+}
+
+// Largura constante da rolagem: a linha mais estreita da faixa (primeira ou
+// última visível)
+static int16_t textLayoutFixedWidth(const TextLayout &l) {
+  int16_t a = textLineWidth(l, l.top), b = textLineWidth(l, l.top + (l.visible - 1) * l.lineH);
+  return a < b ? a : b;
+}
+
+static void textLineAlign(const TextLayout &l, TextLine &ln, int16_t w) {
+  if (l.align == TEXT_ALIGN_LEFT) {
+    ln.x = l.left;
+  } else {
+    int16_t cx = l.circle ? l.circle->cx : l.left + l.maxW / 2;
+    ln.x = cx - w / 2;
+  }
+}
+
+// Quebra todo o texto com a primeira linha em y0; false se passou de limit
+static bool textLayoutBreak(TextLayout &l, const TextFontMetrics &m, int16_t y0, uint8_t limit, bool fixedW) {
+  int16_t wFixed = fixedW ? textLayoutFixedWidth(l) : 0;
+  uint16_t i = 0;
+  l.count = 0;
+  while (l.text[i] == ' ') i++;
+  while (l.text[i]) {
+    if (l.count == limit) return false;
+    int16_t y = y0 + l.count * l.lineH;
+    int16_t avail = fixedW ? wFixed : textLineWidth(l, y);
+    uint16_t next;
+    int16_t w;
+    uint16_t end = textBreakLine(m, l.text, i, avail, next, w);
+    TextLine &ln = l.lines[l.count++];
+    ln.start = i;
+    ln.len = end - i;
+    ln.y = y;
+    ln.w = w;
+    textLineAlign(l, ln, w);
+    i = next;
+    while (l.text[i] == ' ') i++;
+  }
+  return true;
+}
+
+// Define o texto; refaz a quebra só quando algo mudou. Retorna true se refez
+static bool textLayoutSet(TFT_eSPI &tft, TextLayout &l, const char *text) {
+  size_t len = strnlen(text, TEXT_LAYOUT_CHARS - 1);
+  int16_t box[TEXT_LAYOUT_BOX_FIELDS];
+  textLayoutBoxKey(l, box);
+  uint32_t key = textLayoutHash(box, text, len);
+  // O hash só descarta rápido; colisão não pode mostrar o texto antigo
+  if (key == l.key && len == l.textLen && memcmp(box, l.keyBox, sizeof(box)) == 0 &&
+      memcmp(text, l.text, len) == 0) {
+    textLayoutReuses++;
+    return false;
+  }
+  l.key = key;
+  memcpy(l.keyBox, box, sizeof(box));
+  l.textLen = len;
+  memcpy(l.text, text, len);
+  l.text[len] = '\0';
+  textLayoutBuilds++;
+
+  const TextFontMetrics &m = textFontMetrics(tft, l.font, l.size);
+  l.lineH = m.height + l.lineGap;
+  int16_t bandH = l.bottom - l.top;
+  l.visible = bandH >= l.lineH ? bandH / l.lineH : 1;
+  if (l.maxLines && l.visible > l.maxLines) l.visible = l.maxLines;
+  if (l.visible > TEXT_LAYOUT_LINES) l.visible = TEXT_LAYOUT_LINES;
+
+  // Menor número de linhas que, centralizado na faixa, comporta o texto
+  // (a largura de cada linha depende da altura em que ela cai)
+  l.scrolls = false;
+  l.truncated = false;
+  for (uint8_t n = l.align == TEXT_ALIGN_LEFT ? l.visible : 1; n <= l.visible; n++) {
+    int16_t y0 = l.align == TEXT_ALIGN_LEFT ? l.top : l.top + (bandH - n * l.lineH) / 2;
+    if (textLayoutBreak(l, m, y0, n, false)) return true;
+  }
+
+  // Não cabe: largura constante para poder rolar (ou cortar em maxLines)
+  l.scrolls = !l.maxLines;
+  l.truncated = !textLayoutBreak(l, m, l.top, l.maxLines ? l.visible : TEXT_LAYOUT_LINES, true);
+  if (l.truncated && l.count) {
+    // Abre espaço para "..." no fim da última linha
+    TextLine &ln = l.lines[l.count - 1];
+    int16_t avail = textLayoutFixedWidth(l) - 3 * textAdvance(m, '.');
+    while (ln.len && (ln.w > avail || l.text[ln.start + ln.len - 1] == ' ')) {
+      ln.w -= textAdvance(m, l.text[ln.start + --ln.len]);
+    }
+    textLineAlign(l, ln, ln.w + 3 * textAdvance(m, '.'));
+  }
+  return true;
+}
+
+// Primeira linha máxima da rolagem
+static uint8_t textLayoutMaxScroll(const TextLayout &l) {
+  return l.scrolls && l.count > l.visible ? l.count - l.visible : 0;
+}
+
+// Desenha as linhas a partir de firstLine (rolagem), recortadas na faixa.
+// Com fg != bg o fundo de cada linha é pintado pela própria fonte; a área
+// da faixa deve ser limpa pelo chamador quando o layout muda.
+static void textLayoutDraw(TFT_eSPI &tft, const TextLayout &l, uint16_t fg, uint16_t bg, uint8_t firstLine = 0) {
+  if (!l.count) return;
+  uint8_t maxFirst = textLayoutMaxScroll(l);
+  if (firstLine > maxFirst) firstLine = maxFirst;
+  int16_t dy = firstLine * l.lineH;
+
+  tft.setTextFont(l.font);
+  tft.setTextSize(l.size);
+  tft.setTextColor(fg, bg);
+  tft.setTextDatum(TL_DATUM);
+  if (l.scrolls) TEXT_LAYOUT_CLIP(tft, 0, l.top, tft.width(), l.bottom - l.top);
+
+  char buf[TEXT_LAYOUT_CHARS + 3];
+  for (uint8_t i = firstLine; i < l.count && i < firstLine + l.visible; i++) {
+    const TextLine &ln = l.lines[i];
+    memcpy(buf, l.text + ln.start, ln.len);
+    if (l.truncated && i == l.count - 1) {
+      memcpy(buf + ln.len, "...", 4);
+    } else {
+      buf[ln.len] = '\0';
+    }
+    tft.drawString(buf, ln.x, ln.y - dy);
+  }
+  if (l.scrolls) TEXT_LAYOUT_UNCLIP(tft);
+}
+
+#endif // TEXT_LAYOUT_H
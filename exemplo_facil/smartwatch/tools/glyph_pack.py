@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+"""Rasteriza os dígitos do relógio (7 segmentos) num atlas de alfa 4 bits.
+
+Uso (na pasta do sketch):
+    python3 tools/glyph_pack.py                 # gera glyphs_time.h (altura 48)
+    python3 tools/glyph_pack.py --stats         # + bytes e SPI estimado por glifo
+
+Os glifos "0123456789:- " são desenhados como polígonos (segmentos com
+pontas chanfradas), levemente inclinados (--slant), e amostrados 4x4 por
+pixel: a cobertura vira alfa de 0 a 15. Cada glifo ocupa a célula inteira
+(avanço x altura), então é enviado opaco e cobre o que havia antes sem
+limpar.
+
+Formato de saída (lido por glyph_atlas.h):
+    GlyphInfo { ch, w, offset }   um por glifo, offset em bytes no alfa
+    alfa: 2 pixels por byte (nibble alto primeiro), w sempre par
+
+--stats compara os bytes enviados pelo display por glifo (SPI a
+--spi-mhz) com o drawString da fonte 7 do TFT_eSPI, que repinta a string
+inteira a cada atualização. É uma estimativa pelos bytes; o benchmark de host
+em tests/ (bench_glyphs) mede o relógio incremental de um dia.
+"""
+
+import argparse
+import os
+
+GLYPHS = "0123456789:- "
+SEGMENTS = {            # a b c d e f g
+    "0": "abcdef", "1": "bc", "2": "abdeg", "3": "abcdg", "4": "bcfg",
+    "5": "acdfg", "6": "acdefg", "7": "abc", "8": "abcdefg", "9": "abcdfg",
+    "-": "g", " ": "", ":": "",
+}
+SUPERSAMPLE = 4
+
+# Modelo do barramento para --stats
+WINDOW_BYTES = 11             # setAddrWindow por envio
+DRAWSTRING_RUN_BYTES = 13     # fonte 7 transparente: drawFastHLine por trecho
+
+
+def hexagon_h(x0, x1, yc, t):
+    h = t / 2.0
+    return [(x0, yc), (x0 + h, yc - h), (x1 - h, yc - h), (x1, yc), (x1 - h, yc + h), (x0 + h, yc + h)]
+
+
+def hexagon_v(xc, y0, y1, t):
+    h = t / 2.0
+    return [(xc, y0), (xc + h, y0 + h), (xc + h, y1 - h), (xc, y1), (xc - h, y1 - h), (xc - h, y0 + h)]
+
+
+def rect(x0, y0, x1, y1):
+    return [(x0, y0), (x1, y0), (x1, y1), (x0, y1)]
+
+
+def inside(poly, x, y):
+    # Polígono convexo em sentido horário (y para baixo)
+    n = len(poly)
+    for i in range(n):
+        ax, ay = poly[i]
+        bx, by = poly[(i + 1) % n]
+        if (bx - ax) * (y - ay) - (by - ay) * (x - ax) < 0:
+            return False
+    return True
+
+
+def glyph_polys(ch, w, h, t, gap):
+    if ch == ":":
+        s = t
+        cx = w / 2.0
+        return [rect(cx - s / 2, h * 0.33 - s / 2, cx + s / 2, h * 0.33 + s / 2),
+                rect(cx - s / 2, h * 0.67 - s / 2, cx + s / 2, h * 0.67 + s / 2)]
+    margin = max(2, w // 12)
+    xl, xr = margin + t / 2.0, w - margin - t / 2.0
+    yt, ym, yb = margin + t / 2.0, h / 2.0, h - margin - t / 2.0
+    seg = {
+        "a": hexagon_h(xl + gap, xr - gap, yt, t),
+        "g": hexagon_h(xl + gap, xr - gap, ym, t),
+        "d": hexagon_h(xl + gap, xr - gap, yb, t),
+        "f": hexagon_v(xl, yt + gap, ym - gap, t),
+        "b": hexagon_v(xr, yt + gap, ym - gap, t),
+        "e": hexagon_v(xl, ym + gap, yb - gap, t),
+        "c": hexagon_v(xr, ym + gap, yb - gap, t),
+    }
+    return [seg[s] for s in SEGMENTS[ch]]
+
+
+def rasterize(polys, w, h, slant):
+    alpha = []
+    step = 1.0 / SUPERSAMPLE
+    for py in range(h):
+        for px in range(w):
+            hits = 0
+            for sy in range(SUPERSAMPLE):
+                for sx in range(SUPERSAMPLE):
+                    y = py + (sy + 0.5) * step
+                    x = px + (sx + 0.5) * step + (h / 2.0 - y) * -slant
+                    if any(inside(p, x, y) for p in polys):
+                        hits += 1
+            alpha.append((hits * 15 + SUPERSAMPLE * SUPERSAMPLE // 2) // (SUPERSAMPLE * SUPERSAMPLE))
+    return alpha
+
+
+def pack_nibbles(alpha):
+    return bytes((alpha[i] << 4) | alpha[i + 1] for i in range(0, len(alpha), 2))
+
+
+def runs_per_glyph(alpha, w):
+    # Trechos contínuos de pixels acesos por linha (como a fonte 7 desenha)
+    runs = 0
+    for i in range(0, len(alpha), w):
+        row = alpha[i:i + w]
+        on = False
+        for a in row:
+            if a >= 8 and not on:
+                runs += 1
+            on = a >= 8
+    return runs
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    sketch = os.path.dirname(here)
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--height", type=int, default=48)
+    ap.add_argument("--name", default="TIME48")
+    ap.add_argument("--slant", type=float, default=0.06, help="inclinação (px por px de altura)")
+    ap.add_argument("--output", default=os.path.join(sketch, "glyphs_time.h"))
+    ap.add_argument("--stats", action="store_true")
+    ap.add_argument("--spi-mhz", type=float, default=27.0)
+    args = ap.parse_args()
+
+    h = args.height
+    digit_w = (int(round(h * 0.58)) + 1) & ~1
+    colon_w = (int(round(h * 0.25)) + 1) & ~1
+    t = max(2, int(round(h / 8.0)))
+    gap = max(1, t // 5)
+
+    glyphs = []
+    offset = 0
+    for ch in GLYPHS:
+        w = colon_w if ch == ":" else digit_w
+        alpha = rasterize(glyph_polys(ch, w, h, t, gap), w, h, args.slant)
+        data = pack_nibbles(alpha)
+        glyphs.append({"ch": ch, "w": w, "offset": offset, "data": data, "alpha": alpha})
+        offset += len(data)
+
+    name = args.name
+    lines = [
+        "#ifndef GLYPHS_%s_H" % name,
+        "#define GLYPHS_%s_H" % name,
+        "",
+        "// GERADO por tools/glyph_pack.py (altura %d, traço %d) - não editar à mão." % (h, t),
+        "// Formato e renderizador: glyph_atlas.h",
+        "// %d glifos, %d bytes de alfa 4 bits" % (len(glyphs), offset),
+        "",
+        "static const uint8_t GLYPH_%s_ALPHA[] PROGMEM = {" % name,
+    ]
+    for g in glyphs:
+        lines.append("  // '%s' (%dx%d)" % (g["ch"], g["w"], h))
+        d = g["data"]
+        for i in range(0, len(d), 16):
+            lines.append("  " + ", ".join("0x%02X" % b for b in d[i:i + 16]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("static const GlyphInfo GLYPH_%s_GLYPHS[] PROGMEM = {" % name)
+    for g in glyphs:
+        lines.append("  { '%s', %d, %d }," % (g["ch"], g["w"], g["offset"]))
+    lines.append("};")
+    lines.append("")
+    lines.append("static const GlyphFont GLYPH_%s = { %d, %d, GLYPH_%s_GLYPHS, GLYPH_%s_ALPHA };"
+                 % (name, h, len(glyphs), name, name))
+    lines.append("")
+    lines.append("#endif // GLYPHS_%s_H" % name)
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines) + "\n")
+
+    print("%s: %d glifos de %d px de altura, %d bytes" % (os.path.basename(args.output), len(glyphs), h, offset))
+    if args.stats:
+        byte_us = 8.0 / args.spi_mhz
+        print("%-6s %4s %7s %10s %12s" % ("glifo", "w", "bytes", "atlas", "fonte 7"))
+        for g in glyphs:
+            cell = g["w"] * h
+            atlas_us = (WINDOW_BYTES + 2 * cell) * byte_us
+            lit = sum(1 for a in g["alpha"] if a >= 8)
+            runs = runs_per_glyph(g["alpha"], g["w"])
+            font_us = (2 * lit + runs * DRAWSTRING_RUN_BYTES) * byte_us
+            print("%-6s %4d %7d %8.0fus %10.0fus" % (repr(g["ch"]), g["w"], len(g["data"]), atlas_us, font_us))
+        print("(estimativa: SPI a %.0f MHz; o ganho do relógio vem de enviar só os glifos que mudam)"
+              % args.spi_mhz)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""Empacota os ícones 1 bit de tools/icons_src.h no formato RLE + paleta (icons_rle.h).
+
+Uso (na pasta do sketch):
+    python3 tools/icon_pack.py                      # gera icons_rle.h
+    python3 tools/icon_pack.py --stats              # + tabela de flash por ícone
+    python3 tools/icon_pack.py --icons mic,apple    # escolhe os ícones
+    python3 tools/icon_pack.py --size amor=200x200  # força o tamanho
+    python3 tools/icon_pack.py --all --output X.h   # todos (testes de host)
+
+Só entram no firmware os ícones de PACKED (os que alguma tela desenha); o
+resto de icons_src.h fica como fonte, fora do sketch.
+
+Entrada: arrays "static const unsigned char nome[] PROGMEM = {...}" no
+formato XBM do u8g2 (bit menos significativo = pixel da esquerda, linhas
+alinhadas em bytes). Sem --size, o tamanho é deduzido como quadrado
+(bytes = ceil(w / 8) * w).
+
+Formato de saída (lido por icon_rle.h):
+    ICON_RLE_TABLE[id] = { w, h, paleta, bytes, dados }
+    ICON_RLE_PALETTE   = 2 cores RGB565 por ícone (0 = fundo, 1 = frente)
+    ICON_RLE_DATA      = tokens de 1 byte, pixels em ordem de varredura:
+        0cnnnnnn  corrida da cor c: n + 1 pixels (n < 63);
+                  n = 63: 64 + próximo byte (64..319)
+        1ppppppp  literal: 7 pixels, bit 0 = primeiro (trechos sem corridas)
+A escolha entre corrida e literal minimiza o tamanho (programação dinâmica).
+
+O tempo de desenho é medido pelo benchmark de host em tests/ (bench_icons).
+"""
+
+import argparse
+import os
+import re
+import sys
+
+TOKEN_SHORT_MAX = 63          # corridas de 1..63 num token
+TOKEN_LONG_MIN = 64           # n = 63: 64 + próximo byte
+TOKEN_LONG_MAX = 64 + 255
+LITERAL_PIXELS = 7
+
+TABLE_ENTRY_BYTES = 12        # sizeof(IconRle)
+
+# Ícones desenhados pelo firmware (tela de status: WiFi e microfone)
+PACKED = ["wifi_icon_bits", "mic"]
+
+ARRAY_RE = re.compile(
+    r"static\s+const\s+unsigned\s+char\s+(\w+)\s*\[\s*\]\s*PROGMEM\s*=\s*\{(.*?)\};",
+    re.S)
+
+
+def parse_icons(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    icons = []
+    for name, body in ARRAY_RE.findall(text):
+        data = [int(v, 16) for v in re.findall(r"0x([0-9A-Fa-f]{1,2})", body)]
+        icons.append((name, data))
+    return icons
+
+
+def infer_size(nbytes):
+    for w in range(1, 1025):
+        if ((w + 7) // 8) * w == nbytes:
+            return w, w
+    return None
+
+
+def unpack_xbm(data, w, h):
+    stride = (w + 7) // 8
+    if len(data) < stride * h:
+        raise ValueError("bitmap menor que %dx%d" % (w, h))
+    px = []
+    for y in range(h):
+        row = data[y * stride:(y + 1) * stride]
+        for x in range(w):
+            px.append((row[x >> 3] >> (x & 7)) & 1)
+    return px
+
+
+def runs_of(px):
+    runs = []
+    i = 0
+    while i < len(px):
+        j = i
+        while j < len(px) and px[j] == px[i]:
+            j += 1
+        runs.append((px[i], j - i))
+        i = j
+    return runs
+
+
+def encode(px):
+    count = len(px)
+    # Comprimento da corrida que começa em cada pixel
+    run = [0] * (count + 1)
+    for i in range(count - 1, -1, -1):
+        run[i] = run[i + 1] + 1 if i + 1 < count and px[i + 1] == px[i] else 1
+    # cost[i] = menor nº de bytes para codificar px[i:]
+    cost = [0] * (count + 1)
+    choice = [0] * (count + 1)        # > 0: corrida de n pixels; 0: literal
+    for i in range(count - 1, -1, -1):
+        best = 1 + cost[min(count, i + LITERAL_PIXELS)]
+        pick = 0
+        for n in range(1, min(run[i], TOKEN_LONG_MAX) + 1):
+            c = (1 if n <= TOKEN_SHORT_MAX else 2) + cost[i + n]
+            if c < best:
+                best, pick = c, n
+        cost[i], choice[i] = best, pick
+    out = bytearray()
+    i = 0
+    while i < count:
+        n = choice[i]
+        if n == 0:
+            bits = 0
+            for k in range(min(LITERAL_PIXELS, count - i)):
+                bits |= px[i + k] << k
+            out.append(0x80 | bits)
+            i += LITERAL_PIXELS
+        elif n >= TOKEN_LONG_MIN:
+            out.append((px[i] << 6) | 63)
+            out.append(n - TOKEN_LONG_MIN)
+            i += n
+        else:
+            out.append((px[i] << 6) | (n - 1))
+            i += n
+    return bytes(out)
+
+
+def decode(blob, count):
+    """Tokens -> lista de (índice, n) na ordem do decodificador do firmware."""
+    runs = []
+    left = count
+    i = 0
+    while left > 0:
+        t = blob[i]
+        i += 1
+        if t & 0x80:
+            for k in range(min(LITERAL_PIXELS, left)):
+                runs.append(((t >> k) & 1, 1))
+            left -= min(LITERAL_PIXELS, left)
+            continue
+        n = t & 63
+        if n == 63:
+            n = TOKEN_LONG_MIN + blob[i]
+            i += 1
+        else:
+            n += 1
+        runs.append(((t >> 6) & 1, n))
+        left -= n
+    return runs
+
+
+def expand(runs):
+    px = []
+    for idx, n in runs:
+        px.extend([idx] * n)
+    return px
+
+
+def c_ident(name):
+    return "ICON_" + re.sub(r"\W", "_", name).upper()
+
+
+def emit_header(path, packed, source):
+    lines = []
+    lines.append("#ifndef ICONS_RLE_H")
+    lines.append("#define ICONS_RLE_H")
+    lines.append("")
+    lines.append("// GERADO por tools/icon_pack.py a partir de %s - não editar à mão." % source)
+    lines.append("// Formato e decodificador: icon_rle.h")
+    raw = sum(p["raw"] for p in packed)
+    rle = sum(len(p["blob"]) for p in packed)
+    lines.append("// %d ícones: %d bytes 1 bit -> %d bytes RLE (+ %d de tabela/paleta)"
+                 % (len(packed), raw, rle, len(packed) * (TABLE_ENTRY_BYTES + 4)))
+    lines.append("")
+    lines.append("enum IconId : uint8_t {")
+    for p in packed:
+        lines.append("  %s,%s// %dx%d, %d -> %d bytes" % (
+            p["id"], " " * max(1, 24 - len(p["id"])), p["w"], p["h"], p["raw"], len(p["blob"])))
+    lines.append("  ICON_RLE_COUNT")
+    lines.append("};")
+    lines.append("")
+    lines.append("static const uint16_t ICON_RLE_PALETTE[] PROGMEM = {")
+    for p in packed:
+        lines.append("  0x0000, 0xFFFF,   // %s" % p["name"])
+    lines.append("};")
+    lines.append("")
+    lines.append("static const uint8_t ICON_RLE_DATA[] PROGMEM = {")
+    for p in packed:
+        lines.append("  // %s" % p["name"])
+        blob = p["blob"]
+        for i in range(0, len(blob), 16):
+            lines.append("  " + ", ".join("0x%02X" % b for b in blob[i:i + 16]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("static const IconRle ICON_RLE_TABLE[ICON_RLE_COUNT] PROGMEM = {")
+    for p in packed:
+        lines.append("  { %d, %d, %d, %d, %d },   // %s" % (
+            p["w"], p["h"], p["palette"], len(p["blob"]), p["offset"], p["name"]))
+    lines.append("};")
+    lines.append("")
+    lines.append("#endif // ICONS_RLE_H")
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    sketch = os.path.dirname(here)
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--input", default=os.path.join(here, "icons_src.h"))
+    ap.add_argument("--output", default=os.path.join(sketch, "icons_rle.h"))
+    ap.add_argument("--size", action="append", default=[], metavar="NOME=LxA")
+    ap.add_argument("--icons", default=",".join(PACKED), metavar="NOME,...")
+    ap.add_argument("--all", action="store_true", help="todos os ícones da entrada")
+    ap.add_argument("--stats", action="store_true")
+    args = ap.parse_args()
+
+    sizes = {}
+    for s in args.size:
+        name, dims = s.split("=")
+        w, h = dims.lower().split("x")
+        sizes[name] = (int(w), int(h))
+
+    icons = parse_icons(args.input)
+    found = dict(icons)
+    wanted = [n for n, _ in icons] if args.all else [n for n in args.icons.split(",") if n]
+    missing = [n for n in wanted if n not in found]
+    if missing:
+        sys.exit("ícones inexistentes em %s: %s" % (args.input, ", ".join(missing)))
+
+    packed = []
+    offset = 0
+    for name in wanted:
+        data = found[name]
+        wh = sizes.get(name) or infer_size(len(data))
+        if not wh:
+            sys.exit("%s: %d bytes não formam um quadrado; use --size %s=LxA"
+                     % (name, len(data), name))
+        w, h = wh
+        px = unpack_xbm(data, w, h)
+        blob = encode(px)
+        runs = decode(blob, len(px))
+        if expand(runs) != px:
+            sys.exit("%s: falha na verificação do RLE" % name)
+        packed.append({"name": name, "id": c_ident(name), "w": w, "h": h,
+                       "raw": len(data), "blob": blob, "runs": runs,
+                       "palette": len(packed) * 2, "offset": offset})
+        offset += len(blob)
+
+    emit_header(args.output, packed, os.path.basename(args.input))
+
+    raw = sum(p["raw"] for p in packed)
+    rle = sum(len(p["blob"]) for p in packed)
+    meta = len(packed) * (TABLE_ENTRY_BYTES + 4)
+    print("%s: %d ícones, %d -> %d bytes (+%d de tabela)"
+          % (os.path.basename(args.output), len(packed), raw, rle, meta))
+    if args.stats:
+        print("%-16s %9s %6s %6s %7s" % ("ícone", "tamanho", "1bit", "rle", "tokens"))
+        for p in packed:
+            print("%-16s %9s %6d %6d %7d"
+                  % (p["name"], "%dx%d" % (p["w"], p["h"]), p["raw"], len(p["blob"]), len(p["runs"])))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,236 @@
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include <TFT_eSPI.h>
+#include <stdarg.h>
+#include "config.h"
+#include "WatchFace.h"
+#include "icon_rle.h"
+
+// ==========================================
+// WIDGETS RETIDOS - só repinta o que mudou
+// ==========================================
+// Cada widget guarda o último valor desenhado e sua caixa na tela. O setter
+// compara com o novo valor e só marca "sujo" se mudou; widgetsFlush() repinta
+// os sujos numa única transação SPI (startWrite/endWrite) por quadro.
+//   LABEL  texto fixo (desenhado só após invalidar a tela)
+//   VALUE  texto dinâmico; ao encolher, limpa só as sobras da caixa antiga
+//   ARC    progresso 0..1 em arco espesso; drawArcDelta repinta só o trecho
+//          entre o valor desenhado e o novo
+//   ICON   ícone RLE (icons_rle.h), visível/oculto
+
+enum WidgetType : uint8_t {
+  WIDGET_LABEL,
+  WIDGET_VALUE,
+  WIDGET_ARC,
+  WIDGET_ICON
+};
+
+#define WIDGET_TEXT_MAX 40
+#define WIDGET_ARC_STEPS 1000   // resolução do progresso do arco
+
+struct WidgetRect {
+  int16_t x, y, w, h;
+};
+
+struct Widget {
+  WidgetType type;
+  int16_t x, y;           // âncora (texto: conforme datum; arco: centro; ícone: canto)
+  uint8_t font;
+  uint8_t datum;
+  uint16_t fg, bg;
+
+  int16_t w, h;           // ICON: tamanho do ícone
+  uint8_t icon;           // ICON: IconId
+
+  // ARC: raio, espessura, ângulos (graus) de início/fim, cor do trilho e
+  // flags ARC_* (bg é o fundo da tela, usado pelo ARC_AA)
+  int16_t r, thick;
+  int16_t a0, a1;
+  uint16_t track;
+  uint8_t arcFlags;
+
+  // Estado retido
+  char text[WIDGET_TEXT_MAX];
+  int16_t value;          // ARC: 0..WIDGET_ARC_STEPS; ICON: visível
+  int16_t drawnValue;     // -1 = nada desenhado
+  WidgetRect box;         // caixa desenhada (w = 0 se vazia)
+  bool dirty;
+};
+
+// ---------- Construtores ----------
+static inline Widget widgetText(WidgetType type, int16_t x, int16_t y, uint8_t font,
+                                uint8_t datum, uint16_t fg, uint16_t bg, const char *text = "") {
+  Widget w = {};
+  w.type = type;
+  w.x = x; w.y = y;
+  w.font = font; w.datum = datum;
+  w.fg = fg; w.bg = bg;
+  strncpy(w.text, text, WIDGET_TEXT_MAX - 1);
+  w.drawnValue = -1;
+  w.dirty = true;
+  return w;
+}
+
+static inline Widget widgetLabel(int16_t x, int16_t y, uint8_t font, uint8_t datum,
+                                 uint16_t fg, uint16_t bg, const char *text) {
+  return widgetText(WIDGET_LABEL, x, y, font, datum, fg, bg, text);
+}
+
+static inline Widget widgetValue(int16_t x, int16_t y, uint8_t font, uint8_t datum,
+                                 uint16_t fg, uint16_t bg) {
+  return widgetText(WIDGET_VALUE, x, y, font, datum, fg, bg, "");
+}
+
+static inline Widget widgetArc(int16_t cx, int16_t cy, int16_t r, int16_t thick,
+                               int16_t a0, int16_t a1, uint16_t fg, uint16_t track,
+                               uint16_t bg, uint8_t flags = ARC_AA) {
+  Widget w = {};
+  w.type = WIDGET_ARC;
+  w.x = cx; w.y = cy; w.r = r; w.thick = thick;
+  w.a0 = a0; w.a1 = a1;
+  w.fg = fg; w.track = track; w.bg = bg;
+  w.arcFlags = flags;
+  w.drawnValue = -1;
+  w.dirty = true;
+  return w;
+}
+
+static inline Widget widgetIcon(int16_t x, int16_t y, IconId icon, uint16_t fg, uint16_t bg) {
+  Widget w = {};
+  w.type = WIDGET_ICON;
+  w.x = x; w.y = y;
+  iconRleSize(icon, w.w, w.h);
+  w.icon = icon;
+  w.fg = fg; w.bg = bg;
+  w.value = 1;
+  w.drawnValue = -1;
+  w.dirty = true;
+  return w;
+}
+
+// ---------- Setters (marcam sujo só se o valor mudou) ----------
+static void widgetSetText(Widget &w, const char *text) {
+  if (strncmp(w.text, text, WIDGET_TEXT_MAX - 1) == 0) return;
+  strncpy(w.text, text, WIDGET_TEXT_MAX - 1);
+  w.text[WIDGET_TEXT_MAX - 1] = '\0';
+  w.dirty = true;
+}
+
+static void widgetSetTextf(Widget &w, const char *fmt, ...) {
+  char buf[WIDGET_TEXT_MAX];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  widgetSetText(w, buf);
+}
+
+static void widgetSetProgress(Widget &w, float progress01) {
+  if (progress01 < 0) progress01 = 0;
+  if (progress01 > 1) progress01 = 1;
+  int16_t v = (int16_t)(progress01 * WIDGET_ARC_STEPS + 0.5f);
+  if (v == w.value) return;
+  w.value = v;
+  w.dirty = true;
+}
+
+static void widgetSetVisible(Widget &w, bool visible) {
+  if ((w.value != 0) == visible) return;
+  w.value = visible ? 1 : 0;
+  w.dirty = true;
+}
+
+// Tela foi limpa: tudo precisa ser redesenhado do zero
+static void widgetsInvalidate(Widget *list, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    list[i].drawnValue = -1;
+    list[i].box.w = 0;
+    list[i].dirty = true;
+  }
+}
+
+// ---------- Desenho ----------
+static WidgetRect widgetTextBox(TFT_eSPI &tft, const Widget &w) {
+  WidgetRect b;
+  b.w = w.text[0] ? tft.textWidth(w.text, w.font) : 0;
+  b.h = tft.fontHeight(w.font);
+  uint8_t hx = w.datum % 3, vy = w.datum / 3;   // TL..BR = 0..8
+  b.x = w.x - (hx == 1 ? b.w / 2 : (hx == 2 ? b.w : 0));
+  b.y = w.y - (vy == 1 ? b.h / 2 : (vy == 2 ? b.h : 0));
+  return b;
+}
+
+// Limpa as partes de `old` fora de `now`
+static void widgetClearOutside(TFT_eSPI &tft, const WidgetRect &old, const WidgetRect &now, uint16_t bg) {
+  if (old.w <= 0) return;
+  if (now.w <= 0) {
+    tft.fillRect(old.x, old.y, old.w, old.h, bg);
+    return;
+  }
+  int16_t ox1 = old.x + old.w, oy1 = old.y + old.h;
+  int16_t nx1 = now.x + now.w, ny1 = now.y + now.h;
+  if (old.y < now.y) tft.fillRect(old.x, old.y, old.w, now.y - old.y, bg);
+  if (oy1 > ny1) tft.fillRect(old.x, ny1, old.w, oy1 - ny1, bg);
+  int16_t y0 = old.y > now.y ? old.y : now.y;
+  int16_t y1 = oy1 < ny1 ? oy1 : ny1;
+  if (y1 <= y0) return;
+  if (old.x < now.x) tft.fillRect(old.x, y0, now.x - old.x, y1 - y0, bg);
+  if (ox1 > nx1) tft.fillRect(nx1, y0, ox1 - nx1, y1 - y0, bg);
+}
+
+static void widgetPaint(TFT_eSPI &tft, Widget &w) {
+  switch (w.type) {
+    case WIDGET_LABEL:
+    case WIDGET_VALUE: {
+      WidgetRect nb = widgetTextBox(tft, w);
+      if (w.text[0]) {
+        tft.setTextFont(w.font);
+        tft.setTextDatum(w.datum);
+        tft.setTextColor(w.fg, w.bg);
+        tft.drawString(w.text, w.x, w.y);
+      }
+      widgetClearOutside(tft, w.box, nb, w.bg);
+      w.box = nb;
+      w.drawnValue = 0;
+      break;
+    }
+
+    case WIDGET_ARC: {
+      float span = (float)(w.a1 - w.a0) / WIDGET_ARC_STEPS;
+      if (w.drawnValue < 0) {
+        drawArcProgress(tft, w.x, w.y, w.r, w.thick, w.a0, w.a1,
+                        (float)w.value / WIDGET_ARC_STEPS, w.track, w.fg, w.arcFlags, w.bg);
+      } else {
+        drawArcDelta(tft, w.x, w.y, w.r, w.thick, w.a0, w.a1, w.a0 + span * w.drawnValue,
+                     w.a0 + span * w.value, w.fg, w.track, w.arcFlags, w.bg);
+      }
+      w.drawnValue = w.value;
+      break;
+    }
+
+    case WIDGET_ICON: {
+      if (w.value) drawIconRle(tft, (IconId)w.icon, w.x, w.y, w.fg, w.bg);
+      else tft.fillRect(w.x, w.y, w.w, w.h, w.bg);
+      w.drawnValue = w.value;
+      break;
+    }
+  }
+  w.dirty = false;
+}
+
+// Repinta os widgets sujos numa única transação; retorna quantos
+static uint16_t widgetsFlush(TFT_eSPI &tft, Widget *list, size_t n) {
+  uint16_t repainted = 0;
+  bool open = false;
+  for (size_t i = 0; i < n; i++) {
+    if (!list[i].dirty) continue;
+    if (!open) { tft.startWrite(); open = true; }
+    widgetPaint(tft, list[i]);
+    repainted++;
+  }
+  if (open) tft.endWrite();
+  return repainted;
+}
+
+#endif // WIDGETS_H
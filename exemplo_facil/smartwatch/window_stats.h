@@ -0,0 +1,96 @@
+#ifndef WINDOW_STATS_H
+#define WINDOW_STATS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ==========================================
+// ESTATÍSTICAS DE JANELA DESLIZANTE - O(1) por amostra
+// ==========================================
+// Mantém min/max (deques monotônicas) e soma (acumulador 64 bits) das
+// últimas WSTATS_CAPACITY amostras. Cada push é O(1) amortizado e a consulta
+// de média/pico-a-pico é O(1), sem reescanear o buffer.
+
+#define WSTATS_CAPACITY MAX30102_BUFFER_SIZE
+
+struct WindowStats {
+  uint32_t vals[WSTATS_CAPACITY]; // ring com as amostras da janela
+  uint32_t total;                 // amostras recebidas desde o reset
+  uint64_t sum;                   // soma da janela (não estoura com IR alto)
+
+  // Deques monotônicas com índices absolutos (total no momento do push)
+  uint32_t minQ[WSTATS_CAPACITY];
+  uint32_t maxQ[WSTATS_CAPACITY];
+  uint16_t minHead, minLen;
+  uint16_t maxHead, maxLen;
+};
+
+static inline void windowStatsReset(WindowStats &w) {
+  w.total = 0;
+  w.sum = 0;
+  w.minHead = w.minLen = 0;
+  w.maxHead = w.maxLen = 0;
+}
+
+static inline int windowStatsCount(const WindowStats &w) {
+  return w.total < WSTATS_CAPACITY ? (int)w.total : WSTATS_CAPACITY;
+}
+
+static inline bool windowStatsFull(const WindowStats &w) {
+  return w.total >= WSTATS_CAPACITY;
+}
+
+static inline void windowStatsPush(WindowStats &w, uint32_t x) {
+  const uint32_t seq = w.total;
+
+  // Remove a amostra que sai da janela (mesmo slot que será sobrescrito)
+  if (seq >= WSTATS_CAPACITY) {
+    const uint32_t expired = seq - WSTATS_CAPACITY;
+    w.sum -= w.vals[seq % WSTATS_CAPACITY];
+    if (w.minLen && w.minQ[w.minHead] == expired) {
+      w.minHead = (w.minHead + 1) % WSTATS_CAPACITY; w.minLen--;
+    }
+    if (w.maxLen && w.maxQ[w.maxHead] == expired) {
+      w.maxHead = (w.maxHead + 1) % WSTATS_CAPACITY; w.maxLen--;
+    }
+  }
+
+  w.vals[seq % WSTATS_CAPACITY] = x;
+  w.sum += x;
+
+  // Descarta candidatos dominados pela nova amostra
+  while (w.minLen) {
+    uint16_t back = (w.minHead + w.minLen - 1) % WSTATS_CAPACITY;
+    if (w.vals[w.minQ[back] % WSTATS_CAPACITY] < x) break;
+    w.minLen--;
+  }
+  w.minQ[(w.minHead + w.minLen) % WSTATS_CAPACITY] = seq; w.minLen++;
+
+  while (w.maxLen) {
+    uint16_t back = (w.maxHead + w.maxLen - 1) % WSTATS_CAPACITY;
+    if (w.vals[w.maxQ[back] % WSTATS_CAPACITY] > x) break;
+    w.maxLen--;
+  }
+  w.maxQ[(w.maxHead + w.maxLen) % WSTATS_CAPACITY] = seq; w.maxLen++;
+
+  w.total++;
+}
+
+static inline uint32_t windowStatsMin(const WindowStats &w) {
+  return w.minLen ? w.vals[w.minQ[w.minHead] % WSTATS_CAPACITY] : 0;
+}
+
+static inline uint32_t windowStatsMax(const WindowStats &w) {
+  return w.maxLen ? w.vals[w.maxQ[w.maxHead] % WSTATS_CAPACITY] : 0;
+}
+
+static inline uint32_t windowStatsMean(const WindowStats &w) {
+  int n = windowStatsCount(w);
+  return n ? (uint32_t)(w.sum / (uint64_t)n) : 0;
+}
+
+static inline uint32_t windowStatsPP(const WindowStats &w) {
+  return windowStatsMax(w) - windowStatsMin(w);
+}
+
+#endif // WINDOW_STATS_H
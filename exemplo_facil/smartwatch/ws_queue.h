@@ -0,0 +1,237 @@
+#ifndef WS_QUEUE_H
+#define WS_QUEUE_H
+
+#include <Arduino.h>
+#include <WebSocketsClient.h>
+#include "config.h"
+
+// ==========================================
+// FILA DE SAÍDA WEBSOCKET - orçamento de bytes, prioridade, merge
+// ==========================================
+// Respostas de comandos, ping e entrada do controle remoto entram aqui em vez
+// de chamar webSocket.sendTXT() direto; wsQueueFlush() (em updateNetwork)
+// envia no máximo WSQ_FLUSH_BUDGET bytes por passada do loop.
+//   - prioridade: entrada remota sai antes de qualquer resposta
+//   - merge: nova mensagem com a mesma chave substitui a pendente
+//     (ex.: stream_on seguido de stream_off envia só "streaming_off")
+//   - descarte: sem espaço, mensagens WSQ_DROPPABLE saem primeiro (mais
+//     antigas antes); se ainda não couber, a nova é descartada
+// Áudio e telemetria continuam enviando direto: já são cadenciados e seus
+// marcadores precisam manter a ordem com os frames.
+
+extern WebSocketsClient webSocket;
+
+enum WsqPriority : uint8_t {
+  WSQ_PRIO_INPUT = 0,    // controle remoto
+  WSQ_PRIO_NORMAL = 1    // respostas, ping
+};
+
+#define WSQ_DROPPABLE 0x02
+#define WSQ_BINARY    0x04   // enviado com sendBIN
+
+// Chaves de merge (0 = sem merge)
+enum WsqKey : uint8_t {
+  WSQ_KEY_NONE = 0,
+  WSQ_KEY_PING,
+  WSQ_KEY_ECHO,          // "Mensagem recebida: ..."
+  WSQ_KEY_STREAM,
+  WSQ_KEY_VAD,
+  WSQ_KEY_TELEMETRY,
+  WSQ_KEY_CODEC,
+  WSQ_KEY_WATCHFACE,
+  WSQ_KEY_QRCODE,
+  WSQ_KEY_SENSORS,
+  WSQ_KEY_RF_STATUS
+};
+
+struct WsqEntry {
+  uint16_t off;
+  uint16_t len;
+  uint8_t prio;
+  uint8_t flags;
+  uint8_t key;
+  uint32_t queuedAt;     // millis()
+};
+
+static char wsqData[WSQ_BYTES];
+static uint16_t wsqUsed = 0;
+static WsqEntry wsqEntries[WSQ_MAX_ENTRIES];
+static uint8_t wsqCount = 0;
+static char wsqFrame[WSQ_FRAME_MAX + 1];
+
+// Métricas (tela de status)
+uint32_t wsqDropped = 0;
+uint32_t wsqMerged = 0;
+uint32_t wsqFrames = 0;
+uint32_t wsqLatencyMs = 0;      // fila -> envio, média móvel
+uint32_t wsqLatencyMaxMs = 0;
+uint32_t wsqSendMicros = 0;     // duração de sendTXT, média móvel
+uint32_t wsqSendMaxMicros = 0;
+
+static inline uint8_t wsqDepth() { return wsqCount; }
+static inline uint16_t wsqBytes() { return wsqUsed; }
+
+// Remove a entrada i compactando dados e índice
+static void wsqRemove(uint8_t i) {
+  WsqEntry e = wsqEntries[i];
+  memmove(wsqData + e.off, wsqData + e.off + e.len, wsqUsed - e.off - e.len);
+  wsqUsed -= e.len;
+  for (uint8_t j = i; j + 1 < wsqCount; j++) wsqEntries[j] = wsqEntries[j + 1];
+  wsqCount--;
+  for (uint8_t j = 0; j < wsqCount; j++) {
+    if (wsqEntries[j].off > e.off) wsqEntries[j].off -= e.len;
+  }
+}
+
+// Índice da entrada pendente com a chave de merge, ou -1
+static int wsqFindKey(uint8_t key) {
+  if (key == WSQ_KEY_NONE) return -1;
+  for (uint8_t i = 0; i < wsqCount; i++) {
+    if (wsqEntries[i].key == key) return i;
+  }
+  return -1;
+}
+
+// Cabe uma mensagem de len bytes? A entrada com mergeKey conta como livre
+static bool wsqFits(size_t len, uint8_t mergeKey) {
+  size_t used = wsqUsed;
+  uint8_t count = wsqCount;
+  int m = wsqFindKey(mergeKey);
+  if (m >= 0) {
+    used -= wsqEntries[m].len;
+    count--;
+  }
+  return used + len <= WSQ_BYTES && count < WSQ_MAX_ENTRIES;
+}
+
+// Libera espaço descartando mensagens WSQ_DROPPABLE (mais antigas primeiro);
+// a entrada com mergeKey fica: só sai quando a nova tiver lugar garantido
+static bool wsqMakeRoom(size_t len, uint8_t mergeKey = WSQ_KEY_NONE) {
+  uint8_t i = 0;
+  while (!wsqFits(len, mergeKey) && i < wsqCount) {
+    WsqEntry &e = wsqEntries[i];
+    if ((e.flags & WSQ_DROPPABLE) && (mergeKey == WSQ_KEY_NONE || e.key != mergeKey)) {
+      wsqRemove(i);
+      wsqDropped++;
+    } else {
+      i++;
+    }
+  }
+  return wsqFits(len, mergeKey);
+}
+
+bool wsEnqueue(const char *data, size_t len, uint8_t prio = WSQ_PRIO_NORMAL,
+               uint8_t flags = 0, uint8_t key = WSQ_KEY_NONE) {
+  if (len == 0) return true;
+  if (len > WSQ_FRAME_MAX) len = WSQ_FRAME_MAX;   // ecos longos são truncados
+
+  // Sem espaço, a pendente de mesma chave continua na fila
+  if (!wsqMakeRoom(len, key)) {
+    wsqDropped++;
+    return false;
+  }
+
+  int m = wsqFindKey(key);
+  if (m >= 0) {
+    wsqRemove(m);
+    wsqMerged++;
+  }
+
+  WsqEntry &e = wsqEntries[wsqCount++];
+  e.off = wsqUsed;
+  e.len = (uint16_t)len;
+  e.prio = prio;
+  e.flags = flags;
+  e.key = key;
+  e.queuedAt = millis();
+  memcpy(wsqData + wsqUsed, data, len);
+  wsqUsed += len;
+  return true;
+}
+
+// Atalhos
+static inline bool wsSend(const char *msg) {
+  return wsEnqueue(msg, strlen(msg));
+}
+
+static inline bool wsSend(const String &msg) {
+  return wsEnqueue(msg.c_str(), msg.length());
+}
+
+// Eco de status: substitui o pendente de mesma chave e pode ser descartado
+static inline bool wsSendStatus(uint8_t key, const char *msg) {
+  return wsEnqueue(msg, strlen(msg), WSQ_PRIO_NORMAL, WSQ_DROPPABLE, key);
+}
+
+static inline bool wsSendStatus(uint8_t key, const String &msg) {
+  return wsEnqueue(msg.c_str(), msg.length(), WSQ_PRIO_NORMAL, WSQ_DROPPABLE, key);
+}
+
+static inline bool wsSendInputBin(const uint8_t *data, size_t len) {
+  return wsEnqueue((const char *)data, len, WSQ_PRIO_INPUT, WSQ_BINARY);
+}
+
+static void wsqRecordSent(uint32_t queuedAt, uint32_t sendUs) {
+  uint32_t lat = millis() - queuedAt;
+  wsqLatencyMs = wsqFrames ? (wsqLatencyMs * 7 + lat) / 8 : lat;
+  if (lat > wsqLatencyMaxMs) wsqLatencyMaxMs = lat;
+  wsqSendMicros = wsqFrames ? (wsqSendMicros * 7 + sendUs) / 8 : sendUs;
+  if (sendUs > wsqSendMaxMicros) wsqSendMaxMicros = sendUs;
+  wsqFrames++;
+}
+
+// Próxima entrada a enviar: menor prioridade numérica, depois a mais antiga
+static int wsqNext() {
+  int best = -1;
+  for (uint8_t i = 0; i < wsqCount; i++) {
+    if (best < 0 || wsqEntries[i].prio < wsqEntries[best].prio) best = i;
+  }
+  return best;
+}
+
+// Envia frames até esgotar WSQ_FLUSH_BUDGET bytes (sempre ao menos um)
+void wsQueueFlush() {
+  size_t budget = WSQ_FLUSH_BUDGET;
+  while (wsqCount > 0) {
+    int i = wsqNext();
+    WsqEntry first = wsqEntries[i];
+    size_t frameLen = first.len;
+    memcpy(wsqFrame, wsqData + first.off, frameLen);
+    wsqRemove(i);
+
+    wsqFrame[frameLen] = '\0';
+    uint32_t t0 = micros();
+    if (first.flags & WSQ_BINARY) webSocket.sendBIN((uint8_t *)wsqFrame, frameLen);
+    else webSocket.sendTXT(wsqFrame, frameLen);
+    wsqRecordSent(first.queuedAt, micros() - t0);
+
+    if (frameLen >= budget) break;
+    budget -= frameLen;
+  }
+}
+
+// Descarta as entradas com algum dos flags ou com a prioridade dada
+static void wsqDropWhere(uint8_t flags, int prio) {
+  uint8_t i = 0;
+  while (i < wsqCount) {
+    if ((wsqEntries[i].flags & flags) || wsqEntries[i].prio == prio) {
+      wsqRemove(i);
+      wsqDropped++;
+    } else {
+      i++;
+    }
+  }
+}
+
+// Conexão caiu: ecos pendentes perdem o sentido e a entrada remota pertence
+// à sessão que acabou (não pode ser repetida na próxima)
+void wsQueueDropStale() {
+  wsqDropWhere(WSQ_DROPPABLE, WSQ_PRIO_INPUT);
+}
+
+// Nova sessão remota: frames RK e remote_auth pendentes são da anterior
+void wsQueueDropInput() {
+  wsqDropWhere(0, WSQ_PRIO_INPUT);
+}
+
+#endif // WS_QUEUE_H
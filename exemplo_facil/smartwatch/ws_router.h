@@ -0,0 +1,126 @@
+#ifndef WS_ROUTER_H
+#define WS_ROUTER_H
+
+#include <Arduino.h>
+#include <string.h>
+#include <stdlib.h>
+#include "config.h"
+
+// ==========================================
+// ROTEADOR DE COMANDOS WEBSOCKET
+// ==========================================
+// O token do comando é lido direto do payload (sem String), procurado por
+// busca binária numa tabela constexpr ordenada (verificada em compilação)
+// e o handler recebe uma "view" dos argumentos apontando para o payload.
+//
+// Formato: <nome>[<sep><args>], onde sep é definido por comando ('|' ou ':').
+
+// Fatia de texto sem cópia (não terminada em '\0')
+struct StrView {
+  const char *p;
+  size_t n;
+
+  bool equals(const char *s) const {
+    size_t l = strlen(s);
+    return l == n && memcmp(p, s, n) == 0;
+  }
+
+  bool empty() const { return n == 0; }
+
+  // Remove espaços/CR/LF das bordas
+  StrView trimmed() const {
+    size_t a = 0, b = n;
+    while (a < b && (uint8_t)p[a] <= ' ') a++;
+    while (b > a && (uint8_t)p[b - 1] <= ' ') b--;
+    StrView v = { p + a, b - a };
+    return v;
+  }
+
+  long toInt() const {
+    char buf[12];
+    size_t l = n < sizeof(buf) - 1 ? n : sizeof(buf) - 1;
+    memcpy(buf, p, l);
+    buf[l] = '\0';
+    return strtol(buf, nullptr, 10);
+  }
+
+  String toString() const { return String(p, n); }
+};
+
+enum WsArgs : uint8_t {
+  WS_ARGS_NONE,       // payload deve ser exatamente o nome
+  WS_ARGS_OPTIONAL,   // nome ou nome<sep>args
+  WS_ARGS_REQUIRED    // nome<sep>args (args pode ser vazio)
+};
+
+typedef void (*WsHandler)(StrView args);
+
+struct WsCommand {
+  const char *name;
+  char sep;
+  WsArgs args;
+  WsHandler handler;
+};
+
+// ---- Verificação de ordenação em tempo de compilação (C++11) ----
+constexpr int wsStrCmp(const char *a, const char *b) {
+  return (*a != *b || *a == '\0') ? (int)(unsigned char)*a - (int)(unsigned char)*b
+                                  : wsStrCmp(a + 1, b + 1);
+}
+
+constexpr bool wsTableSorted(const WsCommand *t, size_t n) {
+  return n < 2 ? true : (wsStrCmp(t[0].name, t[1].name) < 0 && wsTableSorted(t + 1, n - 1));
+}
+
+// Compara o token [p, p+n) com um nome terminado em '\0'
+static inline int wsCompareToken(const char *p, size_t n, const char *name) {
+  int c = strncmp(p, name, n);
+  if (c != 0) return c;
+  return name[n] == '\0' ? 0 : -1;
+}
+
+// Comprimento do token: até o primeiro '|' ou ':' (ou fim)
+static inline size_t wsTokenLength(const char *p, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (p[i] == '|' || p[i] == ':') return i;
+  }
+  return n;
+}
+
+// Procura e executa. Retorna false se não for um comando (vira notificação).
+static bool wsDispatch(const WsCommand *table, size_t count, const char *payload, size_t length) {
+  size_t tok = wsTokenLength(payload, length);
+  int lo = 0, hi = (int)count - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    int c = wsCompareToken(payload, tok, table[mid].name);
+    if (c < 0) { hi = mid - 1; continue; }
+    if (c > 0) { lo = mid + 1; continue; }
+
+    const WsCommand &cmd = table[mid];
+    bool hasSep = tok < length;
+    if (hasSep && (cmd.args == WS_ARGS_NONE || payload[tok] != cmd.sep)) return false;
+    if (!hasSep && cmd.args == WS_ARGS_REQUIRED) return false;
+
+    StrView args = { payload + tok + (hasSep ? 1 : 0), hasSep ? length - tok - 1 : 0 };
+    cmd.handler(args);
+    return true;
+  }
+  return false;
+}
+
+static inline void wsLogFrame(const uint8_t *payload, size_t length) {
+#if WS_VERBOSE_LOG
+  Serial.printf("Comando WS recebido (bytes=%u): '%.*s'\n", (unsigned)length, (int)length, (const char *)payload);
+  size_t startIdx = length > 16 ? length - 16 : 0;
+  Serial.print("Últimos bytes (hex): ");
+  for (size_t i = startIdx; i < length; ++i) {
+    Serial.printf("%02X ", (unsigned)payload[i]);
+  }
+  Serial.println();
+#else
+  (void)payload; (void)length;
+#endif
+}
+
+#endif // WS_ROUTER_H